@@ -39,16 +39,18 @@ BaseTask::~BaseTask()
 
 void BaseTask::start(const char* name,
                      uint32_t stackSize,
-                     UBaseType_t priority)
+                     UBaseType_t priority,
+                     BaseType_t core)
 {
     assert(m_taskHandle == NULL);
 
-    xTaskCreate(&BaseTask::taskFunction,
-                name,
-                stackSize,
-                this,
-                priority,
-                &m_taskHandle);
+    xTaskCreatePinnedToCore(&BaseTask::taskFunction,
+                            name,
+                            stackSize,
+                            this,
+                            priority,
+                            &m_taskHandle,
+                            core);
 
     assert(m_taskHandle != NULL);
 }
@@ -62,10 +62,12 @@ protected:
      * @param name      Name of the task
      * @param stackSize Stack size in words
      * @param priority  Priority
+     * @param core      Core to pin the task to, or tskNO_AFFINITY to let the scheduler choose
      */
     void start(const char* name,
                uint32_t stackSize,
-               UBaseType_t priority);
+               UBaseType_t priority,
+               BaseType_t core = tskNO_AFFINITY);
 
     TaskHandle_t getTaskHandle() const;
 
@@ -41,6 +41,10 @@
 #define DEBUG_TX_PIN        1
 #endif
 
+#ifndef MIDI_UART
+#define MIDI_UART           UART_NUM_2
+#endif
+
 #ifndef MIDI_RX_PIN
 #define MIDI_RX_PIN         16
 #endif
@@ -57,4 +61,42 @@
 #define LED_CLOCK_PIN       14
 #endif
 
+/** LED chipsets which can be selected by LED_CHIPSET. */
+#define LED_CHIPSET_WS2801  1
+#define LED_CHIPSET_APA102  2
+#define LED_CHIPSET_WS2812  3
+
+#ifndef LED_CHIPSET
+#define LED_CHIPSET         LED_CHIPSET_WS2801
+#endif
+
+#ifndef LED_SPI_HOST
+#define LED_SPI_HOST        HSPI_HOST
+#endif
+
+#ifndef LED_SPI_CLOCK_HZ
+#if LED_CHIPSET == LED_CHIPSET_APA102
+#define LED_SPI_CLOCK_HZ    10000000
+#elif LED_CHIPSET == LED_CHIPSET_WS2812
+// Determined by the encoding
+#define LED_SPI_CLOCK_HZ    Ws2812Encoder::c_spiClockHz
+#else
+#define LED_SPI_CLOCK_HZ    2000000
+#endif
+#endif
+
+#ifndef LED_COLOR_ORDER
+#if LED_CHIPSET == LED_CHIPSET_APA102
+#define LED_COLOR_ORDER     LedColorOrder_Bgr
+#elif LED_CHIPSET == LED_CHIPSET_WS2812
+#define LED_COLOR_ORDER     LedColorOrder_Grb
+#else
+#define LED_COLOR_ORDER     LedColorOrder_Rgb
+#endif
+#endif
+
+#ifndef LED_APA102_BRIGHTNESS
+#define LED_APA102_BRIGHTNESS   31
+#endif
+
 #endif /* ESP32APPLICATION_BOARD_H_ */
@@ -34,12 +34,24 @@
 //#define DEBUG_RX_PIN        3
 //#define DEBUG_TX_PIN        1
 
+//#define MIDI_UART           UART_NUM_2
 //#define MIDI_RX_PIN         16
 //#define MIDI_TX_PIN         17
 
-// Set these to -1 to enable hardware SPI
+// LED_CHIPSET_WS2801, LED_CHIPSET_APA102 (also for SK9822) or LED_CHIPSET_WS2812 (data pin only)
+//#define LED_CHIPSET         LED_CHIPSET_WS2801
+
+// The defaults are the native pins of HSPI_HOST. Other pins are routed through the GPIO matrix.
 //#define LED_DATA_PIN        13
 //#define LED_CLOCK_PIN       14
+//#define LED_SPI_HOST        HSPI_HOST
+
+// Defaults depend on the chipset. WS2812 requires its default, which is fixed by the encoding.
+//#define LED_SPI_CLOCK_HZ    2000000
+//#define LED_COLOR_ORDER     LedColorOrder_Rgb
+
+// Global brightness of APA102 chips, 0-31
+//#define LED_APA102_BRIGHTNESS   31
 
 
 
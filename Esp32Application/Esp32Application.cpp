@@ -26,7 +26,8 @@
  * The MLC2 application for the ESP32, using the Arduino core.
  */
 
-#include "ArduinoMidiInput.h"
+#include "SerialMidiInput.h"
+#include "Esp32UartSerialInput.h"
 #include "LoggingTask.h"
 #include "Logging.h"
 #include "MidiMessageLogger.h"
@@ -42,7 +43,12 @@
 #include "LinearRgbFunction.h"
 #include "PianoDecayRgbFunction.h"
 #include "ProcessingTask.h"
+#include "RenderWorkerTask.h"
 #include "LedTask.h"
+#include "Esp32SpiLedOutput.h"
+#include "Ws2801Encoder.h"
+#include "Apa102Encoder.h"
+#include "Ws2812Encoder.h"
 #include "SystemSettingsModel.h"
 #include "NetworkTask.h"
 
@@ -51,10 +57,18 @@
 
 #define LOGGING_COMPONENT "Esp32Application"
 
-static MidiTask* gs_midiTask(nullptr);
-
 static constexpr uint32_t c_defaultStackSize(4096);
 
+/** Interval of logging the processing statistics, in loops (seconds). */
+static constexpr unsigned c_processingStatisticsLogInterval(60);
+
+/** Core the processing task runs on. The render worker takes the other one. */
+static constexpr BaseType_t c_processingCore(1);
+static constexpr BaseType_t c_renderWorkerCore(0);
+
+/** The processing task, for logging statistics. */
+static ProcessingTask* s_processingTask(nullptr);
+
 enum
 {
     /**
@@ -103,12 +117,12 @@ void setup()
     digitalWrite(RUN_LED_PIN, 0);
 
     // Initialize MIDI, baud rate is 31.25k
-    Serial2.begin(31250, SERIAL_8N1, MIDI_RX_PIN, MIDI_TX_PIN);
+    auto midiSerialInput = new Esp32UartSerialInput(MIDI_UART, 31250, MIDI_RX_PIN, MIDI_TX_PIN);
 
-    auto midiInput = new ArduinoMidiInput(Serial2);
-    gs_midiTask = new MidiTask(*midiInput,
-                               c_defaultStackSize,
-                               PRIORITY_CRITICAL);
+    auto midiInput = new SerialMidiInput(*midiSerialInput, *freeRtosTime);
+    new MidiTask(*midiInput,
+                 c_defaultStackSize,
+                 PRIORITY_CRITICAL);
 
     // Initialize printing of MIDI messages
     new MidiMessageLogger(*midiInput);
@@ -129,7 +143,8 @@ void setup()
                                                              *freeRtosTime);
 
     auto concert = new Concert(*midiInput,
-                               *processingBlockFactory);
+                               *processingBlockFactory,
+                               *freeRtosTime);
 
     // TODO read concert from storage
     // For now, add something to test with.
@@ -198,15 +213,36 @@ void setup()
 
     concert->setListeningToProgramChange(true);
 
+    // Render compiled chains on both cores
+    auto renderWorkerTask = new RenderWorkerTask(c_defaultStackSize,
+                                                 PRIORITY_CRITICAL,
+                                                 c_renderWorkerCore);
+    concert->setParallelExecutor(renderWorkerTask);
+
     // Start processing
-    new ProcessingTask(*concert,
-                       c_defaultStackSize,
-                       PRIORITY_CRITICAL);
+    s_processingTask = new ProcessingTask(*concert,
+                                          *freeRtosTime,
+                                          c_defaultStackSize,
+                                          PRIORITY_CRITICAL,
+                                          c_processingCore);
 
     // Start LED output
+#if LED_CHIPSET == LED_CHIPSET_APA102
+    auto ledEncoder = new Apa102Encoder(LED_APA102_BRIGHTNESS, LED_COLOR_ORDER);
+#elif LED_CHIPSET == LED_CHIPSET_WS2812
+    static_assert(LED_SPI_CLOCK_HZ == Ws2812Encoder::c_spiClockHz, "WS2812 bit timing requires the encoder's SPI clock");
+    auto ledEncoder = new Ws2812Encoder(LED_COLOR_ORDER);
+#else
+    auto ledEncoder = new Ws2801Encoder(LED_COLOR_ORDER);
+#endif
+    auto ledOutput = new Esp32SpiLedOutput(ledEncoder->getFrameSize(concert->getStripSize()),
+                                           LED_SPI_HOST,
+                                           LED_DATA_PIN,
+                                           LED_CLOCK_PIN,
+                                           LED_SPI_CLOCK_HZ);
     new LedTask(*concert,
-                LED_DATA_PIN,
-                LED_CLOCK_PIN,
+                *ledOutput,
+                *ledEncoder,
                 c_defaultStackSize,
                 PRIORITY_CRITICAL);
 
@@ -235,12 +271,11 @@ void loop()
         LOG_INFO_PARAMS("free heap: %u", ESP.getFreeHeap());
     }
 
+    if(((s_loopCount % c_processingStatisticsLogInterval) == 0) && (s_processingTask != nullptr))
+    {
+        s_processingTask->logStatistics();
+    }
+
     ++s_loopCount;
 }
 
-
-// TODO This function is not called on ESP32... :-(
-void serialEvent2()
-{
-    gs_midiTask->wake();
-}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Esp32SpiLedOutput.h"
+
+Esp32SpiLedOutput::Esp32SpiLedOutput(std::size_t frameSize,
+                                     spi_host_device_t host,
+                                     int dataPin,
+                                     int clockPin,
+                                     int clockSpeedHz)
+    : BaseLedOutput(frameSize)
+    , m_host(host)
+    , m_device(nullptr)
+    , m_transaction()
+{
+    spi_bus_config_t busConfig = {};
+    busConfig.mosi_io_num = dataPin;
+    busConfig.miso_io_num = -1;
+    busConfig.sclk_io_num = clockPin;
+    busConfig.quadwp_io_num = -1;
+    busConfig.quadhd_io_num = -1;
+    busConfig.max_transfer_sz = frameSize;
+    ESP_ERROR_CHECK(spi_bus_initialize(m_host, &busConfig, c_dmaChannel));
+
+    // Transmit only, no chip select
+    spi_device_interface_config_t deviceConfig = {};
+    deviceConfig.mode = 0;
+    deviceConfig.clock_speed_hz = clockSpeedHz;
+    deviceConfig.spics_io_num = -1;
+    deviceConfig.queue_size = 1;
+    deviceConfig.flags = SPI_DEVICE_HALFDUPLEX;
+    ESP_ERROR_CHECK(spi_bus_add_device(m_host, &deviceConfig, &m_device));
+}
+
+Esp32SpiLedOutput::~Esp32SpiLedOutput()
+{
+    finishTransfer();
+    spi_bus_remove_device(m_device);
+    spi_bus_free(m_host);
+}
+
+void Esp32SpiLedOutput::startTransfer(const uint8_t* frame, std::size_t size)
+{
+    m_transaction = spi_transaction_t();
+    m_transaction.length = size * 8;
+    m_transaction.tx_buffer = frame;
+    ESP_ERROR_CHECK(spi_device_queue_trans(m_device, &m_transaction, portMAX_DELAY));
+}
+
+void Esp32SpiLedOutput::waitForTransfer()
+{
+    spi_transaction_t* completed;
+    ESP_ERROR_CHECK(spi_device_get_trans_result(m_device, &completed, portMAX_DELAY));
+}
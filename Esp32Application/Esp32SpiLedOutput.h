@@ -0,0 +1,82 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief LED strip output using the ESP-IDF SPI master driver.
+ */
+
+#ifndef ESP32APPLICATION_ESP32SPILEDOUTPUT_H_
+#define ESP32APPLICATION_ESP32SPILEDOUTPUT_H_
+
+#include <driver/spi_master.h>
+
+#include "BaseLedOutput.h"
+
+/**
+ * LED strip output using the ESP-IDF SPI master driver.
+ *
+ * Frames are transferred by DMA, so the calling task is only blocked if a frame is shown before the previous one has
+ * been transferred completely.
+ */
+class Esp32SpiLedOutput
+    : public BaseLedOutput
+{
+public:
+    /**
+     * Constructor. Initializes the SPI bus and adds the strip as device.
+     *
+     * @param frameSize     Size of a frame in bytes.
+     * @param host          The SPI peripheral to use.
+     * @param dataPin       The data (MOSI) pin.
+     * @param clockPin      The clock pin.
+     * @param clockSpeedHz  The clock speed.
+     */
+    Esp32SpiLedOutput(std::size_t frameSize, spi_host_device_t host, int dataPin, int clockPin, int clockSpeedHz);
+
+    /**
+     * Destructor. Waits for the ongoing transfer, and releases the SPI bus.
+     */
+    ~Esp32SpiLedOutput() override;
+
+    // Prevent implicit default constructors and assignment operator.
+    Esp32SpiLedOutput() = delete;
+    Esp32SpiLedOutput(const Esp32SpiLedOutput&) = delete;
+    Esp32SpiLedOutput& operator=(const Esp32SpiLedOutput&) = delete;
+
+protected:
+    // BaseLedOutput implementation
+    void startTransfer(const uint8_t* frame, std::size_t size) override;
+    void waitForTransfer() override;
+
+private:
+    static constexpr int c_dmaChannel = 1;
+
+    spi_host_device_t m_host;
+    spi_device_handle_t m_device;
+
+    /** Descriptor of the ongoing transfer. Must stay valid until the transfer completed. */
+    spi_transaction_t m_transaction;
+};
+
+#endif /* ESP32APPLICATION_ESP32SPILEDOUTPUT_H_ */
@@ -0,0 +1,102 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Esp32UartSerialInput.h"
+#include "Logging.h"
+
+#define LOGGING_COMPONENT "Esp32UartSerialInput"
+
+Esp32UartSerialInput::Esp32UartSerialInput(uart_port_t port, int baudRate, int rxPin, int txPin)
+    : m_port(port)
+    , m_eventQueue(nullptr)
+{
+    uart_config_t config = {};
+    config.baud_rate = baudRate;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    ESP_ERROR_CHECK(uart_param_config(m_port, &config));
+    ESP_ERROR_CHECK(uart_set_pin(m_port, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+    ESP_ERROR_CHECK(uart_driver_install(m_port, c_rxBufferSize, 0, c_eventQueueSize, &m_eventQueue, 0));
+
+    // Default thresholds let bytes sit in the FIFO for too long. Make the driver pass on every byte immediately.
+    uart_intr_config_t interruptConfig = {};
+    interruptConfig.intr_enable_mask = UART_RXFIFO_FULL_INT_ENA_M | UART_RXFIFO_TOUT_INT_ENA_M
+                                       | UART_FRM_ERR_INT_ENA_M | UART_RXFIFO_OVF_INT_ENA_M;
+    interruptConfig.rxfifo_full_thresh = c_rxFifoFullThreshold;
+    interruptConfig.rx_timeout_thresh = c_rxTimeoutThreshold;
+    ESP_ERROR_CHECK(uart_intr_config(m_port, &interruptConfig));
+}
+
+Esp32UartSerialInput::~Esp32UartSerialInput()
+{
+    uart_driver_delete(m_port);
+}
+
+bool Esp32UartSerialInput::waitForData(uint32_t timeoutMs)
+{
+    size_t buffered(0);
+    if((uart_get_buffered_data_len(m_port, &buffered) == ESP_OK) && (buffered > 0))
+    {
+        return true;
+    }
+
+    uart_event_t event;
+    if(xQueueReceive(m_eventQueue, &event, pdMS_TO_TICKS(timeoutMs)) != pdTRUE)
+    {
+        return false;
+    }
+
+    switch(event.type)
+    {
+    case UART_DATA:
+        return true;
+
+    case UART_FIFO_OVF:
+    case UART_BUFFER_FULL:
+        // Data was lost, the rest of the buffer can't be trusted either
+        LOG_WARNING("receive overflow, flushing input");
+        uart_flush_input(m_port);
+        xQueueReset(m_eventQueue);
+        return false;
+
+    default:
+        return false;
+    }
+}
+
+std::size_t Esp32UartSerialInput::read(uint8_t* buffer, std::size_t length)
+{
+    size_t buffered(0);
+    if((uart_get_buffered_data_len(m_port, &buffered) != ESP_OK) || (buffered == 0))
+    {
+        return 0;
+    }
+
+    int result(uart_read_bytes(m_port, buffer, buffered < length ? buffered : length, 0));
+    return result > 0 ? static_cast<std::size_t>(result) : 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ESP32APPLICATION_ESP32UARTSERIALINPUT_H_
+#define ESP32APPLICATION_ESP32UARTSERIALINPUT_H_
+
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#include "ISerialInput.h"
+
+/**
+ * Serial input using the ESP-IDF UART driver.
+ *
+ * The receive interrupt is configured to trigger on every byte, and the driver's event queue is used to wake up the
+ * reading task as soon as data arrives.
+ */
+class Esp32UartSerialInput
+    : public ISerialInput
+{
+public:
+    /**
+     * Constructor. Installs and configures the UART driver.
+     *
+     * @param port      The UART to use.
+     * @param baudRate  The baud rate.
+     * @param rxPin     The receive pin.
+     * @param txPin     The transmit pin.
+     */
+    Esp32UartSerialInput(uart_port_t port, int baudRate, int rxPin, int txPin);
+
+    /**
+     * Destructor. Uninstalls the UART driver.
+     */
+    ~Esp32UartSerialInput() override;
+
+    // Prevent implicit default constructors and assignment operator.
+    Esp32UartSerialInput() = delete;
+    Esp32UartSerialInput(const Esp32UartSerialInput&) = delete;
+    Esp32UartSerialInput& operator=(const Esp32UartSerialInput&) = delete;
+
+    // ISerialInput implementation
+    bool waitForData(uint32_t timeoutMs) override;
+    std::size_t read(uint8_t* buffer, std::size_t length) override;
+
+private:
+    static constexpr int c_rxBufferSize = 256;
+    static constexpr int c_eventQueueSize = 16;
+
+    /** Interrupt when this many bytes are in the hardware FIFO. */
+    static constexpr uint8_t c_rxFifoFullThreshold = 1;
+
+    /** Interrupt when the line is idle for this many symbol times, with bytes in the hardware FIFO. */
+    static constexpr uint8_t c_rxTimeoutThreshold = 2;
+
+    uart_port_t m_port;
+    QueueHandle_t m_eventQueue;
+};
+
+#endif /* ESP32APPLICATION_ESP32UARTSERIALINPUT_H_ */
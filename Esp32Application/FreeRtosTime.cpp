@@ -26,11 +26,17 @@
 
 #include "FreeRtosTime.h"
 
-#include <freertos/FreeRTOS.h>
-#include <freertos/task.h>
+#include <esp_timer.h>
 
 
 uint32_t FreeRtosTime::getMilliseconds() const
 {
-    return (xTaskGetTickCount() * 1000) / configTICK_RATE_HZ;
+    // Truncation to 32 bits wraps around cleanly, unlike scaling the 32-bit tick count which overflows early
+    return static_cast<uint32_t>(getMicroseconds() / 1000);
+}
+
+uint64_t FreeRtosTime::getMicroseconds() const
+{
+    // High resolution timer, counts since boot
+    return static_cast<uint64_t>(esp_timer_get_time());
 }
@@ -40,6 +40,7 @@ public:
 
     // ITime implementation
     uint32_t getMilliseconds() const override;
+    uint64_t getMicroseconds() const override;
 };
 
 #endif /* ESP32APPLICATION_FREERTOSTIME_H_ */
@@ -27,28 +27,26 @@
 #include <algorithm>
 
 #include "LedTask.h"
-
+#include "ILedOutput.h"
+#include "ILedEncoder.h"
 
 LedTask::LedTask(Concert& concert,
-                 int16_t dataPin,
-                 int16_t clockPin,
+                 ILedOutput& output,
+                 const ILedEncoder& encoder,
                  uint32_t stackSize,
                  UBaseType_t priority)
     : BaseTask()
-    , m_pendingValues()
-    , m_strip(concert.getStripSize())
-    , m_mutex()
+    , m_values(Processing::TRgbStrip(concert.getStripSize()))
+    , m_output(output)
+    , m_encoder(encoder)
+    , m_numLeds(concert.getStripSize())
     , m_concert(concert)
 {
-    if((dataPin > -1) && (clockPin > -1))
-    {
-        m_strip.updatePins(static_cast<uint8_t>(dataPin), static_cast<uint8_t>(clockPin));
-    }
-    else
+    // Don't write beyond the frames if they are smaller than expected
+    while((m_numLeds > 0) && (m_encoder.getFrameSize(m_numLeds) > m_output.getFrameSize()))
     {
-        m_strip.updatePins();
+        --m_numLeds;
     }
-    m_strip.begin();
 
     start("led", stackSize, priority);
 
@@ -62,12 +60,10 @@ LedTask::~LedTask()
 
 void LedTask::onStripUpdate(const Processing::TRgbStrip& strip)
 {
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        // Store the new values.
-        m_pendingValues = strip;
-    }
+    // Store the new values. The buffers are sized already, so this doesn't allocate.
+    auto& values(m_values.getWriteBuffer());
+    std::copy_n(strip.begin(), std::min(strip.size(), values.size()), values.begin());
+    m_values.publish();
 
     // Notify the task that an update was received.
     xTaskNotifyGive(getTaskHandle());
@@ -76,27 +72,13 @@ void LedTask::onStripUpdate(const Processing::TRgbStrip& strip)
 void LedTask::run()
 {
     // Wait until a strip update comes, or the auto-refresh interval has been reached.
-    auto notifyGiveCount(ulTaskNotifyTake(pdTRUE, c_autoRefreshInterval));
-
-    if (notifyGiveCount != 0)
-    {
-        // A strip update was received, update the colors in the driver.
-        std::lock_guard<std::mutex> lock(m_mutex);
+    ulTaskNotifyTake(pdTRUE, c_autoRefreshInterval);
+    m_values.fetch();
 
-        for(unsigned int ledNumber(0); ledNumber < m_pendingValues.size(); ++ledNumber)
-        {
-            if(ledNumber >= m_strip.numPixels())
-            {
-                break;
-            }
-
-            auto color(m_pendingValues[ledNumber]);
-            m_strip.setPixelColor(ledNumber, color.r, color.g, color.b);
-        }
-    }
+    // Write the latest values in wire format. Also on auto-refresh, as the output alternates between frame buffers.
+    // This happens while the previous frame is still being transferred.
+    m_encoder.encode(m_values.getReadBuffer(), m_output.getFrame(), m_numLeds);
 
-    // Send latest state to strip.
-    // This is done outside of the lock to prevent holding up the thread sending the
-    // strip updates. The driver is accessed only in this thread anyway.
-    m_strip.show();
+    // Start sending, this doesn't wait for completion. The output is accessed only in this thread.
+    m_output.show();
 }
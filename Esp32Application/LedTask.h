@@ -27,11 +27,12 @@
 #ifndef ESP32APPLICATION_LEDTASK_H_
 #define ESP32APPLICATION_LEDTASK_H_
 
-#include <mutex>
-#include <Adafruit_WS2801.h>
-
 #include "BaseTask.h"
 #include "Concert.h"
+#include "TripleBuffer.h"
+
+class ILedOutput;
+class ILedEncoder;
 
 /**
  * Task which performs the output to the LED strip.
@@ -44,15 +45,15 @@ public:
     /**
      * Constructor.
      *
-     * @param concert   Concert instance to subscribe for LED updates and check strip size
-     * @param dataPin   Pin number where the data input of the strip is connected, -1 for hardware SPI
-     * @param clockPin  Pin number where the clock input of the strip is connected, -1 for hardware SPI
-     * @param stackSize Stack size in words
-     * @param priority  Priority
+     * @param concert       Concert instance to subscribe for LED updates and check strip size
+     * @param output        The LED strip output. Frames must be sized by the encoder for the strip size.
+     * @param encoder       Encoder for the type of LED chips
+     * @param stackSize     Stack size in words
+     * @param priority      Priority
      */
     LedTask(Concert& concert,
-            int16_t dataPin,
-            int16_t clockPin,
+            ILedOutput& output,
+            const ILedEncoder& encoder,
             uint32_t stackSize,
             UBaseType_t priority);
 
@@ -70,14 +71,17 @@ private:
 
     static constexpr TickType_t c_autoRefreshInterval = 100;
 
-    /** Values stored upon last update. */
-    Processing::TRgbStrip m_pendingValues;
+    /** Hands off strip updates from the processing task without locking. */
+    TripleBuffer<Processing::TRgbStrip> m_values;
+
+    /** The LED strip output. */
+    ILedOutput& m_output;
 
-    /** The LED strip driver. */
-    Adafruit_WS2801 m_strip;
+    /** Encoder for the type of LED chips. */
+    const ILedEncoder& m_encoder;
 
-    /** Mutex protecting the pending values. */
-    mutable std::mutex m_mutex;
+    /** Number of LEDs in a frame. */
+    std::size_t m_numLeds;
 
     Concert& m_concert;
 };
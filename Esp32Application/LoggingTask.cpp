@@ -30,77 +30,69 @@
 #include "LoggingEntryPoint.h"
 #include "LoggingTask.h"
 
+constexpr unsigned int LoggingTask::c_pollIntervalMs;
+
 LoggingTask::LoggingTask(Stream& serial,
                          uint32_t stackSize,
                          UBaseType_t priority)
     : BaseTask()
     , m_serial(serial)
 {
-    m_queue = xQueueCreate(10, sizeof(QueueEntry));
-    start("logging", stackSize, priority);
+    LoggingEntryPoint::setDeferred(true);
     LoggingEntryPoint::subscribe(*this);
+    start("logging", stackSize, priority);
 }
 
 LoggingTask::~LoggingTask()
 {
     LoggingEntryPoint::unsubscribe(*this);
-    vQueueDelete(m_queue);
+    LoggingEntryPoint::setDeferred(false);
 }
 
 void LoggingTask::logMessage(uint64_t time,
                              Logging::TLogLevel level,
-                             std::string component,
-                             std::string message)
+                             const char* component,
+                             const char* message)
 {
-    QueueEntry entry;
-    entry.time = time;
-    entry.level = level;
-    entry.component = new std::string(component);
-    entry.message = new std::string(message);
+    // Called from run(), by the logging entry point
 
-    xQueueSend(m_queue, &entry, portMAX_DELAY);
-}
-
-void LoggingTask::run()
-{
-    QueueEntry entry;
+    // Some extra for component and level information
+    char buf[LoggingEntryPoint::c_maxMessageSize + 100];
 
-    // Wait for item forever
-    while(xQueueReceive(m_queue, &entry, portMAX_DELAY) == pdTRUE)
+    const char* levelString;
+    switch(level)
     {
-        // Some extra for component and level information
-        char buf[LoggingEntryPoint::c_maxMessageSize + 100];
+    case Logging::LogLevel_Debug:
+        levelString = "Debug";
+        break;
 
-        const char* levelString;
-        switch(entry.level)
-        {
-        case Logging::LogLevel_Debug:
-            levelString = "Debug";
-            break;
+    case Logging::LogLevel_Info:
+        levelString = "Info";
+        break;
 
-        case Logging::LogLevel_Info:
-            levelString = "Info";
-            break;
+    case Logging::LogLevel_Warning:
+        levelString = "Warning";
+        break;
 
-        case Logging::LogLevel_Warning:
-            levelString = "Warning";
-            break;
-
-        case Logging::LogLevel_Error:
-        default:
-            levelString = "Error";
-            break;
-        }
+    case Logging::LogLevel_Error:
+    default:
+        levelString = "Error";
+        break;
+    }
 
-        snprintf(buf, sizeof(buf), "%llu %s(%s): %s\r\n",
-                 entry.time,
-                 levelString,
-                 entry.component->c_str(),
-                 entry.message->c_str());
+    snprintf(buf, sizeof(buf), "%llu %s(%s): %s\r\n",
+             time,
+             levelString,
+             component,
+             message);
 
-        delete entry.component;
-        delete entry.message;
+    m_serial.print(buf);
+}
 
-        m_serial.print(buf);
+void LoggingTask::run()
+{
+    if(!LoggingEntryPoint::processMessages())
+    {
+        vTaskDelay(pdMS_TO_TICKS(c_pollIntervalMs));
     }
 }
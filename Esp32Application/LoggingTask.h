@@ -28,7 +28,6 @@
 #define ESP32APPLICATION_LOGGINGTASK_H_
 
 #include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
 
 #include "ILoggingTarget.h"
 #include "BaseTask.h"
@@ -37,6 +36,9 @@ class Stream;
 
 /**
  * The logging task.
+ *
+ * Puts the logging entry point in deferred mode, and formats and prints the queued messages, so that logging doesn't
+ * block the calling tasks on the serial port.
  */
 class LoggingTask
     : public ILoggingTarget
@@ -65,21 +67,15 @@ public:
     LoggingTask& operator=(const LoggingTask&) = delete;
 
     // ILoggingTarget implementation
-    void logMessage(uint64_t time, Logging::TLogLevel level, std::string component, std::string message) override;
+    void logMessage(uint64_t time, Logging::TLogLevel level, const char* component, const char* message) override;
 
 private:
-    struct QueueEntry
-    {
-        uint64_t time;
-        Logging::TLogLevel level;
-        std::string* component;
-        std::string* message;
-    };
+    /** Interval to check the logging queue at when it is empty. */
+    static constexpr unsigned int c_pollIntervalMs = 20;
 
     void run() override;
 
     Stream& m_serial;
-    QueueHandle_t m_queue;
 };
 
 #endif /* ESP32APPLICATION_LOGGINGTASK_H_ */
@@ -28,9 +28,9 @@
 #include <freertos/task.h>
 
 #include "MidiTask.h"
-#include "ArduinoMidiInput.h"
+#include "SerialMidiInput.h"
 
-MidiTask::MidiTask(ArduinoMidiInput& midiInput,
+MidiTask::MidiTask(SerialMidiInput& midiInput,
                    uint32_t stackSize,
                    UBaseType_t priority)
     : BaseTask()
@@ -39,18 +39,8 @@ MidiTask::MidiTask(ArduinoMidiInput& midiInput,
     start("midi", stackSize, priority);
 }
 
-void MidiTask::wake()
-{
-    xTaskNotifyGive(getTaskHandle());
-}
-
 void MidiTask::run()
 {
-    // TODO workaround for lack of serialEvent implementation on ESP32.
-    // Wait for event for a maximum of 100 ms.
-    // This effectively is a polling implementation instead of an event-driven one.
-    ulTaskNotifyTake(pdTRUE, 100);
-
-    // Process any data.
-    m_midiInput.run();
+    // Wait for data and process it.
+    m_midiInput.run(c_waitTimeoutMs);
 }
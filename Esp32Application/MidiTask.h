@@ -29,10 +29,10 @@
 
 #include "BaseTask.h"
 
-class ArduinoMidiInput;
+class SerialMidiInput;
 
 /**
- * FreeRTOS task processing incoming MIDI bytes.
+ * FreeRTOS task processing incoming MIDI bytes. Blocks until data arrives.
  */
 class MidiTask: public BaseTask
 {
@@ -44,7 +44,7 @@ public:
      * @param stackSize     Stack size in words
      * @param priority      Priority
      */
-    MidiTask(ArduinoMidiInput& midiInput,
+    MidiTask(SerialMidiInput& midiInput,
              uint32_t stackSize,
              UBaseType_t priority);
 
@@ -58,15 +58,13 @@ public:
     MidiTask(const MidiTask&) = delete;
     MidiTask& operator=(const MidiTask&) = delete;
 
-    /**
-     * Wake up the thread.
-     */
-    void wake();
-
 private:
+    /** Maximum time to block, to be able to respond to termination. */
+    static constexpr uint32_t c_waitTimeoutMs = 1000;
+
     void run() override;
 
-    ArduinoMidiInput& m_midiInput;
+    SerialMidiInput& m_midiInput;
 };
 
 #endif /* ESP32APPLICATION_MIDITASK_H_ */
@@ -26,15 +26,25 @@
 
 #include "Concert.h"
 #include "ProcessingTask.h"
+#include "ITime.h"
+#include "Logging.h"
+
+#define LOGGING_COMPONENT "ProcessingTask"
 
 ProcessingTask::ProcessingTask(Concert& concert,
+                               const ITime& time,
                                uint32_t stackSize,
-                               UBaseType_t priority)
+                               UBaseType_t priority,
+                               BaseType_t core)
     : BaseTask()
     , m_concert(concert)
+    , m_time(time)
     , m_lastWakeTime(xTaskGetTickCount())
+    , m_frameTimes()
+    , m_overruns(0)
+    , m_missedDeadlines(0)
 {
-    start("processing", stackSize, priority);
+    start("processing", stackSize, priority, core);
 }
 
 ProcessingTask::~ProcessingTask()
@@ -46,5 +56,56 @@ void ProcessingTask::run()
     // Wait for the next cycle.
     vTaskDelayUntil(&m_lastWakeTime, pdMS_TO_TICKS(c_runIntervalMs));
 
+    // When the previous frame overran, the wake time lags behind and there's no delay at all
+    if((xTaskGetTickCount() - m_lastWakeTime) >= pdMS_TO_TICKS(c_runIntervalMs))
+    {
+        m_missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t startTime(m_time.getMicroseconds());
     m_concert.execute();
+    uint32_t frameTime(static_cast<uint32_t>(m_time.getMicroseconds() - startTime));
+
+    m_frameTimes.record(frameTime);
+    if(frameTime > c_runIntervalMs * 1000)
+    {
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ProcessingTask::TFrameStatistics ProcessingTask::getFrameStatistics() const
+{
+    TFrameStatistics statistics;
+    statistics.frameTimes = m_frameTimes.getStatistics();
+    statistics.overruns = m_overruns.load(std::memory_order_relaxed);
+    statistics.missedDeadlines = m_missedDeadlines.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+void ProcessingTask::logStatistics()
+{
+    // The histograms are only cleared by the processing task at its next frame, so this can't corrupt a frame which
+    // is being recorded. The counters are taken and cleared at once, so no frame is lost in between.
+    TFrameStatistics frameStatistics;
+    frameStatistics.frameTimes = m_frameTimes.getStatistics();
+    frameStatistics.overruns = m_overruns.exchange(0, std::memory_order_relaxed);
+    frameStatistics.missedDeadlines = m_missedDeadlines.exchange(0, std::memory_order_relaxed);
+    m_frameTimes.reset();
+
+    auto concertStatistics(m_concert.getTimingStatistics());
+    m_concert.resetTimingStatistics();
+
+    const auto& frames(frameStatistics.frameTimes);
+    LOG_INFO_PARAMS("frames: %u, time (us) min/avg/p99/max: %u/%u/%u/%u, overruns: %u, missed deadlines: %u",
+                    frames.count, frames.min, frames.average, frames.p99, frames.max,
+                    frameStatistics.overruns, frameStatistics.missedDeadlines);
+
+    const auto& events(concertStatistics.eventHandling);
+    const auto& patch(concertStatistics.patchExecution);
+    const auto& notification(concertStatistics.observerNotification);
+    LOG_INFO_PARAMS("phase time (us) avg/p99/max: events %u/%u/%u, patch %u/%u/%u, notification %u/%u/%u",
+                    events.average, events.p99, events.max,
+                    patch.average, patch.p99, patch.max,
+                    notification.average, notification.p99, notification.max);
 }
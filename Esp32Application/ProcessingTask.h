@@ -27,9 +27,13 @@
 #ifndef BUILD_PROCESSINGTASK_H_
 #define BUILD_PROCESSINGTASK_H_
 
+#include <atomic>
+
 #include "BaseTask.h"
+#include "DurationHistogram.h"
 
 class Concert;
+class ITime;
 
 /**
  * Task which executes all the processing in a @ref Concert.
@@ -42,18 +46,45 @@ public:
      * Constructor.
      *
      * @param concert   The concert to use
+     * @param time      The time provider, used to measure frame times
      * @param stackSize Stack size in words
      * @param priority  Priority
+     * @param core      Core to pin the task to, or tskNO_AFFINITY to let the scheduler choose
      */
     ProcessingTask(Concert& concert,
+                   const ITime& time,
                    uint32_t stackSize,
-                   UBaseType_t priority);
+                   UBaseType_t priority,
+                   BaseType_t core = tskNO_AFFINITY);
 
     /**
      * Destructor.
      */
     ~ProcessingTask() override;
 
+    /** Frame timing statistics. */
+    struct TFrameStatistics
+    {
+        /** Execution times of complete frames. */
+        DurationHistogram::TStatistics frameTimes;
+
+        /** Number of frames which took longer than the frame period. */
+        uint32_t overruns;
+
+        /** Number of frames which started a complete period or more too late. */
+        uint32_t missedDeadlines;
+    };
+
+    /**
+     * Get the frame timing statistics since construction or the last reset. Can be called from any task.
+     */
+    TFrameStatistics getFrameStatistics() const;
+
+    /**
+     * Log the frame timing statistics, including those of the concert phases, and reset them.
+     */
+    void logStatistics();
+
 protected:
     // BaseTask implementation
     void run() override;
@@ -61,7 +92,11 @@ protected:
 private:
     static constexpr uint32_t c_runIntervalMs = 10;
     Concert& m_concert;
+    const ITime& m_time;
     TickType_t m_lastWakeTime;
+    DurationHistogram m_frameTimes;
+    std::atomic<uint32_t> m_overruns;
+    std::atomic<uint32_t> m_missedDeadlines;
 };
 
 #endif /* BUILD_PROCESSINGTASK_H_ */
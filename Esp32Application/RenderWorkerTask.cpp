@@ -0,0 +1,71 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "RenderWorkerTask.h"
+
+constexpr unsigned int RenderWorkerTask::c_numParts;
+
+RenderWorkerTask::RenderWorkerTask(uint32_t stackSize,
+                                   UBaseType_t priority,
+                                   BaseType_t core)
+    : BaseTask()
+    , m_job(nullptr)
+    , m_caller(NULL)
+{
+    start("renderWorker", stackSize, priority, core);
+}
+
+RenderWorkerTask::~RenderWorkerTask()
+{
+}
+
+unsigned int RenderWorkerTask::getNumParts() const
+{
+    return c_numParts;
+}
+
+void RenderWorkerTask::execute(const TJob& job)
+{
+    m_job = &job;
+    m_caller = xTaskGetCurrentTaskHandle();
+
+    // Notifications imply a memory barrier, so the worker sees the job
+    xTaskNotifyGive(getTaskHandle());
+    job(0);
+
+    // Wait for the worker to finish its part
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    m_job = nullptr;
+}
+
+void RenderWorkerTask::run()
+{
+    if(ulTaskNotifyTake(pdTRUE, portMAX_DELAY) != 0)
+    {
+        (*m_job)(1);
+        xTaskNotifyGive(m_caller);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Task which renders part of a frame on the second core.
+ */
+
+#ifndef ESP32APPLICATION_RENDERWORKERTASK_H_
+#define ESP32APPLICATION_RENDERWORKERTASK_H_
+
+#include "BaseTask.h"
+#include "IParallelExecutor.h"
+
+/**
+ * Task which renders part of a frame on the second core.
+ *
+ * The caller of @ref execute renders part 0 itself, while this task renders part 1. Synchronization is done with
+ * task notifications, which is the cheapest way to wake a task in FreeRTOS.
+ */
+class RenderWorkerTask
+    : public BaseTask
+    , public IParallelExecutor
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param stackSize Stack size in words
+     * @param priority  Priority
+     * @param core      Core to pin the task to, should be the one the caller of @ref execute is not pinned to
+     */
+    RenderWorkerTask(uint32_t stackSize,
+                     UBaseType_t priority,
+                     BaseType_t core);
+
+    /**
+     * Destructor.
+     */
+    ~RenderWorkerTask() override;
+
+    // IParallelExecutor implementation
+    unsigned int getNumParts() const override;
+    void execute(const TJob& job) override;
+
+private:
+    // BaseTask implementation
+    void run() override;
+
+    static constexpr unsigned int c_numParts = 2;
+
+    /** The job being executed. Only valid between the notifications. */
+    const TJob* m_job;
+
+    /** The task which called @ref execute, to notify when done. */
+    TaskHandle_t m_caller;
+};
+
+#endif /* ESP32APPLICATION_RENDERWORKERTASK_H_ */
@@ -33,11 +33,14 @@
 #include "RtMidiMidiInput.h"
 #include "MidiMessageLogger.h"
 #include "StdLogger.h"
+#include "StdTime.h"
 
 int main()
 {
+    StdTime stdTime;
+    LoggingEntryPoint::setTime(&stdTime);
     StdLogger stdLogger;
-    RtMidiMidiInput midiInput;
+    RtMidiMidiInput midiInput(stdTime);
     MidiMessageLogger midiLogger(midiInput);
 
     int numFoundInputs = midiInput.getPortCount();
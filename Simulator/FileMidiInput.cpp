@@ -0,0 +1,361 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "FileMidiInput.h"
+#include "Logging.h"
+
+#define LOGGING_COMPONENT "FileMidiInput"
+
+namespace
+{
+
+/** Default tempo of a Standard MIDI File, in microseconds per quarter note. */
+constexpr uint32_t c_defaultTempo = 500000;
+
+/** Event of a Standard MIDI File track, with its absolute time in ticks. */
+struct TTrackEvent
+{
+    uint64_t tick;
+    bool isTempo;
+    uint32_t tempo;
+    std::vector<uint8_t> bytes;
+};
+
+/** Sequential reader for the big-endian and variable length quantities of a Standard MIDI File. */
+class TReader
+{
+public:
+    TReader(const std::vector<uint8_t>& data, std::size_t begin, std::size_t end)
+        : m_data(data)
+        , m_position(begin)
+        , m_end(end)
+        , m_error(false)
+    {
+    }
+
+    uint8_t readByte()
+    {
+        if(m_position >= m_end)
+        {
+            m_error = true;
+            return 0;
+        }
+        return m_data[m_position++];
+    }
+
+    uint32_t readFixed(unsigned int numBytes)
+    {
+        uint32_t value(0);
+        for(unsigned int i = 0; i < numBytes; ++i)
+        {
+            value = (value << 8) | readByte();
+        }
+        return value;
+    }
+
+    uint32_t readVariableLength()
+    {
+        // At most 4 bytes, 7 bits each, most significant first. Bit 7 set means more bytes follow.
+        uint32_t value(0);
+        for(unsigned int i = 0; i < 4; ++i)
+        {
+            uint8_t byte(readByte());
+            value = (value << 7) | (byte & 0x7f);
+            if((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        m_error = true;
+        return value;
+    }
+
+    void skip(std::size_t numBytes)
+    {
+        if(numBytes > m_end - m_position)
+        {
+            m_error = true;
+            m_position = m_end;
+            return;
+        }
+        m_position += numBytes;
+    }
+
+    std::size_t getPosition() const
+    {
+        return m_position;
+    }
+
+    bool atEnd() const
+    {
+        return m_position >= m_end;
+    }
+
+    bool hasError() const
+    {
+        return m_error;
+    }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    std::size_t m_position;
+    std::size_t m_end;
+    bool m_error;
+};
+
+/**
+ * Parse one track chunk, appending its events.
+ *
+ * @return  True on success.
+ */
+bool parseTrack(TReader& reader, std::vector<TTrackEvent>& events)
+{
+    uint64_t tick(0);
+    uint8_t runningStatus(0);
+
+    while(!reader.atEnd() && !reader.hasError())
+    {
+        tick += reader.readVariableLength();
+        uint8_t byte(reader.readByte());
+
+        if(byte == 0xff)
+        {
+            // Meta event. Only tempo is of interest.
+            uint8_t type(reader.readByte());
+            uint32_t length(reader.readVariableLength());
+            if(type == 0x51 && length == 3)
+            {
+                events.push_back({tick, true, reader.readFixed(3), {}});
+            }
+            else
+            {
+                reader.skip(length);
+            }
+            runningStatus = 0;
+        }
+        else if(byte == 0xf0 || byte == 0xf7)
+        {
+            // System exclusive, not replayed
+            reader.skip(reader.readVariableLength());
+            runningStatus = 0;
+        }
+        else
+        {
+            TTrackEvent event = {tick, false, 0, {}};
+            if(byte & 0x80)
+            {
+                runningStatus = byte;
+                byte = reader.readByte();
+            }
+            else if(runningStatus == 0)
+            {
+                return false;
+            }
+
+            uint8_t type(runningStatus & 0xf0);
+            event.bytes.push_back(runningStatus);
+            event.bytes.push_back(byte);
+            if(type != 0xc0 && type != 0xd0)
+            {
+                event.bytes.push_back(reader.readByte());
+            }
+            events.push_back(event);
+        }
+    }
+
+    return !reader.hasError();
+}
+
+} /* namespace */
+
+constexpr uint64_t FileMidiInput::c_rawByteDurationUs;
+
+FileMidiInput::FileMidiInput(const ITime& time)
+    : BaseMidiInput(time)
+    , m_messages()
+    , m_nextMessage(0)
+    , m_rawBytes()
+    , m_nextRawByte(0)
+{
+}
+
+bool FileMidiInput::load(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file)
+    {
+        LOG_ERROR_PARAMS("cannot open '%s'", fileName.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    m_messages.clear();
+    m_nextMessage = 0;
+    m_rawBytes.clear();
+    m_nextRawByte = 0;
+
+    static const uint8_t c_headerId[] = {'M', 'T', 'h', 'd'};
+    if(data.size() >= sizeof(c_headerId) && std::equal(c_headerId, c_headerId + sizeof(c_headerId), data.begin()))
+    {
+        if(!parseStandardMidiFile(data))
+        {
+            LOG_ERROR_PARAMS("'%s' is not a valid Standard MIDI File", fileName.c_str());
+            m_messages.clear();
+            return false;
+        }
+        LOG_INFO_PARAMS("loaded %u messages from '%s'", static_cast<unsigned int>(m_messages.size()), fileName.c_str());
+    }
+    else
+    {
+        m_rawBytes = std::move(data);
+        LOG_INFO_PARAMS("loaded %u raw bytes from '%s'", static_cast<unsigned int>(m_rawBytes.size()), fileName.c_str());
+    }
+
+    return true;
+}
+
+bool FileMidiInput::parseStandardMidiFile(const std::vector<uint8_t>& data)
+{
+    TReader reader(data, 0, data.size());
+    reader.skip(4);
+    uint32_t headerLength(reader.readFixed(4));
+    std::size_t headerEnd(reader.getPosition() + headerLength);
+    reader.readFixed(2); // format, all formats are merged into one stream
+    uint32_t numTracks(reader.readFixed(2));
+    uint32_t division(reader.readFixed(2));
+    if(reader.hasError() || headerLength < 6 || division == 0)
+    {
+        return false;
+    }
+    reader.skip(headerEnd - reader.getPosition());
+
+    std::vector<TTrackEvent> events;
+    for(uint32_t track = 0; track < numTracks && !reader.atEnd(); ++track)
+    {
+        uint32_t id(reader.readFixed(4));
+        uint32_t length(reader.readFixed(4));
+        std::size_t begin(reader.getPosition());
+        if(reader.hasError() || length > data.size() - begin)
+        {
+            return false;
+        }
+
+        // Unknown chunk types must be skipped
+        if(id == 0x4d54726b /* MTrk */)
+        {
+            TReader trackReader(data, begin, begin + length);
+            if(!parseTrack(trackReader, events))
+            {
+                return false;
+            }
+        }
+        reader.skip(length);
+    }
+
+    // Merge tracks. Stable, so order within a tick is kept.
+    std::stable_sort(events.begin(), events.end(), [](const TTrackEvent& a, const TTrackEvent& b) {
+        return a.tick < b.tick;
+    });
+
+    // Convert ticks to time. Time is accumulated at every tempo change to prevent rounding errors from adding up.
+    uint64_t baseTick(0), baseTime(0);
+    uint32_t tempo(c_defaultTempo);
+    auto toTime = [&](uint64_t tick) -> uint64_t {
+        if(division & 0x8000)
+        {
+            // SMPTE: negative frames per second in the high byte, ticks per frame in the low byte
+            uint64_t ticksPerSecond(static_cast<uint64_t>(-static_cast<int8_t>(division >> 8)) * (division & 0xff));
+            return ticksPerSecond == 0 ? 0 : (tick * 1000000) / ticksPerSecond;
+        }
+        return baseTime + ((tick - baseTick) * tempo) / division;
+    };
+
+    for(auto& event : events)
+    {
+        if(event.isTempo)
+        {
+            baseTime = toTime(event.tick);
+            baseTick = event.tick;
+            tempo = event.tempo;
+        }
+        else
+        {
+            m_messages.push_back({toTime(event.tick), std::move(event.bytes)});
+        }
+    }
+
+    return true;
+}
+
+void FileMidiInput::processUntil(uint64_t microseconds)
+{
+    while(m_nextMessage < m_messages.size() && m_messages[m_nextMessage].time <= microseconds)
+    {
+        const auto& message(m_messages[m_nextMessage]);
+        processMidiMessage(message.bytes.data(), message.bytes.size());
+        ++m_nextMessage;
+    }
+
+    if(m_nextRawByte < m_rawBytes.size())
+    {
+        // All bytes which completely arrived since the last call are passed as one chunk, like a UART driver would do
+        std::size_t end(std::min<uint64_t>(m_rawBytes.size(), microseconds / c_rawByteDurationUs));
+        if(end > m_nextRawByte)
+        {
+            processMidiBytes(&m_rawBytes[m_nextRawByte], end - m_nextRawByte);
+            m_nextRawByte = end;
+        }
+    }
+}
+
+bool FileMidiInput::isFinished() const
+{
+    return (m_nextMessage >= m_messages.size()) && (m_nextRawByte >= m_rawBytes.size());
+}
+
+uint64_t FileMidiInput::getDuration() const
+{
+    if(!m_rawBytes.empty())
+    {
+        return m_rawBytes.size() * c_rawByteDurationUs;
+    }
+    return m_messages.empty() ? 0 : m_messages.back().time;
+}
+
+unsigned int FileMidiInput::getPortCount() const
+{
+    return 1;
+}
+
+void FileMidiInput::openPort(int number)
+{
+    // Nothing to open, the file is loaded explicitly
+}
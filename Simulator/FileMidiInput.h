@@ -0,0 +1,134 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief MIDI input which replays a recorded MIDI stream from a file.
+ */
+
+#ifndef SIMULATOR_FILEMIDIINPUT_H_
+#define SIMULATOR_FILEMIDIINPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BaseMidiInput.h"
+
+/**
+ * MIDI input which replays a Standard MIDI File or a raw byte capture.
+ *
+ * The file is loaded into memory entirely, and replayed by calling @ref processUntil with the simulated time.
+ */
+class FileMidiInput
+    : public BaseMidiInput
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param time  Time provider, used to timestamp incoming messages.
+     */
+    explicit FileMidiInput(const ITime& time);
+
+    /**
+     * Destructor.
+     */
+    ~FileMidiInput() override = default;
+
+    // Prevent implicit constructor, copy constructor and assignment operator.
+    FileMidiInput() = delete;
+    FileMidiInput(const FileMidiInput&) = delete;
+    FileMidiInput& operator=(const FileMidiInput&) = delete;
+
+    /** Time it takes to send one byte at the MIDI baud rate of 31.25k (start bit, 8 data bits, stop bit). */
+    static constexpr uint64_t c_rawByteDurationUs = 320;
+
+    /**
+     * Load a file.
+     *
+     * Files starting with a Standard MIDI File header are parsed as such, using their timing information. Any other
+     * file is considered a raw capture of the MIDI wire, of which the bytes are replayed at the MIDI baud rate.
+     *
+     * @param[in]   fileName    The file to load.
+     *
+     * @return  True on success.
+     */
+    bool load(const std::string& fileName);
+
+    /**
+     * Process all recorded messages up to the given time.
+     *
+     * @param[in]   microseconds    Time since the start of the recording.
+     */
+    void processUntil(uint64_t microseconds);
+
+    /**
+     * Get whether all recorded messages are processed.
+     */
+    bool isFinished() const;
+
+    /**
+     * Get the time of the last recorded message, relative to the start of the recording.
+     */
+    uint64_t getDuration() const;
+
+    // IMidiInterface implementation
+    unsigned int getPortCount() const override;
+    void openPort(int number) override;
+
+private:
+    /** A recorded MIDI message. */
+    struct TMessage
+    {
+        /** Time since the start of the recording, in microseconds. */
+        uint64_t time;
+
+        /** The MIDI bytes, starting with the status byte. */
+        std::vector<uint8_t> bytes;
+    };
+
+    /**
+     * Parse a Standard MIDI File into messages.
+     *
+     * @param[in]   data    The file contents.
+     *
+     * @return  True on success.
+     */
+    bool parseStandardMidiFile(const std::vector<uint8_t>& data);
+
+    /** The recorded messages of a Standard MIDI File, ordered by time. */
+    std::vector<TMessage> m_messages;
+
+    /** Index of the first message which is not processed yet. */
+    std::size_t m_nextMessage;
+
+    /** The recorded bytes of a raw capture. */
+    std::vector<uint8_t> m_rawBytes;
+
+    /** Index of the first raw byte which is not processed yet. */
+    std::size_t m_nextRawByte;
+};
+
+#endif /* SIMULATOR_FILEMIDIINPUT_H_ */
@@ -0,0 +1,59 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Time provider for the simulator, which is advanced explicitly.
+ */
+
+#ifndef SIMULATOR_SIMULATEDTIME_H_
+#define SIMULATOR_SIMULATEDTIME_H_
+
+#include "ITime.h"
+
+/**
+ * Time provider which only advances when told to, so simulations run independent of wall clock time.
+ */
+class SimulatedTime : public ITime
+{
+public:
+    SimulatedTime();
+    ~SimulatedTime() override = default;
+
+    /**
+     * Advance the time.
+     *
+     * @param[in]   microseconds    The amount of time to advance.
+     */
+    void advance(uint64_t microseconds);
+
+    // ITime implementation
+    uint32_t getMilliseconds() const override;
+    uint64_t getMicroseconds() const override;
+
+private:
+    /** The current time. */
+    uint64_t m_microseconds;
+};
+
+#endif /* SIMULATOR_SIMULATEDTIME_H_ */
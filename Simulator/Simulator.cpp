@@ -0,0 +1,196 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Headless simulator, which runs a concert against a recorded MIDI stream and dumps the strip of every frame.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Concert.h"
+#include "FileMidiInput.h"
+#include "ProcessingBlockFactory.h"
+#include "RgbFunctionFactory.h"
+#include "SimulatedTime.h"
+#include "StdLogger.h"
+#include "StripDumpWriter.h"
+
+/** Keeps a copy of the last strip published by the concert. */
+class StripRecorder
+    : public Concert::IObserver
+{
+public:
+    // Concert::IObserver implementation
+    void onStripUpdate(const Processing::TRgbStrip& strip) override
+    {
+        m_strip = strip;
+    }
+
+    const Processing::TRgbStrip& getStrip() const
+    {
+        return m_strip;
+    }
+
+private:
+    Processing::TRgbStrip m_strip;
+};
+
+static void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [options] <concert.json> <input> <output>\n"
+                 "\n"
+                 "  <input>    Standard MIDI File, or raw capture of the MIDI wire\n"
+                 "  <output>   Strip dump, one frame per execution. PPM if it ends with .ppm, compact binary otherwise.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --fps <n>      Frame rate (default 100)\n"
+                 "  --tail <ms>    Time to keep running after the input ended (default 2000)\n";
+}
+
+static bool endsWith(const std::string& string, const std::string& suffix)
+{
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int framesPerSecond(100);
+    unsigned int tailMs(2000);
+    std::vector<std::string> positionals;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+        {
+            framesPerSecond = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if(std::strcmp(argv[i], "--tail") == 0 && i + 1 < argc)
+        {
+            tailMs = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            positionals.push_back(argv[i]);
+        }
+    }
+
+    if(positionals.size() != 3 || framesPerSecond == 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    SimulatedTime time;
+    LoggingEntryPoint::setTime(&time);
+    StdLogger stdLogger;
+
+    FileMidiInput midiInput(time);
+    if(!midiInput.load(positionals[1]))
+    {
+        return 1;
+    }
+
+    RgbFunctionFactory rgbFunctionFactory;
+    ProcessingBlockFactory processingBlockFactory(midiInput, rgbFunctionFactory, time);
+    Concert concert(midiInput, processingBlockFactory, time);
+
+    std::ifstream concertFile(positionals[0]);
+    if(!concertFile)
+    {
+        std::cerr << "Cannot open " << positionals[0] << "\n";
+        return 1;
+    }
+    std::stringstream concertText;
+    concertText << concertFile.rdbuf();
+    std::string error;
+    Json concertJson(Json::parse(concertText.str(), error, json11::STANDARD));
+    if(!error.empty())
+    {
+        std::cerr << "Cannot parse " << positionals[0] << ": " << error << "\n";
+        return 1;
+    }
+    concert.convertFromJson(concertJson);
+
+    StripRecorder recorder;
+    concert.subscribe(recorder);
+
+    const uint64_t framePeriodUs(1000000 / framesPerSecond);
+    const uint64_t endUs(midiInput.getDuration() + static_cast<uint64_t>(tailMs) * 1000);
+    const std::size_t numFrames(endUs / framePeriodUs + 1);
+
+    StripDumpWriter writer(positionals[2],
+                           endsWith(positionals[2], ".ppm") ? StripDumpWriter::FORMAT_PPM : StripDumpWriter::FORMAT_BINARY,
+                           concert.getStripSize(),
+                           numFrames);
+    if(!writer.isGood())
+    {
+        std::cerr << "Cannot open " << positionals[2] << "\n";
+        return 1;
+    }
+
+    // Run as fast as possible. Only the execution of the concert is measured.
+    std::chrono::steady_clock::duration totalExecutionTime(0), maxExecutionTime(0);
+    auto startTime(std::chrono::steady_clock::now());
+    for(std::size_t frame = 0; frame < numFrames; ++frame)
+    {
+        midiInput.processUntil(time.getMicroseconds());
+
+        auto executionStartTime(std::chrono::steady_clock::now());
+        concert.execute();
+        auto executionTime(std::chrono::steady_clock::now() - executionStartTime);
+        totalExecutionTime += executionTime;
+        if(executionTime > maxExecutionTime)
+        {
+            maxExecutionTime = executionTime;
+        }
+
+        writer.writeFrame(time.getMilliseconds(), recorder.getStrip());
+        time.advance(framePeriodUs);
+    }
+    auto wallTime(std::chrono::steady_clock::now() - startTime);
+
+    concert.unsubscribe(recorder);
+
+    if(!writer.isGood())
+    {
+        std::cerr << "Error writing " << positionals[2] << "\n";
+        return 1;
+    }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    auto wallTimeUs(duration_cast<microseconds>(wallTime).count());
+    std::cout << "Simulated " << numFrames << " frames (" << endUs / 1000 << " ms) in "
+              << wallTimeUs / 1000 << " ms wall time\n"
+              << "Concert execution: mean " << duration_cast<microseconds>(totalExecutionTime).count() / numFrames
+              << " us, max " << duration_cast<microseconds>(maxExecutionTime).count() << " us\n";
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <vector>
+
+#include "StripDumpWriter.h"
+
+StripDumpWriter::StripDumpWriter(const std::string& fileName, TFormat format, std::size_t stripSize, std::size_t numFrames)
+    : m_file(fileName, std::ios::binary)
+    , m_format(format)
+    , m_stripSize(stripSize)
+{
+    if(m_format == FORMAT_PPM)
+    {
+        m_file << "P6\n" << m_stripSize << " " << numFrames << "\n255\n";
+    }
+}
+
+bool StripDumpWriter::isGood() const
+{
+    return m_file.good();
+}
+
+void StripDumpWriter::writeFrame(Processing::TTime time, const Processing::TRgbStrip& strip)
+{
+    std::vector<char> buffer;
+    buffer.reserve(6 + 3 * m_stripSize);
+
+    if(m_format == FORMAT_BINARY)
+    {
+        for(unsigned int i = 0; i < 4; ++i)
+        {
+            buffer.push_back(static_cast<char>((time >> (8 * i)) & 0xff));
+        }
+        buffer.push_back(static_cast<char>(m_stripSize & 0xff));
+        buffer.push_back(static_cast<char>((m_stripSize >> 8) & 0xff));
+    }
+
+    for(std::size_t i = 0; i < m_stripSize; ++i)
+    {
+        Processing::TRgb color(i < strip.size() ? strip[i] : Processing::TRgb());
+        buffer.push_back(static_cast<char>(color.r));
+        buffer.push_back(static_cast<char>(color.g));
+        buffer.push_back(static_cast<char>(color.b));
+    }
+
+    m_file.write(buffer.data(), buffer.size());
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Writer for dumps of the strip contents of every frame.
+ */
+
+#ifndef SIMULATOR_STRIPDUMPWRITER_H_
+#define SIMULATOR_STRIPDUMPWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "ProcessingTypes.h"
+
+/**
+ * Writes the strip contents of every frame to a file.
+ *
+ * Two formats are supported:
+ * - PPM (binary, P6) image, with one row of pixels per frame. Convenient for looking at a whole run at once.
+ * - Compact binary format, which is a sequence of frames, each consisting of a little-endian 32-bit time in
+ *   milliseconds, a little-endian 16-bit number of LEDs, and 3 bytes (R, G, B) per LED.
+ */
+class StripDumpWriter
+{
+public:
+    enum TFormat
+    {
+        FORMAT_PPM,
+        FORMAT_BINARY
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param[in]   fileName    The file to write.
+     * @param[in]   format      The format to write.
+     * @param[in]   stripSize   Number of LEDs. Frames are truncated or padded with black to this size.
+     * @param[in]   numFrames   Number of frames which will be written. Only used for the PPM header.
+     */
+    StripDumpWriter(const std::string& fileName, TFormat format, std::size_t stripSize, std::size_t numFrames);
+
+    // Prevent implicit constructor, copy constructor and assignment operator.
+    StripDumpWriter() = delete;
+    StripDumpWriter(const StripDumpWriter&) = delete;
+    StripDumpWriter& operator=(const StripDumpWriter&) = delete;
+
+    /**
+     * Get whether the file is open and all writes so far succeeded.
+     */
+    bool isGood() const;
+
+    /**
+     * Write a frame.
+     *
+     * @param[in]   time    The time of the frame.
+     * @param[in]   strip   The strip contents.
+     */
+    void writeFrame(Processing::TTime time, const Processing::TRgbStrip& strip);
+
+private:
+    /** The output file. */
+    std::ofstream m_file;
+
+    /** The format to write. */
+    TFormat m_format;
+
+    /** Number of LEDs per frame. */
+    std::size_t m_stripSize;
+};
+
+#endif /* SIMULATOR_STRIPDUMPWRITER_H_ */
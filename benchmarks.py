@@ -0,0 +1,56 @@
+#!python
+
+# MIT License
+#
+# Copyright (C) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import platform
+
+Import('env')
+
+# Propagate the 'TERM' environment variable from the OS, so tools can decide if they should colorize output
+env['ENV']['TERM'] = os.getenv('TERM', 'unknown')
+
+# Google Benchmark is not available as PlatformIO library, so it's taken from the host
+env.Append(LIBS=['benchmark'])
+
+# Google Benchmark uses pthread on linux
+if 'linux' in platform.system().lower():
+    env.Append(LIBS=['pthread'])
+
+# Build separate program for every benchmark source, like the unit tests.
+# Results are written as JSON, so they can be compared between commits, e.g. with the compare.py tool which comes
+# with Google Benchmark.
+output_dir = 'build/benchmark/'
+benchmark_results = []
+for node in env['PIOBUILDFILES']:
+    benchmark_name = os.path.basename(str(node[0])).rsplit('.')[0]
+    benchmark_program = env.Program(output_dir + benchmark_name, node)
+
+    benchmark_result = env.Command(output_dir + benchmark_name + 'Result.json', benchmark_program,
+                                   './$SOURCE --benchmark_out=$TARGET --benchmark_out_format=json')
+    env.AlwaysBuild(benchmark_result)
+    Alias(benchmark_name, benchmark_result)
+    benchmark_results += benchmark_result
+
+Alias('all', benchmark_results)
+Default('all')
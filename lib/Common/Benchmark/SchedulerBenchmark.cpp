@@ -0,0 +1,56 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Benchmarks for Scheduler.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "Scheduler.h"
+
+static void SchedulerScheduleAndExecuteAll(benchmark::State& state)
+{
+    const unsigned int numTasks(state.range(0));
+
+    Scheduler scheduler;
+    unsigned int counter(0);
+    for(auto _ : state)
+    {
+        for(unsigned int i = 0; i < numTasks; ++i)
+        {
+            // Capture like the MIDI callbacks do
+            uint8_t channel(0), number(i & 0x7f);
+            scheduler.schedule([&counter, channel, number]() {
+                counter += channel + number;
+            });
+        }
+        scheduler.executeAll();
+        benchmark::DoNotOptimize(counter);
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+BENCHMARK(SchedulerScheduleAndExecuteAll)->Arg(1)->Arg(16)->Arg(128);
+
+BENCHMARK_MAIN();
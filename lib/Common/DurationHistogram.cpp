@@ -0,0 +1,169 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "DurationHistogram.h"
+
+constexpr unsigned int DurationHistogram::c_numExactBuckets;
+constexpr unsigned int DurationHistogram::c_numSubBuckets;
+constexpr unsigned int DurationHistogram::c_numBuckets;
+
+DurationHistogram::DurationHistogram()
+    : m_buckets()
+    , m_count()
+    , m_sum()
+    , m_min()
+    , m_max()
+    , m_resetRequests(0)
+    , m_resetsDone(0)
+{
+    clear();
+}
+
+void DurationHistogram::record(uint32_t microseconds)
+{
+    // Carry out a pending reset first, so it can't be mixed up with this record
+    uint32_t resetRequests(m_resetRequests.load(std::memory_order_acquire));
+    if(resetRequests != m_resetsDone.load(std::memory_order_relaxed))
+    {
+        clear();
+        m_resetsDone.store(resetRequests, std::memory_order_release);
+    }
+
+    // Only one writer, so plain loads and stores suffice for min and max
+    m_buckets[getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(microseconds, std::memory_order_relaxed);
+    if(microseconds < m_min.load(std::memory_order_relaxed))
+    {
+        m_min.store(microseconds, std::memory_order_relaxed);
+    }
+    if(microseconds > m_max.load(std::memory_order_relaxed))
+    {
+        m_max.store(microseconds, std::memory_order_relaxed);
+    }
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+DurationHistogram::TStatistics DurationHistogram::getStatistics() const
+{
+    TStatistics statistics;
+    statistics.count = isResetPending() ? 0 : m_count.load(std::memory_order_acquire);
+    if(statistics.count == 0)
+    {
+        statistics.min = 0;
+        statistics.average = 0;
+        statistics.p99 = 0;
+        statistics.max = 0;
+        return statistics;
+    }
+
+    statistics.min = m_min.load(std::memory_order_relaxed);
+    statistics.average = m_sum.load(std::memory_order_relaxed) / statistics.count;
+    statistics.p99 = getPercentile(99);
+    statistics.max = m_max.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+uint32_t DurationHistogram::getPercentile(unsigned int percent) const
+{
+    uint32_t count(isResetPending() ? 0 : m_count.load(std::memory_order_acquire));
+    if(count == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the duration in question, rounded up
+    uint32_t rank((static_cast<uint64_t>(count) * percent + 99) / 100);
+    uint32_t max(m_max.load(std::memory_order_relaxed));
+
+    uint32_t cumulativeCount(0);
+    for(unsigned int index = 0; index < c_numBuckets; ++index)
+    {
+        cumulativeCount += m_buckets[index].load(std::memory_order_relaxed);
+        if(cumulativeCount >= rank)
+        {
+            uint32_t upperBound(getBucketUpperBound(index));
+            return upperBound < max ? upperBound : max;
+        }
+    }
+
+    return max;
+}
+
+void DurationHistogram::reset()
+{
+    m_resetRequests.fetch_add(1, std::memory_order_release);
+}
+
+bool DurationHistogram::isResetPending() const
+{
+    return m_resetRequests.load(std::memory_order_acquire) != m_resetsDone.load(std::memory_order_acquire);
+}
+
+void DurationHistogram::clear()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    for(auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(UINT32_MAX, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_release);
+}
+
+unsigned int DurationHistogram::getBucketIndex(uint32_t microseconds)
+{
+    if(microseconds < c_numExactBuckets)
+    {
+        return microseconds;
+    }
+
+    // The two bits below the most significant one select the sub bucket
+    unsigned int exponent(31 - __builtin_clz(microseconds));
+    unsigned int subBucket((microseconds >> (exponent - 2)) & (c_numSubBuckets - 1));
+    unsigned int index(c_numExactBuckets + (exponent - 3) * c_numSubBuckets + subBucket);
+
+    return index < c_numBuckets ? index : c_numBuckets - 1;
+}
+
+uint32_t DurationHistogram::getBucketUpperBound(unsigned int index)
+{
+    if(index < c_numExactBuckets)
+    {
+        return index;
+    }
+    if(index == c_numBuckets - 1)
+    {
+        return UINT32_MAX;
+    }
+
+    unsigned int exponent(3 + (index - c_numExactBuckets) / c_numSubBuckets);
+    unsigned int subBucket((index - c_numExactBuckets) % c_numSubBuckets);
+    uint32_t lowerBound((c_numSubBuckets + subBucket) << (exponent - 2));
+
+    return lowerBound + (1u << (exponent - 2)) - 1;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Lock-free histogram of durations.
+ */
+
+#ifndef COMMON_DURATIONHISTOGRAM_H_
+#define COMMON_DURATIONHISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Histogram of durations in microseconds, which can be recorded from one thread and read from any other thread
+ * without locking.
+ *
+ * Durations below 8 us are counted exactly. Larger durations are counted in buckets of which the width is a quarter
+ * of the power of two they start at, so percentiles have a resolution of 25% or better. Durations of about 115 ms
+ * and more end up in the last bucket.
+ *
+ * Reading while recording may give a slightly inconsistent view (e.g. a count which doesn't include the last
+ * duration yet), which is fine for statistics. A reset from a reading thread is only requested, and carried out by the
+ * recording thread at the next record, so it never interferes with a record in progress.
+ */
+class DurationHistogram
+{
+public:
+    /** Statistics derived from the histogram. All durations in microseconds. */
+    struct TStatistics
+    {
+        /** Number of recorded durations. */
+        uint32_t count;
+
+        /** Shortest duration, or 0 if nothing is recorded. */
+        uint32_t min;
+
+        /** Average duration. */
+        uint32_t average;
+
+        /** 99th percentile, rounded up to the end of its bucket and limited to @ref max. */
+        uint32_t p99;
+
+        /** Longest duration. */
+        uint32_t max;
+    };
+
+    /**
+     * Constructor.
+     */
+    DurationHistogram();
+
+    // Prevent implicit copy constructor and assignment operator.
+    DurationHistogram(const DurationHistogram&) = delete;
+    DurationHistogram& operator=(const DurationHistogram&) = delete;
+
+    /**
+     * Record a duration. May only be called from one thread at a time.
+     *
+     * @param[in]   microseconds    The duration.
+     */
+    void record(uint32_t microseconds);
+
+    /**
+     * Get the statistics of all durations recorded since construction or the last reset.
+     *
+     * @note    The sum of all durations is kept in 32 bits, so the average is only valid if the durations recorded
+     *          since the last reset add up to less than about 71 minutes.
+     */
+    TStatistics getStatistics() const;
+
+    /**
+     * Get a percentile, rounded up to the end of its bucket and limited to the longest duration.
+     *
+     * @param[in]   percent     The percentile, 0 to 100.
+     */
+    uint32_t getPercentile(unsigned int percent) const;
+
+    /**
+     * Clear all recorded durations. Can be called from any thread.
+     *
+     * The histogram reads as empty right away, but is only actually cleared by the next call to @ref record.
+     */
+    void reset();
+
+private:
+    /** Number of durations which are counted exactly. */
+    static constexpr unsigned int c_numExactBuckets = 8;
+
+    /** Number of buckets per power of two, above the exact ones. */
+    static constexpr unsigned int c_numSubBuckets = 4;
+
+    /** Total number of buckets. */
+    static constexpr unsigned int c_numBuckets = 64;
+
+    /**
+     * Get the index of the bucket which counts the given duration.
+     */
+    static unsigned int getBucketIndex(uint32_t microseconds);
+
+    /**
+     * Get the longest duration counted in the given bucket.
+     */
+    static uint32_t getBucketUpperBound(unsigned int index);
+
+    /**
+     * Whether a reset is requested but not yet carried out.
+     */
+    bool isResetPending() const;
+
+    /**
+     * Actually clear all recorded durations. Only to be called by the recording thread.
+     */
+    void clear();
+
+    /** Number of durations per bucket. */
+    std::array<std::atomic<uint32_t>, c_numBuckets> m_buckets;
+
+    /** Number of recorded durations. */
+    std::atomic<uint32_t> m_count;
+
+    /** Sum of all recorded durations. */
+    std::atomic<uint32_t> m_sum;
+
+    /** Shortest duration. */
+    std::atomic<uint32_t> m_min;
+
+    /** Longest duration. */
+    std::atomic<uint32_t> m_max;
+
+    /** Number of requested resets. */
+    std::atomic<uint32_t> m_resetRequests;
+
+    /** Number of requested resets which are carried out. */
+    std::atomic<uint32_t> m_resetsDone;
+};
+
+#endif /* COMMON_DURATIONHISTOGRAM_H_ */
@@ -29,7 +29,6 @@
 #ifndef COMMON_INTERFACES_ILOGGINGTARGET_H_
 #define COMMON_INTERFACES_ILOGGINGTARGET_H_
 
-#include <string>
 #include <cstdint>
 
 #include "LoggingDefinitions.h"
@@ -46,9 +45,9 @@ public:
      * @param[in]   time        Timestamp of the log call.
      * @param[in]   level       Log level.
      * @param[in]   component   Originating component.
-     * @param[in]   message     The log message.
+     * @param[in]   message     The log message. Only valid during the call.
      */
-    virtual void logMessage(uint64_t time, Logging::TLogLevel level, std::string component, std::string message) = 0;
+    virtual void logMessage(uint64_t time, Logging::TLogLevel level, const char* component, const char* message) = 0;
 
 protected:
     /**
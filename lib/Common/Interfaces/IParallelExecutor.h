@@ -0,0 +1,62 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Interface for running a job on multiple cores at once.
+ */
+
+#ifndef COMMON_INTERFACES_IPARALLELEXECUTOR_H_
+#define COMMON_INTERFACES_IPARALLELEXECUTOR_H_
+
+#include <functional>
+
+/**
+ * Interface for running a job on multiple cores at once.
+ */
+class IParallelExecutor
+{
+public:
+    /**
+     * Job to run. Gets the number of the part to execute.
+     */
+    typedef std::function<void(unsigned int part)> TJob;
+
+    /**
+     * Get the number of parts which are executed concurrently.
+     */
+    virtual unsigned int getNumParts() const = 0;
+
+    /**
+     * Run all parts of a job concurrently, one of them on the calling thread. Returns when all parts finished, so
+     * the results of all parts are visible to the caller.
+     *
+     * @param[in]   job     The job to run.
+     */
+    virtual void execute(const TJob& job) = 0;
+
+protected:
+    virtual ~IParallelExecutor() = default;
+};
+
+#endif /* COMMON_INTERFACES_IPARALLELEXECUTOR_H_ */
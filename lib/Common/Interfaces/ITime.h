@@ -34,9 +34,18 @@ class ITime
 public:
     /**
      * Get the monotonic time in milliseconds.
+     *
+     * @note    Wraps around after about 49.7 days. Only use differences of two values.
      */
     virtual uint32_t getMilliseconds() const = 0;
 
+    /**
+     * Get the monotonic time in microseconds.
+     *
+     * Uses the same epoch as @ref getMilliseconds, and does not wrap around in practice.
+     */
+    virtual uint64_t getMicroseconds() const = 0;
+
 protected:
     virtual ~ITime() = default;
 };
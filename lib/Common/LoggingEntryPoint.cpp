@@ -25,9 +25,10 @@
  */
 
 #include <vector>
-#include <string>
 #include <mutex>
 #include <cstdarg>
+#include <cstddef>
+#include <cstring>
 #include <algorithm>
 #include <cassert>
 #include <stdio.h>
@@ -36,6 +37,199 @@
 #include "ILoggingTarget.h"
 #include "ITime.h"
 
+namespace
+{
+
+/** Length modifiers of a conversion specification. */
+enum TLength
+{
+    Length_None,
+    Length_Char,
+    Length_Short,
+    Length_Long,
+    Length_LongLong,
+    Length_Size,
+    Length_IntMax,
+    Length_PtrDiff,
+    Length_LongDouble
+};
+
+/** A parsed printf conversion specification, pointing into the format string. */
+struct TSpecification
+{
+    const char* flags;
+    std::size_t numFlags;
+    bool widthFromArgument;
+    const char* width;
+    std::size_t widthLength;
+    bool hasPrecision;
+    bool precisionFromArgument;
+    const char* precision;
+    std::size_t precisionLength;
+    TLength length;
+    /** The conversion character, or '\0' if not supported. */
+    char conversion;
+};
+
+/**
+ * Parse a conversion specification.
+ *
+ * @param[in]   position        Position just after the '%'.
+ * @param[out]  specification   The parsed specification.
+ *
+ * @return  Position just after the specification.
+ */
+const char* parseSpecification(const char* position, TSpecification& specification)
+{
+    specification.flags = position;
+    while(*position != '\0' && std::strchr("-+ #0", *position) != nullptr)
+    {
+        ++position;
+    }
+    specification.numFlags = position - specification.flags;
+
+    specification.widthFromArgument = (*position == '*');
+    specification.width = position;
+    if(specification.widthFromArgument)
+    {
+        ++position;
+    }
+    while(*position >= '0' && *position <= '9')
+    {
+        ++position;
+    }
+    specification.widthLength = position - specification.width;
+
+    specification.hasPrecision = (*position == '.');
+    specification.precisionFromArgument = false;
+    specification.precisionLength = 0;
+    if(specification.hasPrecision)
+    {
+        ++position;
+        specification.precisionFromArgument = (*position == '*');
+        specification.precision = position;
+        if(specification.precisionFromArgument)
+        {
+            ++position;
+        }
+        while(*position >= '0' && *position <= '9')
+        {
+            ++position;
+        }
+        specification.precisionLength = position - specification.precision;
+    }
+
+    specification.length = Length_None;
+    switch(*position)
+    {
+    case 'h':
+        ++position;
+        specification.length = Length_Short;
+        if(*position == 'h')
+        {
+            ++position;
+            specification.length = Length_Char;
+        }
+        break;
+    case 'l':
+        ++position;
+        specification.length = Length_Long;
+        if(*position == 'l')
+        {
+            ++position;
+            specification.length = Length_LongLong;
+        }
+        break;
+    case 'z':
+        ++position;
+        specification.length = Length_Size;
+        break;
+    case 'j':
+        ++position;
+        specification.length = Length_IntMax;
+        break;
+    case 't':
+        ++position;
+        specification.length = Length_PtrDiff;
+        break;
+    case 'L':
+        ++position;
+        specification.length = Length_LongDouble;
+        break;
+    default:
+        break;
+    }
+
+    specification.conversion = *position;
+    switch(specification.conversion)
+    {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        ++position;
+        break;
+    case 'c': case 's': case 'p':
+        // Wide characters and strings are not supported
+        if(specification.length == Length_None)
+        {
+            ++position;
+            break;
+        }
+        // Fall through
+    default:
+        specification.conversion = '\0';
+        break;
+    }
+
+    return position;
+}
+
+/**
+ * Append to a buffer, clamping at its end.
+ */
+void append(char* buffer, std::size_t& position, const char* fmt, ...) __attribute__((format (printf, 3, 4)));
+void append(char* buffer, std::size_t& position, const char* fmt, ...)
+{
+    const std::size_t size(LoggingEntryPoint::c_maxMessageSize);
+    if(position >= size - 1)
+    {
+        return;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    int written(vsnprintf(buffer + position, size - position, fmt, args));
+    va_end(args);
+
+    if(written > 0)
+    {
+        position = std::min(position + static_cast<std::size_t>(written), size - 1);
+    }
+}
+
+/**
+ * Get the value of a width or precision given in the format string, limited to a sane maximum.
+ */
+int parseNumber(const char* digits, std::size_t length)
+{
+    int value(0);
+    for(std::size_t i = 0; i < length; ++i)
+    {
+        value = std::min(value * 10 + (digits[i] - '0'), 9999);
+    }
+    return value;
+}
+
+} /* namespace */
+
+constexpr unsigned int LoggingEntryPoint::c_maxMessageSize;
+constexpr std::size_t LoggingEntryPoint::c_queueSize;
+constexpr unsigned int LoggingEntryPoint::c_maxArguments;
+constexpr unsigned int LoggingEntryPoint::c_maxStringsSize;
+
+MpscQueue<LoggingEntryPoint::TRecord, LoggingEntryPoint::c_queueSize> LoggingEntryPoint::s_queue;
+std::atomic<bool> LoggingEntryPoint::s_deferred(false);
+std::atomic<unsigned int> LoggingEntryPoint::s_numSubscribers(0);
+uint32_t LoggingEntryPoint::s_reportedDroppedCount(0);
 std::vector<ILoggingTarget*> LoggingEntryPoint::s_subscribers;
 std::mutex LoggingEntryPoint::s_mutex;
 const ITime* LoggingEntryPoint::s_time(nullptr);
@@ -55,6 +249,7 @@ void LoggingEntryPoint::subscribe(ILoggingTarget& subscriber)
     if(!found)
     {
         s_subscribers.push_back(&subscriber);
+        s_numSubscribers = s_subscribers.size();
     }
 }
 
@@ -62,31 +257,309 @@ void LoggingEntryPoint::unsubscribe(ILoggingTarget& subscriber)
 {
     std::lock_guard<std::mutex> lock(s_mutex);
     s_subscribers.erase(std::remove(s_subscribers.begin(), s_subscribers.end(), &subscriber), s_subscribers.end());
+    s_numSubscribers = s_subscribers.size();
+}
+
+void LoggingEntryPoint::setDeferred(bool deferred)
+{
+    s_deferred = deferred;
 }
 
 void LoggingEntryPoint::logMessage(Logging::TLogLevel level, const char *component, const char *fmt, ...)
 {
     assert(s_time != nullptr);
-    uint32_t time(s_time->getMilliseconds());
 
+    if(s_numSubscribers == 0)
+    {
+        return;
+    }
+
+    TRecord record;
+    record.time = s_time->getMilliseconds();
+    record.level = level;
+    record.component = component;
+    record.format = fmt;
+    record.numArguments = 0;
+    record.stringsSize = 0;
+
+    // Capture the raw arguments. Formatting is left to processMessages(), which walks the format string the same way.
+    va_list args;
+    va_start(args, fmt);
+    const char* position(fmt);
+    bool capturing(true);
+    while(capturing && *position != '\0')
+    {
+        if(*position++ != '%')
+        {
+            continue;
+        }
+        if(*position == '%')
+        {
+            ++position;
+            continue;
+        }
+
+        TSpecification specification;
+        position = parseSpecification(position, specification);
+
+        unsigned int numNeeded(1 + (specification.widthFromArgument ? 1 : 0) + (specification.precisionFromArgument ? 1 : 0));
+        if(specification.conversion == '\0' || record.numArguments + numNeeded > c_maxArguments)
+        {
+            break;
+        }
+
+        if(specification.widthFromArgument)
+        {
+            record.arguments[record.numArguments++].signedValue = va_arg(args, int);
+        }
+        if(specification.precisionFromArgument)
+        {
+            record.arguments[record.numArguments++].signedValue = va_arg(args, int);
+        }
+
+        TArgument& argument(record.arguments[record.numArguments]);
+        switch(specification.conversion)
+        {
+        case 'd': case 'i':
+            switch(specification.length)
+            {
+            case Length_Char:       argument.signedValue = static_cast<signed char>(va_arg(args, int)); break;
+            case Length_Short:      argument.signedValue = static_cast<short>(va_arg(args, int)); break;
+            case Length_Long:       argument.signedValue = va_arg(args, long); break;
+            case Length_LongLong:   argument.signedValue = va_arg(args, long long); break;
+            case Length_Size:       argument.signedValue = va_arg(args, ptrdiff_t); break;
+            case Length_IntMax:     argument.signedValue = va_arg(args, intmax_t); break;
+            case Length_PtrDiff:    argument.signedValue = va_arg(args, ptrdiff_t); break;
+            default:                argument.signedValue = va_arg(args, int); break;
+            }
+            break;
+
+        case 'u': case 'o': case 'x': case 'X':
+            switch(specification.length)
+            {
+            case Length_Char:       argument.unsignedValue = static_cast<unsigned char>(va_arg(args, unsigned int)); break;
+            case Length_Short:      argument.unsignedValue = static_cast<unsigned short>(va_arg(args, unsigned int)); break;
+            case Length_Long:       argument.unsignedValue = va_arg(args, unsigned long); break;
+            case Length_LongLong:   argument.unsignedValue = va_arg(args, unsigned long long); break;
+            case Length_Size:       argument.unsignedValue = va_arg(args, size_t); break;
+            case Length_IntMax:     argument.unsignedValue = va_arg(args, uintmax_t); break;
+            case Length_PtrDiff:    argument.unsignedValue = va_arg(args, size_t); break;
+            default:                argument.unsignedValue = va_arg(args, unsigned int); break;
+            }
+            break;
+
+        case 'c':
+            argument.signedValue = va_arg(args, int);
+            break;
+
+        case 's':
+        {
+            const char* string(va_arg(args, const char*));
+            if(string == nullptr)
+            {
+                string = "(null)";
+            }
+            std::size_t available(c_maxStringsSize - record.stringsSize);
+            if(available == 0)
+            {
+                capturing = false;
+                continue;
+            }
+            std::size_t length(std::min(std::strlen(string), available - 1));
+            std::memcpy(&record.strings[record.stringsSize], string, length);
+            record.strings[record.stringsSize + length] = '\0';
+            argument.stringOffset = record.stringsSize;
+            record.stringsSize += length + 1;
+            break;
+        }
+
+        case 'p':
+            argument.pointer = va_arg(args, void*);
+            break;
+
+        default:
+            if(specification.length == Length_LongDouble)
+            {
+                argument.floatingPointValue = static_cast<double>(va_arg(args, long double));
+            }
+            else
+            {
+                argument.floatingPointValue = va_arg(args, double);
+            }
+            break;
+        }
+        ++record.numArguments;
+    }
+    va_end(args);
+
+    s_queue.push(record);
+
+    if(!s_deferred)
+    {
+        processMessages();
+    }
+}
+
+bool LoggingEntryPoint::processMessages()
+{
     std::lock_guard<std::mutex> lock(s_mutex);
-    if(s_subscribers.size() > 0)
+
+    // Kept off the stack, as the calling task may have little of it. Protected by the mutex.
+    static TRecord s_processingRecord;
+    static char s_messageBuffer[c_maxMessageSize];
+
+    bool processed(false);
+    while(s_queue.pop(s_processingRecord))
+    {
+        processed = true;
+        format(s_processingRecord, s_messageBuffer);
+        distribute(s_processingRecord.time,
+                   s_processingRecord.level,
+                   s_processingRecord.component,
+                   s_messageBuffer);
+    }
+
+    uint32_t droppedCount(s_queue.getOverflowCount());
+    if(droppedCount != s_reportedDroppedCount)
+    {
+        snprintf(s_messageBuffer, sizeof(s_messageBuffer), "%u log messages dropped",
+                 static_cast<unsigned int>(droppedCount - s_reportedDroppedCount));
+        s_reportedDroppedCount = droppedCount;
+        distribute(s_time != nullptr ? s_time->getMilliseconds() : 0,
+                   Logging::LogLevel_Warning, "LoggingEntryPoint", s_messageBuffer);
+    }
+
+    return processed;
+}
+
+uint32_t LoggingEntryPoint::getDroppedCount()
+{
+    return s_queue.getOverflowCount();
+}
+
+void LoggingEntryPoint::format(const TRecord& record, char* buffer)
+{
+    std::size_t outputPosition(0);
+    buffer[0] = '\0';
+
+    unsigned int argumentIndex(0);
+    const char* position(record.format);
+    while(*position != '\0')
     {
-        std::vector<char> buffer(c_maxMessageSize);
-        va_list args;
-        va_start(args, fmt);
-        vsnprintf(buffer.data(), buffer.size(), fmt, args);
-        va_end(args);
+        // Copy literal text up to the next specification
+        const char* literalEnd(std::strchr(position, '%'));
+        if(literalEnd == nullptr)
+        {
+            literalEnd = position + std::strlen(position);
+        }
+        append(buffer, outputPosition, "%.*s", static_cast<int>(literalEnd - position), position);
+        position = literalEnd;
+        if(*position == '\0')
+        {
+            break;
+        }
+
+        if(position[1] == '%')
+        {
+            append(buffer, outputPosition, "%%");
+            position += 2;
+            continue;
+        }
+
+        TSpecification specification;
+        const char* specificationEnd(parseSpecification(position + 1, specification));
+        unsigned int numNeeded(1 + (specification.widthFromArgument ? 1 : 0) + (specification.precisionFromArgument ? 1 : 0));
+        if(specification.conversion == '\0' || argumentIndex + numNeeded > record.numArguments)
+        {
+            // Arguments were not captured from here on
+            append(buffer, outputPosition, "%s", position);
+            break;
+        }
+        position = specificationEnd;
 
-        std::string message(buffer.data());
-        std::string componentStr(component);
-        for(auto loggingTarget : s_subscribers)
+        // Rebuild the specification, with width and precision filled in and the length normalized for the stored types
+        char rebuilt[32];
+        std::size_t rebuiltPosition(0);
+        rebuilt[rebuiltPosition++] = '%';
+        for(std::size_t i = 0; i < specification.numFlags && rebuiltPosition < 8; ++i)
         {
-            if (loggingTarget != nullptr)
+            rebuilt[rebuiltPosition++] = specification.flags[i];
+        }
+        if(specification.widthFromArgument || specification.widthLength > 0)
+        {
+            int width(specification.widthFromArgument
+                      ? static_cast<int>(record.arguments[argumentIndex++].signedValue)
+                      : parseNumber(specification.width, specification.widthLength));
+            // A negative width is taken as a '-' flag
+            width = std::max(std::min(width, 9999), -9999);
+            rebuiltPosition += snprintf(&rebuilt[rebuiltPosition], 6, "%d", width);
+        }
+        if(specification.hasPrecision)
+        {
+            int precision(specification.precisionFromArgument
+                          ? static_cast<int>(record.arguments[argumentIndex++].signedValue)
+                          : parseNumber(specification.precision, specification.precisionLength));
+            // A negative precision is taken as if it were omitted
+            if(precision >= 0)
             {
-                loggingTarget->logMessage(time, level, componentStr, message);
+                rebuiltPosition += snprintf(&rebuilt[rebuiltPosition], 6, ".%d", std::min(precision, 9999));
             }
         }
+
+        const TArgument& argument(record.arguments[argumentIndex++]);
+        switch(specification.conversion)
+        {
+        case 'd': case 'i':
+            rebuilt[rebuiltPosition++] = 'l';
+            rebuilt[rebuiltPosition++] = 'l';
+            rebuilt[rebuiltPosition++] = specification.conversion;
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, static_cast<long long>(argument.signedValue));
+            break;
+
+        case 'u': case 'o': case 'x': case 'X':
+            rebuilt[rebuiltPosition++] = 'l';
+            rebuilt[rebuiltPosition++] = 'l';
+            rebuilt[rebuiltPosition++] = specification.conversion;
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, static_cast<unsigned long long>(argument.unsignedValue));
+            break;
+
+        case 'c':
+            rebuilt[rebuiltPosition++] = 'c';
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, static_cast<int>(argument.signedValue));
+            break;
+
+        case 's':
+            rebuilt[rebuiltPosition++] = 's';
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, &record.strings[argument.stringOffset]);
+            break;
+
+        case 'p':
+            rebuilt[rebuiltPosition++] = 'p';
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, argument.pointer);
+            break;
+
+        default:
+            rebuilt[rebuiltPosition++] = specification.conversion;
+            rebuilt[rebuiltPosition] = '\0';
+            append(buffer, outputPosition, rebuilt, argument.floatingPointValue);
+            break;
+        }
+    }
+}
+
+void LoggingEntryPoint::distribute(uint32_t time, Logging::TLogLevel level, const char* component, const char* message)
+{
+    for(auto loggingTarget : s_subscribers)
+    {
+        if (loggingTarget != nullptr)
+        {
+            loggingTarget->logMessage(time, level, component, message);
+        }
     }
 }
 
@@ -31,15 +31,24 @@
 
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 #include "LoggingDefinitions.h"
+#include "MpscQueue.h"
 
 class ILoggingTarget;
 class ITime;
 
 /**
  * Static class which receives log events and distributes them to subscribers (logging implementations).
+ *
+ * Logging is cheap for the caller: the format string, component, time and raw arguments are put into a lock-free
+ * queue, without formatting or allocating. Strings passed for %s are copied, as they may not live long enough.
+ * Formatting and distribution to the subscribers happens directly after queuing by default. In deferred mode, it
+ * happens when @ref processMessages is called, typically by a low priority task. When the queue is full, messages are
+ * dropped and counted, and a warning is distributed when the queue is processed again.
  */
 class LoggingEntryPoint
 {
@@ -68,23 +77,100 @@ public:
      */
     static void setTime(const ITime* time);
 
+    /**
+     * Set whether messages are processed by @ref processMessages only, instead of directly when logged.
+     */
+    static void setDeferred(bool deferred);
+
     /**
      * Log a message.
      *
      * @param[in]   level       Log level.
-     * @param[in]   component   Originating component.
-     * @param[in]   fmt         Format string of the log message.
-     * @param[in]   ...         Arguments to use for string formatting.
+     * @param[in]   component   Originating component. Must be a string literal, or live forever otherwise.
+     * @param[in]   fmt         Format string of the log message. Must be a string literal, or live forever otherwise.
+     * @param[in]   ...         Arguments to use for string formatting. At most @ref c_maxArguments, including
+     *                          those for * width and precision.
      */
     static void logMessage(Logging::TLogLevel level, const char *component, const char *fmt, ...) __attribute__((format (printf, 3, 4)));
 
+    /**
+     * Format all queued messages and distribute them to the subscribers.
+     *
+     * @retval  true    One or more messages were processed.
+     * @retval  false   The queue was empty.
+     */
+    static bool processMessages();
+
+    /**
+     * Get the total number of messages dropped because the queue was full.
+     */
+    static uint32_t getDroppedCount();
+
     /** Max log message size, excluding file, line and level information. */
-    static constexpr unsigned int c_maxMessageSize = 2048;
+    static constexpr unsigned int c_maxMessageSize = 256;
+
+    /** Max number of messages which can be queued. */
+    static constexpr std::size_t c_queueSize = 32;
+
+    /** Max number of arguments per message. */
+    static constexpr unsigned int c_maxArguments = 10;
+
+    /** Max total size of the strings passed as arguments per message, including terminators. */
+    static constexpr unsigned int c_maxStringsSize = 128;
+
 private:
+    /** A raw argument, interpreted according to the format string. */
+    union TArgument
+    {
+        int64_t signedValue;
+        uint64_t unsignedValue;
+        double floatingPointValue;
+        const void* pointer;
+        uint16_t stringOffset;
+    };
+
+    /** A queued message. */
+    struct TRecord
+    {
+        uint32_t time;
+        Logging::TLogLevel level;
+        const char* component;
+        const char* format;
+        uint8_t numArguments;
+        TArgument arguments[c_maxArguments];
+        uint16_t stringsSize;
+        char strings[c_maxStringsSize];
+    };
+
+    /**
+     * Format a queued message.
+     *
+     * @param[in]   record  The queued message.
+     * @param[out]  buffer  Buffer of @ref c_maxMessageSize characters for the formatted message.
+     */
+    static void format(const TRecord& record, char* buffer);
+
+    /**
+     * Distribute a formatted message to the subscribers. Must be called with the mutex held.
+     */
+    static void distribute(uint32_t time, Logging::TLogLevel level, const char* component, const char* message);
+
+    /** Queue of messages to process. */
+    static MpscQueue<TRecord, c_queueSize> s_queue;
+
+    /** Whether messages are processed by @ref processMessages only. */
+    static std::atomic<bool> s_deferred;
+
+    /** Number of subscribers, to skip queuing when nobody listens without locking. */
+    static std::atomic<unsigned int> s_numSubscribers;
+
+    /** Number of dropped messages which was last reported. Protected by the mutex. */
+    static uint32_t s_reportedDroppedCount;
+
     /** The list of subscribers. */
     static std::vector<ILoggingTarget*> s_subscribers;
 
-    /** Mutex to protect the list of subscribers. */
+    /** Mutex to protect the list of subscribers, and to let only one thread at a time process the queue. */
     static std::mutex s_mutex;
 
     static const ITime* s_time;
@@ -38,7 +38,7 @@ class MockLoggingTarget
 {
 public:
     // ILoggingTarget implementation
-    MOCK_METHOD4(logMessage, void(uint64_t time, Logging::TLogLevel level, std::string component, std::string message));
+    MOCK_METHOD4(logMessage, void(uint64_t time, Logging::TLogLevel level, const char* component, const char* message));
 };
 
 
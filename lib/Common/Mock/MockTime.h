@@ -34,6 +34,7 @@ class MockTime : public ITime
 {
 public:
     MOCK_CONST_METHOD0(getMilliseconds, uint32_t());
+    MOCK_CONST_METHOD0(getMicroseconds, uint64_t());
 };
 
 
@@ -0,0 +1,180 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Fixed-capacity multiple-producer/single-consumer queue.
+ */
+
+#ifndef COMMON_MPSCQUEUE_H_
+#define COMMON_MPSCQUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fixed-capacity, lock-free queue for handing off plain data from any number of producer threads to one consumer
+ * thread.
+ *
+ * Every slot carries a sequence number, which tells whether it's free for the producer claiming it or filled for the
+ * consumer. Producers claim slots by atomically incrementing the write position, so they never wait for each other
+ * while copying their item. Pushing and popping never allocate or block. When the queue is full, pushed items are
+ * dropped and counted.
+ *
+ * @tparam  T           Item type. Should be plain data.
+ * @tparam  Capacity    Maximum number of items. Must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class MpscQueue
+{
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    /**
+     * Constructor.
+     */
+    MpscQueue()
+        : m_slots()
+        , m_head(0)
+        , m_tail(0)
+        , m_overflowCount(0)
+    {
+        for(std::size_t i = 0; i < Capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Prevent implicit copy constructor and assignment operator.
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Add an item to the back of the queue. May be called by any thread.
+     *
+     * @param   [in]    item    The item to add.
+     *
+     * @retval  true    The item was added.
+     * @retval  false   The queue was full, the item is dropped.
+     */
+    bool push(const T& item)
+    {
+        std::size_t tail(m_tail.load(std::memory_order_relaxed));
+        for(;;)
+        {
+            TSlot& slot(m_slots[tail & c_indexMask]);
+            std::size_t sequence(slot.sequence.load(std::memory_order_acquire));
+            std::ptrdiff_t difference(static_cast<std::ptrdiff_t>(sequence - tail));
+            if(difference == 0)
+            {
+                // Slot is free, try to claim it
+                if(m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    slot.item = item;
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+                // Another producer was first, tail is updated by the failed exchange
+            }
+            else if(difference < 0)
+            {
+                // Slot still holds an item of the previous round
+                m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the slot already
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Take an item from the front of the queue. May only be called by the consumer.
+     *
+     * @param   [out]   item    The item taken.
+     *
+     * @retval  true    An item was taken.
+     * @retval  false   The queue was empty, or the item in front is still being written.
+     */
+    bool pop(T& item)
+    {
+        const std::size_t head(m_head.load(std::memory_order_relaxed));
+        TSlot& slot(m_slots[head & c_indexMask]);
+        if(slot.sequence.load(std::memory_order_acquire) != head + 1)
+        {
+            return false;
+        }
+
+        item = slot.item;
+        slot.sequence.store(head + Capacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Get the capacity of the queue.
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * Get the total number of items dropped because the queue was full.
+     */
+    uint32_t getOverflowCount() const
+    {
+        return m_overflowCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t c_indexMask = Capacity - 1;
+
+    /** A slot of the queue. */
+    struct TSlot
+    {
+        /** Equals the position when free for the producer, and the position + 1 when filled for the consumer. */
+        std::atomic<std::size_t> sequence;
+
+        /** The item. */
+        T item;
+    };
+
+    /** The slots. */
+    std::array<TSlot, Capacity> m_slots;
+
+    /** Position to pop the next item from. Only used by the consumer. */
+    std::atomic<std::size_t> m_head;
+
+    /** Position to push the next item to. */
+    std::atomic<std::size_t> m_tail;
+
+    /** Number of items dropped because the queue was full. */
+    std::atomic<uint32_t> m_overflowCount;
+};
+
+#endif /* COMMON_MPSCQUEUE_H_ */
@@ -0,0 +1,158 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Fixed-capacity single-producer/single-consumer queue.
+ */
+
+#ifndef COMMON_SPSCQUEUE_H_
+#define COMMON_SPSCQUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fixed-capacity, lock-free queue for handing off plain data from one producer thread to one consumer thread.
+ *
+ * Pushing and popping never allocate or block. When the queue is full, pushed items are dropped and counted, so the
+ * consumer can detect overload.
+ *
+ * @tparam  T           Item type. Should be cheap to copy.
+ * @tparam  Capacity    Maximum number of items. Must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    /**
+     * Constructor.
+     */
+    SpscQueue()
+        : m_items()
+        , m_head(0)
+        , m_tail(0)
+        , m_overflowCount(0)
+    {
+    }
+
+    // Prevent implicit copy constructor and assignment operator.
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Add an item to the back of the queue. May only be called by the producer.
+     *
+     * @param   [in]    item    The item to add.
+     *
+     * @retval  true    The item was added.
+     * @retval  false   The queue was full, the item is dropped.
+     */
+    bool push(const T& item)
+    {
+        const std::size_t tail(m_tail.load(std::memory_order_relaxed));
+        if(tail - m_head.load(std::memory_order_acquire) >= Capacity)
+        {
+            m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_items[tail & c_indexMask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Take an item from the front of the queue. May only be called by the consumer.
+     *
+     * @param   [out]   item    The item taken.
+     *
+     * @retval  true    An item was taken.
+     * @retval  false   The queue was empty.
+     */
+    bool pop(T& item)
+    {
+        const std::size_t head(m_head.load(std::memory_order_relaxed));
+        if(head == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = m_items[head & c_indexMask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Get the number of items in the queue. Only exact when called by the producer or consumer.
+     */
+    std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Check whether the queue is empty. Only exact when called by the producer or consumer.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Get the capacity of the queue.
+     */
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    /**
+     * Get the total number of items dropped because the queue was full.
+     */
+    uint32_t getOverflowCount() const
+    {
+        return m_overflowCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t c_indexMask = Capacity - 1;
+
+    /** The item storage. */
+    std::array<T, Capacity> m_items;
+
+    /** Free-running index of the next item to pop. Written by the consumer only. */
+    std::atomic<std::size_t> m_head;
+
+    /** Free-running index of the next item to push. Written by the producer only. */
+    std::atomic<std::size_t> m_tail;
+
+    /** Number of dropped items. */
+    std::atomic<uint32_t> m_overflowCount;
+};
+
+#endif /* COMMON_SPSCQUEUE_H_ */
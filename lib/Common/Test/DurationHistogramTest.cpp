@@ -0,0 +1,139 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the DurationHistogram class.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../DurationHistogram.h"
+
+class DurationHistogramTest
+    : public ::testing::Test
+{
+public:
+    DurationHistogram m_histogram;
+};
+
+TEST_F(DurationHistogramTest, initiallyEmpty)
+{
+    auto statistics(m_histogram.getStatistics());
+    EXPECT_EQ(0, statistics.count);
+    EXPECT_EQ(0, statistics.min);
+    EXPECT_EQ(0, statistics.average);
+    EXPECT_EQ(0, statistics.p99);
+    EXPECT_EQ(0, statistics.max);
+}
+
+TEST_F(DurationHistogramTest, statistics)
+{
+    for(uint32_t duration = 1; duration <= 100; ++duration)
+    {
+        m_histogram.record(duration * 10);
+    }
+
+    auto statistics(m_histogram.getStatistics());
+    EXPECT_EQ(100, statistics.count);
+    EXPECT_EQ(10, statistics.min);
+    EXPECT_EQ(505, statistics.average);
+    EXPECT_EQ(1000, statistics.max);
+
+    // 99th duration is 990, which is in the bucket of 896 to 1023. Limited to the maximum.
+    EXPECT_EQ(1000, statistics.p99);
+}
+
+TEST_F(DurationHistogramTest, percentileResolution)
+{
+    // 90 short durations, 10 long ones
+    for(unsigned int i = 0; i < 90; ++i)
+    {
+        m_histogram.record(100);
+    }
+    for(unsigned int i = 0; i < 10; ++i)
+    {
+        m_histogram.record(5000);
+    }
+    m_histogram.record(20000);
+
+    // 100 is in the bucket of 96 to 111
+    EXPECT_EQ(111, m_histogram.getPercentile(50));
+    // 5000 is in the bucket of 4096 to 5119
+    EXPECT_EQ(5119, m_histogram.getPercentile(99));
+    EXPECT_EQ(20000, m_histogram.getPercentile(100));
+}
+
+TEST_F(DurationHistogramTest, exactSmallDurations)
+{
+    for(uint32_t duration = 0; duration < 8; ++duration)
+    {
+        m_histogram.record(duration);
+    }
+
+    EXPECT_EQ(3, m_histogram.getPercentile(50));
+    EXPECT_EQ(7, m_histogram.getPercentile(100));
+}
+
+TEST_F(DurationHistogramTest, veryLongDuration)
+{
+    m_histogram.record(UINT32_MAX / 2);
+
+    auto statistics(m_histogram.getStatistics());
+    EXPECT_EQ(1, statistics.count);
+    EXPECT_EQ(UINT32_MAX / 2, statistics.p99);
+    EXPECT_EQ(UINT32_MAX / 2, statistics.max);
+}
+
+TEST_F(DurationHistogramTest, reset)
+{
+    m_histogram.record(42);
+    m_histogram.reset();
+    m_histogram.record(10);
+
+    auto statistics(m_histogram.getStatistics());
+    EXPECT_EQ(1, statistics.count);
+    EXPECT_EQ(10, statistics.min);
+    EXPECT_EQ(10, statistics.average);
+    EXPECT_EQ(10, statistics.max);
+}
+
+TEST_F(DurationHistogramTest, resetReadsEmptyBeforeNextRecord)
+{
+    m_histogram.record(42);
+    m_histogram.reset();
+
+    auto statistics(m_histogram.getStatistics());
+    EXPECT_EQ(0, statistics.count);
+    EXPECT_EQ(0, statistics.max);
+    EXPECT_EQ(0, m_histogram.getPercentile(100));
+
+    // Multiple requests before the next record result in a single reset
+    m_histogram.reset();
+    m_histogram.record(10);
+    m_histogram.record(20);
+    statistics = m_histogram.getStatistics();
+    EXPECT_EQ(2, statistics.count);
+    EXPECT_EQ(10, statistics.min);
+    EXPECT_EQ(20, statistics.max);
+}
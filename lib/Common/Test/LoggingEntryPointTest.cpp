@@ -0,0 +1,143 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the LoggingEntryPoint class.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "../LoggingEntryPoint.h"
+#include "../Mock/MockLoggingTarget.h"
+#include "../Mock/MockTime.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::StrEq;
+
+class LoggingEntryPointTest
+    : public ::testing::Test
+{
+public:
+    LoggingEntryPointTest()
+        : m_time()
+        , m_loggingTarget()
+    {
+        ON_CALL(m_time, getMilliseconds())
+            .WillByDefault(Return(1234));
+
+        LoggingEntryPoint::setTime(&m_time);
+        LoggingEntryPoint::subscribe(m_loggingTarget);
+    }
+
+    ~LoggingEntryPointTest() override
+    {
+        LoggingEntryPoint::unsubscribe(m_loggingTarget);
+        LoggingEntryPoint::setDeferred(false);
+        LoggingEntryPoint::processMessages();
+        LoggingEntryPoint::setTime(nullptr);
+    }
+
+    NiceMock<MockTime> m_time;
+    MockLoggingTarget m_loggingTarget;
+};
+
+TEST_F(LoggingEntryPointTest, logMessage)
+{
+    EXPECT_CALL(m_loggingTarget, logMessage(1234, Logging::LogLevel_Warning, StrEq("test"), StrEq("hello 42")));
+
+    LoggingEntryPoint::logMessage(Logging::LogLevel_Warning, "test", "hello %d", 42);
+}
+
+TEST_F(LoggingEntryPointTest, formatting)
+{
+    EXPECT_CALL(m_loggingTarget, logMessage(_, _, _,
+        StrEq("[  -7|ff  |000012|ab  |1.50|4294967295|-9223372036854775807|65535|100%]")));
+
+    unsigned short truncated = 0xffff;
+    LoggingEntryPoint::logMessage(Logging::LogLevel_Info, "test", "[%4d|%-*x|%0*u|%-4.2s|%.2f|%lu|%lld|%hu|100%%]",
+                                  -7,
+                                  4, 0xff,
+                                  6, 12u,
+                                  "abc",
+                                  1.5,
+                                  static_cast<unsigned long>(UINT32_MAX),
+                                  static_cast<long long>(-INT64_MAX),
+                                  truncated);
+}
+
+TEST_F(LoggingEntryPointTest, tooManyArguments)
+{
+    static_assert(LoggingEntryPoint::c_maxArguments == 10, "test assumes max 10 arguments");
+
+    // Specifications of which the arguments could not be captured are printed as is
+    EXPECT_CALL(m_loggingTarget, logMessage(_, _, _, StrEq("0 1 2 3 4 5 6 7 8 9 %d")));
+
+    LoggingEntryPoint::logMessage(Logging::LogLevel_Info, "test", "%d %d %d %d %d %d %d %d %d %d %d",
+                                  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+}
+
+TEST_F(LoggingEntryPointTest, deferred)
+{
+    LoggingEntryPoint::setDeferred(true);
+
+    char string[] = "original";
+    LoggingEntryPoint::logMessage(Logging::LogLevel_Info, "test", "first %s", string);
+    LoggingEntryPoint::logMessage(Logging::LogLevel_Info, "test", "second");
+
+    // Strings must be copied at the time of the log call
+    std::strcpy(string, "changed");
+
+    ::testing::Sequence sequence;
+    EXPECT_CALL(m_loggingTarget, logMessage(_, _, _, StrEq("first original")))
+        .InSequence(sequence);
+    EXPECT_CALL(m_loggingTarget, logMessage(_, _, _, StrEq("second")))
+        .InSequence(sequence);
+
+    EXPECT_TRUE(LoggingEntryPoint::processMessages());
+    EXPECT_FALSE(LoggingEntryPoint::processMessages());
+}
+
+TEST_F(LoggingEntryPointTest, droppedMessages)
+{
+    LoggingEntryPoint::setDeferred(true);
+
+    uint32_t droppedBefore(LoggingEntryPoint::getDroppedCount());
+    for(unsigned int i = 0; i < LoggingEntryPoint::c_queueSize + 3; ++i)
+    {
+        LoggingEntryPoint::logMessage(Logging::LogLevel_Info, "test", "message %u", i);
+    }
+    EXPECT_EQ(droppedBefore + 3, LoggingEntryPoint::getDroppedCount());
+
+    EXPECT_CALL(m_loggingTarget, logMessage(_, Logging::LogLevel_Info, StrEq("test"), _))
+        .Times(LoggingEntryPoint::c_queueSize);
+    EXPECT_CALL(m_loggingTarget, logMessage(_, Logging::LogLevel_Warning, _, StrEq("3 log messages dropped")));
+
+    EXPECT_TRUE(LoggingEntryPoint::processMessages());
+}
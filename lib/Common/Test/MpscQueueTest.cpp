@@ -0,0 +1,143 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the MpscQueue class.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "../MpscQueue.h"
+
+class MpscQueueTest
+    : public ::testing::Test
+{
+public:
+    MpscQueue<int, 4> m_queue;
+};
+
+TEST_F(MpscQueueTest, initiallyEmpty)
+{
+    int item;
+    EXPECT_FALSE(m_queue.pop(item));
+    EXPECT_EQ(0, m_queue.getOverflowCount());
+}
+
+TEST_F(MpscQueueTest, fifoOrder)
+{
+    EXPECT_TRUE(m_queue.push(1));
+    EXPECT_TRUE(m_queue.push(2));
+    EXPECT_TRUE(m_queue.push(3));
+
+    int item;
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(1, item);
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(2, item);
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(3, item);
+    EXPECT_FALSE(m_queue.pop(item));
+}
+
+TEST_F(MpscQueueTest, overflow)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(m_queue.push(i));
+    }
+    EXPECT_FALSE(m_queue.push(4));
+    EXPECT_FALSE(m_queue.push(5));
+    EXPECT_EQ(2, m_queue.getOverflowCount());
+
+    // Dropped items must not overwrite queued ones
+    int item;
+    for(int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i, item);
+    }
+    EXPECT_FALSE(m_queue.pop(item));
+}
+
+TEST_F(MpscQueueTest, wrapAround)
+{
+    int item;
+    for(int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(m_queue.push(i));
+        EXPECT_TRUE(m_queue.push(i + 100));
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i, item);
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i + 100, item);
+    }
+    EXPECT_EQ(0, m_queue.getOverflowCount());
+}
+
+TEST(MpscQueueThreadTest, multipleProducers)
+{
+    static constexpr unsigned int c_numProducers = 4;
+    static constexpr unsigned int c_numItemsPerProducer = 50000;
+    MpscQueue<unsigned int, 64> queue;
+
+    std::vector<std::thread> producers;
+    for(unsigned int producer = 0; producer < c_numProducers; ++producer)
+    {
+        producers.emplace_back([&queue, producer]() {
+            for(unsigned int i = 0; i < c_numItemsPerProducer; ++i)
+            {
+                while(!queue.push(producer * c_numItemsPerProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Items of every single producer must arrive in order
+    std::vector<unsigned int> expected(c_numProducers, 0);
+    unsigned int numReceived = 0;
+    while(numReceived < c_numProducers * c_numItemsPerProducer)
+    {
+        unsigned int item;
+        if(queue.pop(item))
+        {
+            unsigned int producer = item / c_numItemsPerProducer;
+            ASSERT_LT(producer, c_numProducers);
+            ASSERT_EQ(expected[producer], item % c_numItemsPerProducer);
+            ++expected[producer];
+            ++numReceived;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    for(auto& producer : producers)
+    {
+        producer.join();
+    }
+}
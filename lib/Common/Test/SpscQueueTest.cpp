@@ -0,0 +1,132 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the SpscQueue class.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "../SpscQueue.h"
+
+class SpscQueueTest
+    : public ::testing::Test
+{
+public:
+    SpscQueue<int, 4> m_queue;
+};
+
+TEST_F(SpscQueueTest, initiallyEmpty)
+{
+    int item;
+    EXPECT_TRUE(m_queue.empty());
+    EXPECT_EQ(0, m_queue.size());
+    EXPECT_FALSE(m_queue.pop(item));
+    EXPECT_EQ(0, m_queue.getOverflowCount());
+}
+
+TEST_F(SpscQueueTest, fifoOrder)
+{
+    EXPECT_TRUE(m_queue.push(1));
+    EXPECT_TRUE(m_queue.push(2));
+    EXPECT_TRUE(m_queue.push(3));
+    EXPECT_EQ(3, m_queue.size());
+
+    int item;
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(1, item);
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(2, item);
+    ASSERT_TRUE(m_queue.pop(item));
+    EXPECT_EQ(3, item);
+    EXPECT_FALSE(m_queue.pop(item));
+}
+
+TEST_F(SpscQueueTest, overflow)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(m_queue.push(i));
+    }
+    EXPECT_FALSE(m_queue.push(4));
+    EXPECT_FALSE(m_queue.push(5));
+    EXPECT_EQ(2, m_queue.getOverflowCount());
+
+    // Dropped items must not overwrite queued ones
+    int item;
+    for(int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i, item);
+    }
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(SpscQueueTest, wrapAround)
+{
+    int item;
+    for(int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(m_queue.push(i));
+        EXPECT_TRUE(m_queue.push(i + 100));
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i, item);
+        ASSERT_TRUE(m_queue.pop(item));
+        EXPECT_EQ(i + 100, item);
+    }
+    EXPECT_EQ(0, m_queue.getOverflowCount());
+}
+
+TEST(SpscQueueThreadTest, producerConsumer)
+{
+    static constexpr unsigned int c_numItems = 100000;
+    SpscQueue<unsigned int, 64> queue;
+
+    std::thread producer([&queue]() {
+        for(unsigned int i = 0; i < c_numItems; ++i)
+        {
+            while(!queue.push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    unsigned int expected = 0;
+    while(expected < c_numItems)
+    {
+        unsigned int item;
+        if(queue.pop(item))
+        {
+            ASSERT_EQ(expected, item);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
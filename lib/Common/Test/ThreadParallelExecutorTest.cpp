@@ -0,0 +1,94 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the ThreadParallelExecutor class.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <thread>
+
+#include "../ThreadParallelExecutor.h"
+
+TEST(ThreadParallelExecutorTest, allPartsRunOnce)
+{
+    ThreadParallelExecutor executor(4);
+    ASSERT_EQ(4, executor.getNumParts());
+
+    std::atomic<unsigned int> counts[4] = {};
+    executor.execute([&](unsigned int part) { ++counts[part]; });
+
+    // All parts finished when execute returns
+    for(const auto& count : counts)
+    {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(ThreadParallelExecutorTest, partsRunOnDifferentThreads)
+{
+    ThreadParallelExecutor executor(3);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::thread::id firstPartThread;
+    executor.execute([&](unsigned int part) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        if(part == 0)
+        {
+            firstPartThread = std::this_thread::get_id();
+        }
+    });
+
+    EXPECT_EQ(3, threads.size());
+    EXPECT_EQ(std::this_thread::get_id(), firstPartThread);
+}
+
+TEST(ThreadParallelExecutorTest, repeatedExecution)
+{
+    ThreadParallelExecutor executor;
+
+    // Plain ints, the barrier must make the results visible
+    unsigned int counts[2] = {};
+    for(unsigned int i = 0; i < 1000; ++i)
+    {
+        executor.execute([&](unsigned int part) { ++counts[part]; });
+    }
+
+    EXPECT_EQ(1000, counts[0]);
+    EXPECT_EQ(1000, counts[1]);
+}
+
+TEST(ThreadParallelExecutorTest, singlePartRunsOnCaller)
+{
+    ThreadParallelExecutor executor(1);
+    ASSERT_EQ(1, executor.getNumParts());
+
+    std::thread::id thread;
+    executor.execute([&](unsigned int part) { thread = std::this_thread::get_id(); });
+    EXPECT_EQ(std::this_thread::get_id(), thread);
+}
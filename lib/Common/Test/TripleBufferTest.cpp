@@ -0,0 +1,134 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for the TripleBuffer class.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "../TripleBuffer.h"
+
+class TripleBufferTest
+    : public ::testing::Test
+{
+public:
+    TripleBufferTest()
+        : m_buffer(0)
+    {
+    }
+
+    TripleBuffer<int> m_buffer;
+};
+
+TEST_F(TripleBufferTest, nothingPublished)
+{
+    EXPECT_FALSE(m_buffer.fetch());
+    EXPECT_EQ(0, m_buffer.getReadBuffer());
+}
+
+TEST_F(TripleBufferTest, publishAndFetch)
+{
+    m_buffer.getWriteBuffer() = 1;
+    m_buffer.publish();
+
+    ASSERT_TRUE(m_buffer.fetch());
+    EXPECT_EQ(1, m_buffer.getReadBuffer());
+
+    // Fetching again keeps the same value
+    EXPECT_FALSE(m_buffer.fetch());
+    EXPECT_EQ(1, m_buffer.getReadBuffer());
+}
+
+TEST_F(TripleBufferTest, latestValueWins)
+{
+    for(int i = 1; i <= 5; ++i)
+    {
+        m_buffer.getWriteBuffer() = i;
+        m_buffer.publish();
+    }
+
+    ASSERT_TRUE(m_buffer.fetch());
+    EXPECT_EQ(5, m_buffer.getReadBuffer());
+    EXPECT_FALSE(m_buffer.fetch());
+}
+
+TEST_F(TripleBufferTest, buffersAreNotShared)
+{
+    m_buffer.getWriteBuffer() = 1;
+    m_buffer.publish();
+    ASSERT_TRUE(m_buffer.fetch());
+
+    // Writing must not affect the buffer being read
+    m_buffer.getWriteBuffer() = 2;
+    EXPECT_EQ(1, m_buffer.getReadBuffer());
+    m_buffer.publish();
+    m_buffer.getWriteBuffer() = 3;
+    EXPECT_EQ(1, m_buffer.getReadBuffer());
+
+    ASSERT_TRUE(m_buffer.fetch());
+    EXPECT_EQ(2, m_buffer.getReadBuffer());
+}
+
+TEST(TripleBufferThreadTest, producerConsumer)
+{
+    static constexpr unsigned int c_numValues = 100000;
+    static constexpr unsigned int c_size = 16;
+    TripleBuffer<std::vector<unsigned int>> buffer(std::vector<unsigned int>(c_size, 0));
+
+    std::thread producer([&buffer]() {
+        for(unsigned int value = 1; value <= c_numValues; ++value)
+        {
+            auto& values(buffer.getWriteBuffer());
+            for(auto& item : values)
+            {
+                item = value;
+            }
+            buffer.publish();
+        }
+    });
+
+    // Values must never be torn, and never go back in time
+    unsigned int last = 0;
+    while(last < c_numValues)
+    {
+        if(buffer.fetch())
+        {
+            const auto& values(buffer.getReadBuffer());
+            for(auto item : values)
+            {
+                ASSERT_EQ(values[0], item);
+            }
+            ASSERT_GT(values[0], last);
+            last = values[0];
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Parallel executor using standard threads.
+ */
+
+#ifndef COMMON_THREADPARALLELEXECUTOR_H_
+#define COMMON_THREADPARALLELEXECUTOR_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "IParallelExecutor.h"
+
+/**
+ * Parallel executor using standard threads, for the host (tests, benchmarks and simulator).
+ *
+ * Keeps a worker thread per part except the first, which runs on the calling thread. Header only, as targets without
+ * standard threads must not compile it.
+ */
+class ThreadParallelExecutor
+    : public IParallelExecutor
+{
+public:
+    /**
+     * Constructor. Starts the worker threads.
+     *
+     * @param[in]   numParts    Number of parts to execute concurrently.
+     */
+    explicit ThreadParallelExecutor(unsigned int numParts = 2)
+        : m_numParts(numParts == 0 ? 1 : numParts)
+        , m_mutex()
+        , m_startCondition()
+        , m_doneCondition()
+        , m_job(nullptr)
+        , m_generation(0)
+        , m_pending(0)
+        , m_terminate(false)
+        , m_workers()
+    {
+        for(unsigned int part = 1; part < m_numParts; ++part)
+        {
+            m_workers.emplace_back(&ThreadParallelExecutor::work, this, part);
+        }
+    }
+
+    /**
+     * Destructor. Stops the worker threads.
+     */
+    ~ThreadParallelExecutor() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_terminate = true;
+        }
+        m_startCondition.notify_all();
+
+        for(auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    // Prevent implicit copy constructor and assignment operator.
+    ThreadParallelExecutor(const ThreadParallelExecutor&) = delete;
+    ThreadParallelExecutor& operator=(const ThreadParallelExecutor&) = delete;
+
+    // IParallelExecutor implementation
+    unsigned int getNumParts() const override
+    {
+        return m_numParts;
+    }
+
+    void execute(const TJob& job) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_pending = m_numParts - 1;
+            ++m_generation;
+        }
+        m_startCondition.notify_all();
+
+        job(0);
+
+        // Barrier: the mutex also makes the results of the workers visible here
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_pending == 0; });
+        m_job = nullptr;
+    }
+
+private:
+    /**
+     * Worker thread function.
+     *
+     * @param[in]   part    The part to execute.
+     */
+    void work(unsigned int part)
+    {
+        unsigned int generation(0);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_startCondition.wait(lock, [&] { return m_terminate || (m_generation != generation); });
+            if(m_terminate)
+            {
+                return;
+            }
+            generation = m_generation;
+
+            const TJob& job(*m_job);
+            lock.unlock();
+            job(part);
+            lock.lock();
+
+            if(--m_pending == 0)
+            {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+
+    /** Number of parts. */
+    const unsigned int m_numParts;
+
+    /** Mutex to protect the members below. */
+    std::mutex m_mutex;
+
+    /** Signals the workers to start a job, or to terminate. */
+    std::condition_variable m_startCondition;
+
+    /** Signals the caller that all workers finished. */
+    std::condition_variable m_doneCondition;
+
+    /** The job being executed. */
+    const TJob* m_job;
+
+    /** Incremented for every job, so workers don't run a job twice. */
+    unsigned int m_generation;
+
+    /** Number of workers which did not finish the current job yet. */
+    unsigned int m_pending;
+
+    /** Whether the workers must terminate. */
+    bool m_terminate;
+
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+};
+
+#endif /* COMMON_THREADPARALLELEXECUTOR_H_ */
@@ -0,0 +1,129 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Lock-free triple buffer.
+ */
+
+#ifndef COMMON_TRIPLEBUFFER_H_
+#define COMMON_TRIPLEBUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Lock-free exchange of the latest value from one producer thread to one consumer thread.
+ *
+ * The producer fills the write buffer and publishes it, which swaps it with the middle buffer. The consumer fetches
+ * the latest published buffer, which swaps its read buffer with the middle buffer. Both sides thus always own a buffer
+ * exclusively, and access it in place without copying or waiting. Values which are published while the consumer
+ * doesn't fetch are overwritten by newer ones.
+ *
+ * Note that after publishing, the write buffer contains an older value, not the one just published.
+ *
+ * @tparam  T   Buffer type.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in]   initial     Initial value of all buffers, e.g. to allocate them all at once.
+     */
+    explicit TripleBuffer(const T& initial = T())
+        : m_buffers{{initial, initial, initial}}
+        , m_writeIndex(0)
+        , m_middle(1)
+        , m_readIndex(2)
+    {
+    }
+
+    // Prevent implicit copy constructor and assignment operator.
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * Get the buffer to write the next value into. May only be called by the producer.
+     */
+    T& getWriteBuffer()
+    {
+        return m_buffers[m_writeIndex];
+    }
+
+    /**
+     * Publish the write buffer. May only be called by the producer.
+     */
+    void publish()
+    {
+        m_writeIndex = m_middle.exchange(m_writeIndex | c_publishedFlag, std::memory_order_acq_rel) & c_indexMask;
+    }
+
+    /**
+     * Make the latest published value available in the read buffer. May only be called by the consumer.
+     *
+     * @retval  true    A new value was published since the last fetch.
+     * @retval  false   Nothing new was published, the read buffer is unchanged.
+     */
+    bool fetch()
+    {
+        if((m_middle.load(std::memory_order_relaxed) & c_publishedFlag) == 0)
+        {
+            return false;
+        }
+
+        m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & c_indexMask;
+        return true;
+    }
+
+    /**
+     * Get the buffer with the latest fetched value. May only be called by the consumer.
+     */
+    const T& getReadBuffer() const
+    {
+        return m_buffers[m_readIndex];
+    }
+
+private:
+    /** Set in the middle index when it holds a value which was not fetched yet. */
+    static constexpr uint8_t c_publishedFlag = 0x4;
+
+    static constexpr uint8_t c_indexMask = 0x3;
+
+    /** The buffers. */
+    std::array<T, 3> m_buffers;
+
+    /** Index of the buffer owned by the producer. */
+    uint8_t m_writeIndex;
+
+    /** Index of the buffer in between, and whether it was published. */
+    std::atomic<uint8_t> m_middle;
+
+    /** Index of the buffer owned by the consumer. */
+    uint8_t m_readIndex;
+};
+
+#endif /* COMMON_TRIPLEBUFFER_H_ */
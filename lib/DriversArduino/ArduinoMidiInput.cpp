@@ -29,16 +29,23 @@
 #include "ArduinoMidiInput.h"
 
 
-ArduinoMidiInput::ArduinoMidiInput(Stream& serial)
-    : m_serial(serial)
+ArduinoMidiInput::ArduinoMidiInput(Stream& serial, const ITime& time)
+    : BaseMidiInput(time)
+    , m_serial(serial)
 {
 }
 
 void ArduinoMidiInput::run()
 {
-    while(m_serial.available())
+    uint8_t buffer[c_readBufferSize];
+
+    int available;
+    while((available = m_serial.available()) > 0)
     {
-        processMidiByte(static_cast<uint8_t>(m_serial.read()));
+        // Only read what is available, so readBytes() doesn't wait for its timeout
+        std::size_t length(static_cast<std::size_t>(available) < sizeof(buffer) ? available : sizeof(buffer));
+        length = m_serial.readBytes(buffer, length);
+        processMidiBytes(buffer, length);
     }
 }
 
@@ -29,6 +29,8 @@
 
 #include "BaseMidiInput.h"
 
+#include <cstddef>
+
 class Stream;
 
 /**
@@ -42,8 +44,9 @@ public:
      * Constructor.
      *
      * @param serial   The Arduino serial port driver to use.
+     * @param time     Time provider, used to timestamp incoming messages.
      */
-    explicit ArduinoMidiInput(Stream& serial);
+    ArduinoMidiInput(Stream& serial, const ITime& time);
 
     /**
      * Destructor.
@@ -65,6 +68,9 @@ public:
     virtual void openPort(int number);
 
 private:
+    /** Maximum number of bytes read from the serial port at once. */
+    static constexpr std::size_t c_readBufferSize = 32;
+
     Stream& m_serial;
 };
 
@@ -0,0 +1,65 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BaseLedOutput.h"
+
+BaseLedOutput::BaseLedOutput(std::size_t frameSize)
+    : m_frames{{std::vector<uint8_t>(frameSize), std::vector<uint8_t>(frameSize)}}
+    , m_writeIndex(0)
+    , m_transferring(false)
+{
+}
+
+uint8_t* BaseLedOutput::getFrame()
+{
+    return m_frames[m_writeIndex].data();
+}
+
+std::size_t BaseLedOutput::getFrameSize() const
+{
+    return m_frames[m_writeIndex].size();
+}
+
+void BaseLedOutput::show()
+{
+    // The other buffer becomes the one to write into, so its transfer must be done
+    finishTransfer();
+
+    const auto& frame(m_frames[m_writeIndex]);
+    startTransfer(frame.data(), frame.size());
+    m_transferring = true;
+
+    m_writeIndex ^= 1;
+}
+
+void BaseLedOutput::finishTransfer()
+{
+    if(m_transferring)
+    {
+        waitForTransfer();
+        m_transferring = false;
+    }
+}
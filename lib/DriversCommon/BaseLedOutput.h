@@ -0,0 +1,92 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Base class for LED strip outputs.
+ */
+
+#ifndef DRIVERS_BASELEDOUTPUT_H_
+#define DRIVERS_BASELEDOUTPUT_H_
+
+#include <array>
+#include <vector>
+
+#include "ILedOutput.h"
+
+/**
+ * Base class for LED strip outputs, which double-buffers the frames so the next one can be written while the previous
+ * one is being transferred.
+ */
+class BaseLedOutput
+    : public ILedOutput
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in]   frameSize   Size of a frame in bytes.
+     */
+    explicit BaseLedOutput(std::size_t frameSize);
+
+    // Prevent implicit constructors and assignment operator.
+    BaseLedOutput() = delete;
+    BaseLedOutput(const BaseLedOutput&) = delete;
+    BaseLedOutput& operator=(const BaseLedOutput&) = delete;
+
+    // ILedOutput implementation
+    uint8_t* getFrame() override;
+    std::size_t getFrameSize() const override;
+    void show() override;
+
+protected:
+    /**
+     * Start transferring a frame, without waiting for completion.
+     *
+     * @param[in]   frame   The frame. Left untouched until @ref waitForTransfer returned.
+     * @param[in]   size    Size of the frame in bytes.
+     */
+    virtual void startTransfer(const uint8_t* frame, std::size_t size) = 0;
+
+    /**
+     * Wait until the transfer started last has completed.
+     */
+    virtual void waitForTransfer() = 0;
+
+    /**
+     * Wait until the ongoing transfer, if any, has completed. Implementations should call this before destruction.
+     */
+    void finishTransfer();
+
+private:
+    /** The frame buffers. Plain heap memory, which is DMA capable on the ESP32. */
+    std::array<std::vector<uint8_t>, 2> m_frames;
+
+    /** Index of the frame buffer to write into. */
+    unsigned int m_writeIndex;
+
+    /** Whether a transfer was started and not waited for. */
+    bool m_transferring;
+};
+
+#endif /* DRIVERS_BASELEDOUTPUT_H_ */
@@ -25,19 +25,27 @@
  */
 
 #include "BaseMidiInput.h"
+#include "ITime.h"
 
-#include <Logging.h>
-
-#define LOGGING_COMPONENT "BaseMidiInput"
-
-BaseMidiInput::BaseMidiInput()
+BaseMidiInput::BaseMidiInput(const ITime& time)
     : m_observers()
-    , m_buildingMessage(false)
-    , m_currentMessage()
+    , m_time(time)
+    , m_arrivalTime(0)
+    , m_status(c_noStatus)
+    , m_numExpectedDataBytes(0)
+    , m_dataBytes()
+    , m_numDataBytes(0)
+    , m_inSysEx(false)
+    , m_statistics()
     , m_observersMutex()
 {
 }
 
+BaseMidiInput::TStatistics BaseMidiInput::getStatistics() const
+{
+    return m_statistics;
+}
+
 void BaseMidiInput::subscribe(IObserver& observer)
 {
     std::lock_guard<std::mutex> lock(m_observersMutex);
@@ -52,18 +60,14 @@ void BaseMidiInput::unsubscribe(IObserver& observer)
 
 void BaseMidiInput::notifyNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on) const
 {
-    std::lock_guard<std::mutex> lock(m_observersMutex);
-
     for(auto observer : m_observers)
     {
-        observer->onNoteChange(channel, pitch, velocity, on);
+        observer->onTimedNoteChange(channel, pitch, velocity, on, m_arrivalTime);
     }
 }
 
 void BaseMidiInput::notifyControlChange(uint8_t channel, IMidiInterface::TControllerNumber controller, uint8_t value) const
 {
-    std::lock_guard<std::mutex> lock(m_observersMutex);
-
     for(auto observer : m_observers)
     {
         observer->onControlChange(channel, controller, value);
@@ -72,8 +76,6 @@ void BaseMidiInput::notifyControlChange(uint8_t channel, IMidiInterface::TContro
 
 void BaseMidiInput::notifyProgramChange(uint8_t channel, uint8_t program) const
 {
-    std::lock_guard<std::mutex> lock(m_observersMutex);
-
     for(auto observer : m_observers)
     {
         observer->onProgramChange(channel, program);
@@ -82,8 +84,6 @@ void BaseMidiInput::notifyProgramChange(uint8_t channel, uint8_t program) const
 
 void BaseMidiInput::notifyChannelPressureChange(uint8_t channel, uint8_t value) const
 {
-    std::lock_guard<std::mutex> lock(m_observersMutex);
-
     for(auto observer : m_observers)
     {
         observer->onChannelPressureChange(channel, value);
@@ -92,98 +92,223 @@ void BaseMidiInput::notifyChannelPressureChange(uint8_t channel, uint8_t value)
 
 void BaseMidiInput::notifyPitchBendChange(uint8_t channel, uint16_t value) const
 {
-    std::lock_guard<std::mutex> lock(m_observersMutex);
-
     for(auto observer : m_observers)
     {
         observer->onPitchBendChange(channel, value);
     }
 }
 
+uint8_t BaseMidiInput::getNumDataBytes(uint8_t statusByte)
+{
+    // Channel messages, indexed by high nibble minus 8
+    static constexpr uint8_t c_channelMessageLengths[] = {
+        2,  // Note off
+        2,  // Note on
+        2,  // Polyphonic key pressure
+        2,  // Control change
+        1,  // Program change
+        1,  // Channel pressure
+        2,  // Pitch bend change
+    };
+
+    // System common messages, indexed by low nibble. Undefined ones and system exclusive have none.
+    static constexpr uint8_t c_systemCommonMessageLengths[] = {
+        0,  // System exclusive start
+        1,  // MIDI time code quarter frame
+        2,  // Song position pointer
+        1,  // Song select
+        0,  // Undefined
+        0,  // Undefined
+        0,  // Tune request
+        0,  // System exclusive end
+    };
+
+    if(statusByte < c_sysExStart)
+    {
+        return c_channelMessageLengths[(statusByte >> 4) - 8];
+    }
+
+    return c_systemCommonMessageLengths[statusByte & 0x07];
+}
+
 void BaseMidiInput::processMidiByte(uint8_t value)
 {
-    if(!m_buildingMessage && ((value & 0x80) == 0x80))
+    processMidiBytes(&value, 1);
+}
+
+void BaseMidiInput::processMidiBytes(const uint8_t* data, std::size_t length)
+{
+    // Lock once for the whole chunk
+    std::lock_guard<std::mutex> lock(m_observersMutex);
+
+    // The chunk was just taken from the driver, so all of its bytes are considered to arrive now
+    m_arrivalTime = m_time.getMilliseconds();
+
+    for(std::size_t i = 0; i < length; ++i)
     {
-        // Is a status byte. Start building new message
-        m_currentMessage.clear();
-        m_buildingMessage = true;
+        parseByte(data[i]);
     }
+}
 
-    if(m_buildingMessage)
+void BaseMidiInput::processMidiMessage(const uint8_t* message, std::size_t length)
+{
+    if(length == 0)
     {
-        m_currentMessage.push_back(value);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_observersMutex);
 
-        // Get status (high nibble) and channel (low nibble) from status byte
-        uint8_t statusByte(m_currentMessage[0]);
-        uint8_t status(statusByte & 0xF0);
-        uint8_t channel(statusByte & 0x0F);
+    m_arrivalTime = m_time.getMilliseconds();
 
-        // Check if a message can be parsed and sent to subscribers.
-        switch(static_cast<IMidiInterface::TStatus>(status))
+    uint8_t statusByte(message[0]);
+    if(statusByte >= c_firstRealtimeByte)
+    {
+        ++m_statistics.realtimeBytes;
+    }
+    else if(statusByte == c_sysExStart)
+    {
+        ++m_statistics.sysExMessages;
+    }
+    else if(((statusByte & 0x80) == 0) || (statusByte == c_sysExEnd))
+    {
+        ++m_statistics.unexpectedBytes;
+    }
+    else if(length - 1 < getNumDataBytes(statusByte))
+    {
+        ++m_statistics.incompleteMessages;
+    }
+    else
+    {
+        handleMessage(statusByte, length > 1 ? message[1] : 0, length > 2 ? message[2] : 0);
+    }
+}
+
+void BaseMidiInput::parseByte(uint8_t value)
+{
+    if(value >= c_firstRealtimeByte)
+    {
+        // Realtime bytes don't affect the message being received
+        ++m_statistics.realtimeBytes;
+        return;
+    }
+
+    if((value & 0x80) == 0x80)
+    {
+        // Status byte. Any message being received is aborted.
+        if(m_numDataBytes != 0)
         {
-        case NOTE_OFF:
-            if(m_currentMessage.size() >= 3)
-            {
-                // Channel, pitch, velocity, note off
-                notifyNoteChange(channel, m_currentMessage[1], m_currentMessage[2], false);
-                m_buildingMessage = false;
-            }
-            break;
+            ++m_statistics.incompleteMessages;
+            m_numDataBytes = 0;
+        }
 
-        case NOTE_ON:
-            if(m_currentMessage.size() >= 3)
+        if(m_inSysEx)
+        {
+            ++m_statistics.sysExMessages;
+            m_inSysEx = false;
+            if(value == c_sysExEnd)
             {
-                // Channel, pitch, velocity, note on
-                notifyNoteChange(channel, m_currentMessage[1], m_currentMessage[2], true);
-                m_buildingMessage = false;
+                return;
             }
-            break;
+        }
 
-        case CONTROL_CHANGE:
-            if(m_currentMessage.size() >= 3)
+        if(value == c_sysExStart)
+        {
+            m_inSysEx = true;
+            m_status = c_noStatus;
+        }
+        else if(value == c_sysExEnd)
+        {
+            ++m_statistics.unexpectedBytes;
+            m_status = c_noStatus;
+        }
+        else
+        {
+            m_status = value;
+            m_numExpectedDataBytes = getNumDataBytes(value);
+            if(m_numExpectedDataBytes == 0)
             {
-                // Channel, controller number, value
-                notifyControlChange(channel, (IMidiInterface::TControllerNumber)m_currentMessage[1], m_currentMessage[2]);
-                m_buildingMessage = false;
+                handleMessage(m_status, 0, 0);
+                m_status = c_noStatus;
             }
-            break;
+        }
 
-        case PROGRAM_CHANGE:
-            if(m_currentMessage.size() >= 2)
-            {
-                // Channel, number
-                notifyProgramChange(channel, m_currentMessage[1]);
-                m_buildingMessage = false;
-            }
-            break;
+        return;
+    }
 
-        case CHANNEL_PRESSURE_CHANGE:
-            if(m_currentMessage.size() >= 2)
-            {
-                // Channel, value
-                notifyChannelPressureChange(channel, m_currentMessage[1]);
-                m_buildingMessage = false;
-            }
-            break;
+    // Data byte
+    if(m_inSysEx)
+    {
+        return;
+    }
 
-        case PITCH_BEND_CHANGE:
-            if(m_currentMessage.size() >= 3)
-            {
-                // Pitch bend value is a 14-bit value.
-                // The first byte contains the low 7 bits, the second byte the high 7 bits.
-                uint16_t value(m_currentMessage[1] | (m_currentMessage[2] << 7));
+    if(m_status == c_noStatus)
+    {
+        ++m_statistics.unexpectedBytes;
+        return;
+    }
 
-                // Channel, value
-                notifyPitchBendChange(channel, value);
-                m_buildingMessage = false;
-            }
-            break;
+    m_dataBytes[m_numDataBytes++] = value;
+    if(m_numDataBytes == m_numExpectedDataBytes)
+    {
+        handleMessage(m_status, m_dataBytes[0], m_dataBytes[1]);
+        m_numDataBytes = 0;
 
-        default:
-            // Unsupported status.
-            LOG_WARNING_PARAMS("Unsupported MIDI status %#02x on channel %2u, ignoring rest of message.", status, channel);
-            m_buildingMessage = false;
-            break;
+        if(m_status >= c_sysExStart)
+        {
+            // Running status only applies to channel messages
+            m_status = c_noStatus;
         }
     }
 }
+
+void BaseMidiInput::handleMessage(uint8_t statusByte, uint8_t data0, uint8_t data1)
+{
+    // Get status (high nibble) and channel (low nibble) from status byte
+    uint8_t status(statusByte & 0xF0);
+    uint8_t channel(statusByte & 0x0F);
+
+    switch(status)
+    {
+    case NOTE_OFF:
+        // Channel, pitch, velocity, note off
+        notifyNoteChange(channel, data0, data1, false);
+        ++m_statistics.messages;
+        break;
+
+    case NOTE_ON:
+        // Note on with zero velocity is a note off by definition. Often used together with running status.
+        notifyNoteChange(channel, data0, data1, data1 != 0);
+        ++m_statistics.messages;
+        break;
+
+    case CONTROL_CHANGE:
+        // Channel, controller number, value
+        notifyControlChange(channel, static_cast<IMidiInterface::TControllerNumber>(data0), data1);
+        ++m_statistics.messages;
+        break;
+
+    case PROGRAM_CHANGE:
+        // Channel, number
+        notifyProgramChange(channel, data0);
+        ++m_statistics.messages;
+        break;
+
+    case CHANNEL_PRESSURE_CHANGE:
+        // Channel, value
+        notifyChannelPressureChange(channel, data0);
+        ++m_statistics.messages;
+        break;
+
+    case PITCH_BEND_CHANGE:
+        // Pitch bend value is a 14-bit value.
+        // The first byte contains the low 7 bits, the second byte the high 7 bits.
+        notifyPitchBendChange(channel, data0 | (data1 << 7));
+        ++m_statistics.messages;
+        break;
+
+    default:
+        ++m_statistics.unsupportedMessages;
+        break;
+    }
+}
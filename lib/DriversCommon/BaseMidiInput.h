@@ -29,13 +29,16 @@
 #ifndef DRIVERS_COMMON_BASEMIDIINPUT_H_
 #define DRIVERS_COMMON_BASEMIDIINPUT_H_
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <list>
-#include <vector>
 #include <mutex>
 
 #include "IMidiInput.h"
 
+class ITime;
+
 /**
  * Base class for MIDI inputs, implementing message subscription mechanism.
  */
@@ -43,6 +46,23 @@ class BaseMidiInput
     : public IMidiInput
 {
 public:
+    /** Counters for received input. */
+    struct TStatistics
+    {
+        /** Complete messages notified to observers. */
+        uint32_t messages;
+        /** Realtime bytes (0xF8-0xFF), which are skipped. */
+        uint32_t realtimeBytes;
+        /** System exclusive messages, which are skipped. */
+        uint32_t sysExMessages;
+        /** Complete messages which are not supported, and therefore skipped. */
+        uint32_t unsupportedMessages;
+        /** Messages which were interrupted by a new status byte before being complete. */
+        uint32_t incompleteMessages;
+        /** Data bytes without a known status, or stray end of system exclusive bytes. */
+        uint32_t unexpectedBytes;
+    };
+
     /**
      * Destructor.
      */
@@ -56,20 +76,80 @@ public:
     virtual void subscribe(IObserver& observer);
     virtual void unsubscribe(IObserver& observer);
 
+    /**
+     * Get the input counters.
+     *
+     * @note    Counters are updated from the context which processes incoming bytes, without locking.
+     */
+    TStatistics getStatistics() const;
+
 protected:
     /**
      * Constructor.
+     *
+     * @param[in]   time    Reference to a time provider, used to timestamp incoming messages.
      */
-    BaseMidiInput();
+    explicit BaseMidiInput(const ITime& time);
 
     /**
      * Process a single incoming MIDI byte.
+     *
+     * Supports running status. Realtime bytes may appear anywhere, also in between the bytes of another message.
      */
     void processMidiByte(uint8_t value);
 
+    /**
+     * Process a chunk of incoming MIDI bytes, like @ref processMidiByte does for a single byte.
+     *
+     * @param[in]   data    The bytes.
+     * @param[in]   length  Number of bytes.
+     */
+    void processMidiBytes(const uint8_t* data, std::size_t length);
+
+    /**
+     * Process a complete MIDI message, as delivered by drivers which do the framing themselves.
+     *
+     * The message must start with its status byte. It does not affect the state of the byte stream parser.
+     *
+     * @param[in]   message The message bytes.
+     * @param[in]   length  Number of bytes.
+     */
+    void processMidiMessage(const uint8_t* message, std::size_t length);
+
 private:
+    /** Status value meaning no status is known (e.g. at start-up or after system common messages). */
+    static constexpr uint8_t c_noStatus = 0;
+
+    static constexpr uint8_t c_sysExStart = 0xF0;
+    static constexpr uint8_t c_sysExEnd = 0xF7;
+    static constexpr uint8_t c_firstRealtimeByte = 0xF8;
+
+    /** Maximum number of data bytes of supported messages. */
+    static constexpr unsigned int c_maxDataBytes = 2;
+
+    /**
+     * Get the number of data bytes following the given status byte.
+     */
+    static uint8_t getNumDataBytes(uint8_t statusByte);
+
+    /**
+     * Parse one byte of the incoming byte stream. Must be called with the observers mutex held.
+     */
+    void parseByte(uint8_t value);
+
+    /**
+     * Handle a complete message. Must be called with the observers mutex held.
+     *
+     * @param[in]   statusByte  The status byte.
+     * @param[in]   data0       The first data byte, if applicable.
+     * @param[in]   data1       The second data byte, if applicable.
+     */
+    void handleMessage(uint8_t statusByte, uint8_t data0, uint8_t data1);
+
+    // The notify functions must be called with the observers mutex held.
+
     /**
-     * Notify observers about a note change.
+     * Notify observers about a note change, passing the arrival time of the current chunk or message.
      *
      * @param[in]   channel     The channel the message was received on.
      * @param[in]   pitch       The pitch of the note.
@@ -113,11 +193,29 @@ private:
     /** Collection of observers. */
     std::list<IMidiInput::IObserver*> m_observers;
 
-    /** Whether incoming bytes are stored to build a message. */
-    bool m_buildingMessage;
+    /** Reference to the time provider. */
+    const ITime& m_time;
+
+    /** Arrival time of the chunk or message being processed. */
+    uint32_t m_arrivalTime;
+
+    /** Status byte of the message being received. Kept after completion for channel messages (running status). */
+    uint8_t m_status;
+
+    /** Number of data bytes expected for @ref m_status. */
+    uint8_t m_numExpectedDataBytes;
+
+    /** Data bytes of the message being received. */
+    std::array<uint8_t, c_maxDataBytes> m_dataBytes;
+
+    /** Number of valid entries in @ref m_dataBytes. */
+    uint8_t m_numDataBytes;
+
+    /** Whether a system exclusive message is being received. */
+    bool m_inSysEx;
 
-    /** The message currently being built. */
-    std::vector<uint8_t> m_currentMessage;
+    /** Input counters. */
+    TStatistics m_statistics;
 
     /** Mutex to protect the observers. */
     mutable std::mutex m_observersMutex;
@@ -0,0 +1,157 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Benchmarks for BaseMidiInput.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "BaseMidiInput.h"
+#include "ITime.h"
+
+/** Class to get access to the protected parts of the class under test. */
+class BenchmarkMidiInput
+    : public BaseMidiInput
+{
+public:
+    explicit BenchmarkMidiInput(const ITime& time)
+        : BaseMidiInput(time)
+    {
+    }
+
+    using BaseMidiInput::processMidiByte;
+    using BaseMidiInput::processMidiBytes;
+
+    // IMidiInterface implementation
+    unsigned int getPortCount() const override
+    {
+        return 0;
+    }
+
+    void openPort(int number) override
+    {
+    }
+};
+
+/** Time provider which always returns the same time. */
+class BenchmarkTime
+    : public ITime
+{
+public:
+    uint32_t getMilliseconds() const override
+    {
+        return 0;
+    }
+
+    uint64_t getMicroseconds() const override
+    {
+        return 0;
+    }
+};
+
+/** Observer which counts the notes. */
+class CountingObserver
+    : public IMidiInput::IObserver
+{
+public:
+    void onNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on) override
+    {
+        ++numNoteChanges;
+    }
+
+    void onControlChange(uint8_t channel, IMidiInput::TControllerNumber controller, uint8_t value) override
+    {
+    }
+
+    void onProgramChange(uint8_t channel, uint8_t program) override
+    {
+    }
+
+    void onChannelPressureChange(uint8_t channel, uint8_t value) override
+    {
+    }
+
+    void onPitchBendChange(uint8_t channel, uint16_t value) override
+    {
+    }
+
+    unsigned int numNoteChanges = 0;
+};
+
+/** A stream of notes using running status, interleaved with timing clock, like a keyboard sends. */
+static std::vector<uint8_t> createStream()
+{
+    std::vector<uint8_t> stream = {0x90};
+    for(uint8_t note = 21; note <= 108; ++note)
+    {
+        stream.insert(stream.end(), {note, 100, 0xf8, note, 0});
+    }
+    return stream;
+}
+
+static void BaseMidiInputProcessMidiByte(benchmark::State& state)
+{
+    BenchmarkTime time;
+    BenchmarkMidiInput midiInput(time);
+    CountingObserver observer;
+    midiInput.subscribe(observer);
+
+    auto stream(createStream());
+    for(auto _ : state)
+    {
+        for(auto byte : stream)
+        {
+            midiInput.processMidiByte(byte);
+        }
+    }
+    benchmark::DoNotOptimize(observer.numNoteChanges);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+
+    midiInput.unsubscribe(observer);
+}
+BENCHMARK(BaseMidiInputProcessMidiByte);
+
+static void BaseMidiInputProcessMidiBytes(benchmark::State& state)
+{
+    BenchmarkTime time;
+    BenchmarkMidiInput midiInput(time);
+    CountingObserver observer;
+    midiInput.subscribe(observer);
+
+    auto stream(createStream());
+    for(auto _ : state)
+    {
+        midiInput.processMidiBytes(stream.data(), stream.size());
+    }
+    benchmark::DoNotOptimize(observer.numNoteChanges);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+
+    midiInput.unsubscribe(observer);
+}
+BENCHMARK(BaseMidiInputProcessMidiBytes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Interface for LED strip outputs.
+ */
+
+#ifndef DRIVERS_INTERFACES_ILEDOUTPUT_H_
+#define DRIVERS_INTERFACES_ILEDOUTPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Interface for LED strip outputs which send frames in the wire format of the LED chips, asynchronously.
+ */
+class ILedOutput
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~ILedOutput() = default;
+
+    /**
+     * Get the buffer to write the next frame into. It is not in use by an ongoing transfer.
+     *
+     * @return  Buffer of @ref getFrameSize bytes.
+     */
+    virtual uint8_t* getFrame() = 0;
+
+    /**
+     * Get the size of a frame in bytes.
+     */
+    virtual std::size_t getFrameSize() const = 0;
+
+    /**
+     * Start sending the frame, without waiting for the transfer to complete. Afterwards, @ref getFrame may return
+     * another buffer, of which the contents are undefined.
+     */
+    virtual void show() = 0;
+};
+
+#endif /* DRIVERS_INTERFACES_ILEDOUTPUT_H_ */
@@ -53,6 +53,24 @@ public:
          */
         virtual void onNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on) = 0;
 
+        /**
+         * Called when a note on/off message is received, together with the time it arrived at the driver.
+         *
+         * Observers which care about the exact onset of a note override this. By default, the timestamp is
+         * dropped and @ref onNoteChange is called.
+         *
+         * @param channel       Channel number
+         * @param pitch         Pitch (note number)
+         * @param velocity      Velocity
+         * @param on            True = note on, false = note off
+         * @param arrivalTime   Time the message arrived, in milliseconds
+         */
+        virtual void onTimedNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on, uint32_t arrivalTime)
+        {
+            (void)arrivalTime;
+            onNoteChange(channel, pitch, velocity, on);
+        }
+
         /**
          * Called when a control change message is received.
          *
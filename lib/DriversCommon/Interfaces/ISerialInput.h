@@ -0,0 +1,67 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Interface for serial inputs.
+ */
+
+#ifndef DRIVERS_INTERFACES_ISERIALINPUT_H_
+#define DRIVERS_INTERFACES_ISERIALINPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Interface for serial inputs which can block until data arrives.
+ */
+class ISerialInput
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~ISerialInput() = default;
+
+    /**
+     * Wait until received data is available.
+     *
+     * @param[in]   timeoutMs   Maximum time to wait, in milliseconds.
+     *
+     * @retval  true    Data is available.
+     * @retval  false   The timeout expired.
+     */
+    virtual bool waitForData(uint32_t timeoutMs) = 0;
+
+    /**
+     * Read received data, without blocking.
+     *
+     * @param[out]  buffer  The buffer to read into.
+     * @param[in]   length  Maximum number of bytes to read.
+     *
+     * @return  Number of bytes read.
+     */
+    virtual std::size_t read(uint8_t* buffer, std::size_t length) = 0;
+};
+
+#endif /* DRIVERS_INTERFACES_ISERIALINPUT_H_ */
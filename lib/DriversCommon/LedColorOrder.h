@@ -0,0 +1,78 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Color orders of LED chips.
+ */
+
+#ifndef DRIVERS_LEDCOLORORDER_H_
+#define DRIVERS_LEDCOLORORDER_H_
+
+#include <cstdint>
+
+/**
+ * Order in which LED chips expect the color components on the wire.
+ */
+enum TLedColorOrder
+{
+    LedColorOrder_Rgb,
+    LedColorOrder_Grb,
+    LedColorOrder_Bgr
+};
+
+/**
+ * Write a color in wire order.
+ *
+ * @param[out]  destination Where to write the three color components.
+ * @param[in]   order       The color order.
+ * @param[in]   r           Red component.
+ * @param[in]   g           Green component.
+ * @param[in]   b           Blue component.
+ */
+inline void writeColor(uint8_t* destination, TLedColorOrder order, uint8_t r, uint8_t g, uint8_t b)
+{
+    switch(order)
+    {
+    case LedColorOrder_Grb:
+        destination[0] = g;
+        destination[1] = r;
+        destination[2] = b;
+        break;
+
+    case LedColorOrder_Bgr:
+        destination[0] = b;
+        destination[1] = g;
+        destination[2] = r;
+        break;
+
+    case LedColorOrder_Rgb:
+    default:
+        destination[0] = r;
+        destination[1] = g;
+        destination[2] = b;
+        break;
+    }
+}
+
+#endif /* DRIVERS_LEDCOLORORDER_H_ */
@@ -0,0 +1,47 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Mock MIDI input observer.
+ */
+
+#ifndef DRIVERS_MOCK_MOCKMIDIINPUTOBSERVER_H_
+#define DRIVERS_MOCK_MOCKMIDIINPUTOBSERVER_H_
+
+#include <gmock/gmock.h>
+
+#include "../Interfaces/IMidiInput.h"
+
+class MockMidiInputObserver
+    : public IMidiInput::IObserver
+{
+public:
+    MOCK_METHOD4(onNoteChange, void(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on));
+    MOCK_METHOD3(onControlChange, void(uint8_t channel, IMidiInput::TControllerNumber controller, uint8_t value));
+    MOCK_METHOD2(onProgramChange, void(uint8_t channel, uint8_t program));
+    MOCK_METHOD2(onChannelPressureChange, void(uint8_t channel, uint8_t value));
+    MOCK_METHOD2(onPitchBendChange, void(uint8_t channel, uint16_t value));
+};
+
+#endif /* DRIVERS_MOCK_MOCKMIDIINPUTOBSERVER_H_ */
@@ -0,0 +1,44 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Mock serial input.
+ */
+
+#ifndef DRIVERS_MOCK_MOCKSERIALINPUT_H_
+#define DRIVERS_MOCK_MOCKSERIALINPUT_H_
+
+#include <gmock/gmock.h>
+
+#include "../Interfaces/ISerialInput.h"
+
+class MockSerialInput
+    : public ISerialInput
+{
+public:
+    MOCK_METHOD1(waitForData, bool(uint32_t timeoutMs));
+    MOCK_METHOD2(read, std::size_t(uint8_t* buffer, std::size_t length));
+};
+
+#endif /* DRIVERS_MOCK_MOCKSERIALINPUT_H_ */
@@ -0,0 +1,59 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SerialMidiInput.h"
+#include "ISerialInput.h"
+
+SerialMidiInput::SerialMidiInput(ISerialInput& serialInput, const ITime& time)
+    : BaseMidiInput(time)
+    , m_serialInput(serialInput)
+{
+}
+
+void SerialMidiInput::run(uint32_t timeoutMs)
+{
+    if(!m_serialInput.waitForData(timeoutMs))
+    {
+        return;
+    }
+
+    uint8_t buffer[c_readBufferSize];
+    std::size_t length;
+    while((length = m_serialInput.read(buffer, sizeof(buffer))) > 0)
+    {
+        processMidiBytes(buffer, length);
+    }
+}
+
+unsigned int SerialMidiInput::getPortCount() const
+{
+    return 1;
+}
+
+void SerialMidiInput::openPort(int number)
+{
+    // Nothing to do.
+}
@@ -0,0 +1,82 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief MIDI input which reads from a serial input.
+ */
+
+#ifndef DRIVERS_COMMON_SERIALMIDIINPUT_H_
+#define DRIVERS_COMMON_SERIALMIDIINPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BaseMidiInput.h"
+
+class ISerialInput;
+
+/**
+ * MIDI input which reads from a serial input, blocking until data arrives.
+ */
+class SerialMidiInput
+    : public BaseMidiInput
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param serialInput   The serial input to read from.
+     * @param time          Time provider, used to timestamp incoming messages.
+     */
+    SerialMidiInput(ISerialInput& serialInput, const ITime& time);
+
+    /**
+     * Destructor.
+     */
+    ~SerialMidiInput() override = default;
+
+    // Prevent implicit default constructors and assignment operator.
+    SerialMidiInput() = delete;
+    SerialMidiInput(const SerialMidiInput&) = delete;
+    SerialMidiInput& operator=(const SerialMidiInput&) = delete;
+
+    /**
+     * Wait for incoming data, and process all of it.
+     *
+     * @param[in]   timeoutMs   Maximum time to wait for data, in milliseconds.
+     */
+    void run(uint32_t timeoutMs);
+
+    // IMidiInterface implementation
+    unsigned int getPortCount() const override;
+    void openPort(int number) override;
+
+private:
+    /** Maximum number of bytes read from the serial input at once. */
+    static constexpr std::size_t c_readBufferSize = 32;
+
+    ISerialInput& m_serialInput;
+};
+
+#endif /* DRIVERS_COMMON_SERIALMIDIINPUT_H_ */
@@ -0,0 +1,117 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for BaseLedOutput.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "../BaseLedOutput.h"
+
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::SaveArg;
+using ::testing::StrictMock;
+
+class TestableLedOutput
+    : public BaseLedOutput
+{
+public:
+    explicit TestableLedOutput(std::size_t frameSize)
+        : BaseLedOutput(frameSize)
+    {
+    }
+
+    MOCK_METHOD2(startTransfer, void(const uint8_t* frame, std::size_t size));
+    MOCK_METHOD0(waitForTransfer, void());
+
+    using BaseLedOutput::finishTransfer;
+};
+
+class BaseLedOutputTest
+    : public ::testing::Test
+{
+public:
+    static constexpr std::size_t c_frameSize = 12;
+
+    BaseLedOutputTest()
+        : m_output(c_frameSize)
+    {
+    }
+
+    StrictMock<TestableLedOutput> m_output;
+};
+
+constexpr std::size_t BaseLedOutputTest::c_frameSize;
+
+TEST_F(BaseLedOutputTest, frameSize)
+{
+    EXPECT_EQ(c_frameSize, m_output.getFrameSize());
+}
+
+TEST_F(BaseLedOutputTest, firstShowDoesNotWait)
+{
+    EXPECT_CALL(m_output, startTransfer(m_output.getFrame(), c_frameSize));
+
+    m_output.show();
+}
+
+TEST_F(BaseLedOutputTest, framesAlternate)
+{
+    uint8_t* first(m_output.getFrame());
+    const uint8_t* transferred(nullptr);
+    EXPECT_CALL(m_output, startTransfer(_, c_frameSize))
+        .WillOnce(SaveArg<0>(&transferred));
+    m_output.show();
+    EXPECT_EQ(first, transferred);
+
+    // While the first frame is on the wire, the next one is written into another buffer
+    uint8_t* second(m_output.getFrame());
+    EXPECT_NE(first, second);
+
+    {
+        InSequence sequence;
+
+        // The first buffer may only be handed out again after its transfer completed
+        EXPECT_CALL(m_output, waitForTransfer());
+        EXPECT_CALL(m_output, startTransfer(second, c_frameSize));
+    }
+    m_output.show();
+    EXPECT_EQ(first, m_output.getFrame());
+}
+
+TEST_F(BaseLedOutputTest, finishTransfer)
+{
+    EXPECT_CALL(m_output, startTransfer(_, _));
+    m_output.show();
+
+    EXPECT_CALL(m_output, waitForTransfer())
+        .Times(1);
+    m_output.finishTransfer();
+
+    // Nothing to wait for anymore
+    m_output.finishTransfer();
+}
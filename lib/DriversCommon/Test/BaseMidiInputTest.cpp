@@ -0,0 +1,285 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for BaseMidiInput.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "../BaseMidiInput.h"
+#include "../Mock/MockMidiInputObserver.h"
+#include "Mock/MockTime.h"
+
+using ::testing::StrictMock;
+using ::testing::NiceMock;
+using ::testing::InSequence;
+using ::testing::Return;
+
+/** Class to get access to the protected parts of the class under test. */
+class TestMidiInput
+    : public BaseMidiInput
+{
+public:
+    explicit TestMidiInput(const ITime& time)
+        : BaseMidiInput(time)
+    {
+    }
+
+    using BaseMidiInput::processMidiByte;
+    using BaseMidiInput::processMidiBytes;
+    using BaseMidiInput::processMidiMessage;
+
+    // IMidiInterface implementation
+    unsigned int getPortCount() const override
+    {
+        return 0;
+    }
+
+    void openPort(int number) override
+    {
+    }
+};
+
+class BaseMidiInputTest
+    : public ::testing::Test
+{
+public:
+    BaseMidiInputTest()
+        : m_time()
+        , m_midiInput(m_time)
+        , m_observer()
+    {
+        m_midiInput.subscribe(m_observer);
+    }
+
+    ~BaseMidiInputTest() override
+    {
+        m_midiInput.unsubscribe(m_observer);
+    }
+
+    void send(const std::vector<uint8_t>& bytes)
+    {
+        for(auto byte : bytes)
+        {
+            m_midiInput.processMidiByte(byte);
+        }
+    }
+
+    NiceMock<MockTime> m_time;
+    TestMidiInput m_midiInput;
+    StrictMock<MockMidiInputObserver> m_observer;
+};
+
+TEST_F(BaseMidiInputTest, noteOnOff)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onNoteChange(2, 60, 100, true));
+    EXPECT_CALL(m_observer, onNoteChange(2, 60, 10, false));
+
+    send({0x92, 60, 100});
+    send({0x82, 60, 10});
+
+    EXPECT_EQ(2, m_midiInput.getStatistics().messages);
+}
+
+TEST_F(BaseMidiInputTest, noteOnZeroVelocityIsNoteOff)
+{
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 0, false));
+
+    send({0x90, 60, 0});
+}
+
+TEST_F(BaseMidiInputTest, otherMessages)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onControlChange(1, IMidiInterface::DAMPER_PEDAL, 127));
+    EXPECT_CALL(m_observer, onProgramChange(3, 42));
+    EXPECT_CALL(m_observer, onChannelPressureChange(4, 43));
+    EXPECT_CALL(m_observer, onPitchBendChange(5, 0x2001));
+
+    send({0xB1, 0x40, 127});
+    send({0xC3, 42});
+    send({0xD4, 43});
+    send({0xE5, 0x01, 0x40});
+}
+
+TEST_F(BaseMidiInputTest, runningStatus)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+    EXPECT_CALL(m_observer, onNoteChange(0, 64, 90, true));
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 0, false));
+    EXPECT_CALL(m_observer, onProgramChange(0, 1));
+    EXPECT_CALL(m_observer, onProgramChange(0, 2));
+
+    send({0x90, 60, 100, 64, 90, 60, 0});
+    send({0xC0, 1, 2});
+}
+
+TEST_F(BaseMidiInputTest, realtimeInsideMessage)
+{
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+
+    send({0xF8, 0x90, 0xF8, 60, 0xFE, 100, 0xFF});
+
+    EXPECT_EQ(4, m_midiInput.getStatistics().realtimeBytes);
+}
+
+TEST_F(BaseMidiInputTest, sysExSkipped)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+    EXPECT_CALL(m_observer, onNoteChange(0, 61, 100, true));
+
+    send({0xF0, 0x41, 0x10, 0x42, 0x12, 0xF7});
+    // Data without status after system exclusive is not a running status message
+    send({60, 100});
+    send({0x90, 60, 100});
+    // Status byte also terminates system exclusive
+    send({0xF0, 0x7E, 0x90, 61, 100});
+
+    auto statistics(m_midiInput.getStatistics());
+    EXPECT_EQ(2, statistics.sysExMessages);
+    EXPECT_EQ(2, statistics.unexpectedBytes);
+}
+
+TEST_F(BaseMidiInputTest, systemCommonCancelsRunningStatus)
+{
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+
+    // Song select, then data without status
+    send({0x90, 60, 100, 0xF3, 1, 61, 100});
+
+    auto statistics(m_midiInput.getStatistics());
+    EXPECT_EQ(1, statistics.unsupportedMessages);
+    EXPECT_EQ(2, statistics.unexpectedBytes);
+}
+
+TEST_F(BaseMidiInputTest, unsupportedAndIncomplete)
+{
+    EXPECT_CALL(m_observer, onNoteChange(0, 62, 100, true));
+
+    // Polyphonic key pressure is not supported
+    send({0xA0, 60, 10});
+    // Interrupted note on
+    send({0x90, 61, 0x90, 62, 100});
+
+    auto statistics(m_midiInput.getStatistics());
+    EXPECT_EQ(1, statistics.unsupportedMessages);
+    EXPECT_EQ(1, statistics.incompleteMessages);
+    EXPECT_EQ(1, statistics.messages);
+}
+
+TEST_F(BaseMidiInputTest, dataWithoutStatus)
+{
+    send({60, 100});
+
+    EXPECT_EQ(2, m_midiInput.getStatistics().unexpectedBytes);
+}
+
+TEST_F(BaseMidiInputTest, processBytes)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+    EXPECT_CALL(m_observer, onNoteChange(0, 61, 100, true));
+
+    // Message split over chunks
+    const uint8_t chunk1[] = {0x90, 60, 100, 61};
+    const uint8_t chunk2[] = {100};
+    m_midiInput.processMidiBytes(chunk1, sizeof(chunk1));
+    m_midiInput.processMidiBytes(chunk2, sizeof(chunk2));
+}
+
+TEST_F(BaseMidiInputTest, processMessage)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onNoteChange(1, 60, 100, true));
+    EXPECT_CALL(m_observer, onProgramChange(2, 42));
+
+    const uint8_t noteOn[] = {0x91, 60, 100};
+    const uint8_t programChange[] = {0xC2, 42};
+    const uint8_t incomplete[] = {0x91, 60};
+    const uint8_t sysEx[] = {0xF0, 0x7E, 0xF7};
+    m_midiInput.processMidiMessage(noteOn, sizeof(noteOn));
+    m_midiInput.processMidiMessage(programChange, sizeof(programChange));
+    m_midiInput.processMidiMessage(incomplete, sizeof(incomplete));
+    m_midiInput.processMidiMessage(sysEx, sizeof(sysEx));
+
+    auto statistics(m_midiInput.getStatistics());
+    EXPECT_EQ(2, statistics.messages);
+    EXPECT_EQ(1, statistics.incompleteMessages);
+    EXPECT_EQ(1, statistics.sysExMessages);
+}
+
+TEST_F(BaseMidiInputTest, processMessageKeepsStreamState)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_observer, onProgramChange(2, 42));
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+
+    // Framed message in between a streamed message
+    send({0x90, 60});
+    const uint8_t programChange[] = {0xC2, 42};
+    m_midiInput.processMidiMessage(programChange, sizeof(programChange));
+    send({100});
+}
+
+/** Observer which is interested in arrival times. */
+class MockTimedMidiInputObserver
+    : public MockMidiInputObserver
+{
+public:
+    MOCK_METHOD5(onTimedNoteChange, void(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on, uint32_t arrivalTime));
+};
+
+TEST_F(BaseMidiInputTest, arrivalTime)
+{
+    StrictMock<MockTimedMidiInputObserver> timedObserver;
+    m_midiInput.subscribe(timedObserver);
+
+    EXPECT_CALL(m_time, getMilliseconds())
+        .WillOnce(Return(10))
+        .WillOnce(Return(20));
+
+    // Regular observer gets the message without time
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true))
+        .Times(3);
+
+    // Bytes of one chunk share the time at which the chunk was taken from the driver
+    InSequence dummy;
+    EXPECT_CALL(timedObserver, onTimedNoteChange(0, 60, 100, true, 10))
+        .Times(2);
+    EXPECT_CALL(timedObserver, onTimedNoteChange(0, 60, 100, true, 20));
+
+    const uint8_t chunk[] = {0x90, 60, 100, 60, 100};
+    const uint8_t noteOn[] = {0x90, 60, 100};
+    m_midiInput.processMidiBytes(chunk, sizeof(chunk));
+    m_midiInput.processMidiMessage(noteOn, sizeof(noteOn));
+
+    m_midiInput.unsubscribe(timedObserver);
+}
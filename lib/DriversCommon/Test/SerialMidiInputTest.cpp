@@ -0,0 +1,106 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for SerialMidiInput.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../SerialMidiInput.h"
+#include "../Mock/MockSerialInput.h"
+#include "../Mock/MockMidiInputObserver.h"
+#include "Mock/MockTime.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::Invoke;
+using ::testing::StrictMock;
+using ::testing::NiceMock;
+using ::testing::InSequence;
+
+/** Action to let the mock serial input deliver data. */
+ACTION_P(ReadBytes, bytes)
+{
+    std::size_t length(std::min(arg1, bytes.size()));
+    std::copy(bytes.begin(), bytes.begin() + length, arg0);
+    return length;
+}
+
+class SerialMidiInputTest
+    : public ::testing::Test
+{
+public:
+    static constexpr uint32_t c_timeout = 42;
+
+    SerialMidiInputTest()
+        : m_serialInput()
+        , m_time()
+        , m_midiInput(m_serialInput, m_time)
+        , m_observer()
+    {
+        m_midiInput.subscribe(m_observer);
+    }
+
+    ~SerialMidiInputTest() override
+    {
+        m_midiInput.unsubscribe(m_observer);
+    }
+
+    StrictMock<MockSerialInput> m_serialInput;
+    NiceMock<MockTime> m_time;
+    SerialMidiInput m_midiInput;
+    StrictMock<MockMidiInputObserver> m_observer;
+};
+
+constexpr uint32_t SerialMidiInputTest::c_timeout;
+
+TEST_F(SerialMidiInputTest, noDataNoRead)
+{
+    EXPECT_CALL(m_serialInput, waitForData(c_timeout))
+        .WillOnce(Return(false));
+
+    m_midiInput.run(c_timeout);
+}
+
+TEST_F(SerialMidiInputTest, readAllAvailableData)
+{
+    InSequence dummy;
+    EXPECT_CALL(m_serialInput, waitForData(c_timeout))
+        .WillOnce(Return(true));
+    EXPECT_CALL(m_serialInput, read(_, _))
+        .WillOnce(ReadBytes(std::vector<uint8_t>({0x90, 60})));
+    EXPECT_CALL(m_serialInput, read(_, _))
+        .WillOnce(ReadBytes(std::vector<uint8_t>({100, 61, 100})));
+    EXPECT_CALL(m_observer, onNoteChange(0, 60, 100, true));
+    EXPECT_CALL(m_observer, onNoteChange(0, 61, 100, true));
+    EXPECT_CALL(m_serialInput, read(_, _))
+        .WillOnce(Return(0));
+
+    m_midiInput.run(c_timeout);
+}
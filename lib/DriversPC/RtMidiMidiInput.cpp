@@ -30,8 +30,9 @@
 
 #include "RtMidiMidiInput.h"
 
-RtMidiMidiInput::RtMidiMidiInput()
-    : m_rtMidiIn(new RtMidiIn())
+RtMidiMidiInput::RtMidiMidiInput(const ITime& time)
+    : BaseMidiInput(time)
+    , m_rtMidiIn(new RtMidiIn())
 {
     assert(m_rtMidiIn != nullptr);
     m_rtMidiIn->setCallback(&RtMidiCommonCallback, (void*)this);
@@ -64,8 +65,6 @@ void RtMidiMidiInput::RtMidiCommonCallback(double deltatime, std::vector<unsigne
 
 void RtMidiMidiInput::RtMidiCallback(double deltatime, std::vector<unsigned char> *message)
 {
-    for(auto byte : *message)
-    {
-        processMidiByte(byte);
-    }
+    // RtMidi delivers complete messages
+    processMidiMessage(message->data(), message->size());
 }
@@ -42,8 +42,10 @@ class RtMidiMidiInput
 public:
     /**
      * Constructor.
+     *
+     * @param time  Time provider, used to timestamp incoming messages.
      */
-    RtMidiMidiInput();
+    explicit RtMidiMidiInput(const ITime& time);
 
     /**
      * Destructor.
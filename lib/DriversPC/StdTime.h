@@ -0,0 +1,52 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DRIVERSPC_STDTIME_H_
+#define DRIVERSPC_STDTIME_H_
+
+#include <chrono>
+
+#include "ITime.h"
+
+/**
+ * Time provider based on the standard library steady clock.
+ */
+class StdTime : public ITime
+{
+public:
+    StdTime();
+    ~StdTime() override = default;
+
+    // ITime implementation
+    uint32_t getMilliseconds() const override;
+    uint64_t getMicroseconds() const override;
+
+private:
+    /** Time of construction, which is the epoch of this time provider. */
+    const std::chrono::steady_clock::time_point m_start;
+};
+
+#endif /* DRIVERSPC_STDTIME_H_ */
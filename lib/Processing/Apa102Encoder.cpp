@@ -0,0 +1,67 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "Apa102Encoder.h"
+
+constexpr uint8_t Apa102Encoder::c_maxGlobalBrightness;
+constexpr std::size_t Apa102Encoder::c_startFrameSize;
+constexpr std::size_t Apa102Encoder::c_resetFrameSize;
+
+Apa102Encoder::Apa102Encoder(uint8_t globalBrightness, TLedColorOrder colorOrder)
+    : m_ledHeader(0xe0 | (globalBrightness & c_maxGlobalBrightness))
+    , m_colorOrder(colorOrder)
+{
+}
+
+std::size_t Apa102Encoder::getFrameSize(std::size_t numLeds) const
+{
+    return c_startFrameSize + 4 * numLeds + c_resetFrameSize + getEndFrameSize(numLeds);
+}
+
+void Apa102Encoder::encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const
+{
+    std::memset(frame, 0, c_startFrameSize);
+    frame += c_startFrameSize;
+
+    for(std::size_t led = 0; led < numLeds; ++led)
+    {
+        const Processing::TRgb color(led < strip.size() ? strip[led] : Processing::TRgb());
+        frame[0] = m_ledHeader;
+        writeColor(&frame[1], m_colorOrder, color.r, color.g, color.b);
+        frame += 4;
+    }
+
+    // Data on the extra clocks doesn't matter, every LED only passes it on
+    std::memset(frame, 0, c_resetFrameSize + getEndFrameSize(numLeds));
+}
+
+std::size_t Apa102Encoder::getEndFrameSize(std::size_t numLeds)
+{
+    // Every LED delays the data by half a clock
+    return (numLeds + 15) / 16;
+}
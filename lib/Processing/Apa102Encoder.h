@@ -0,0 +1,78 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Encoder for APA102 and SK9822 LED chips.
+ */
+
+#ifndef PROCESSING_APA102ENCODER_H_
+#define PROCESSING_APA102ENCODER_H_
+
+#include "ILedEncoder.h"
+#include "LedColorOrder.h"
+
+/**
+ * Encoder for APA102 and SK9822 LED chips, which are clocked and take 4 bytes per LED, including a 5 bit global
+ * brightness. These can be clocked much faster than WS2801 chips.
+ *
+ * The frame starts with 32 zero bits. Every LED then takes 3 one bits, the global brightness and the colors. The frame
+ * ends with 32 zero bits, which SK9822 chips need to latch, and half a clock per LED to shift the data through the
+ * whole strip.
+ */
+class Apa102Encoder
+    : public ILedEncoder
+{
+public:
+    /** Maximum global brightness. */
+    static constexpr uint8_t c_maxGlobalBrightness = 0x1f;
+
+    /**
+     * Constructor.
+     *
+     * @param[in]   globalBrightness    Global brightness of all LEDs, up to @ref c_maxGlobalBrightness. Lower values
+     *                                  reduce current without losing color resolution, but make the LEDs flicker at
+     *                                  a lower rate on APA102 chips.
+     * @param[in]   colorOrder          Color order of the LEDs. BGR for most strips.
+     */
+    explicit Apa102Encoder(uint8_t globalBrightness = c_maxGlobalBrightness,
+                           TLedColorOrder colorOrder = LedColorOrder_Bgr);
+
+    // ILedEncoder implementation
+    std::size_t getFrameSize(std::size_t numLeds) const override;
+    void encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const override;
+
+private:
+    static constexpr std::size_t c_startFrameSize = 4;
+    static constexpr std::size_t c_resetFrameSize = 4;
+
+    /**
+     * Get the number of bytes needed to clock the data through the strip, after the reset frame.
+     */
+    static std::size_t getEndFrameSize(std::size_t numLeds);
+
+    uint8_t m_ledHeader;
+    TLedColorOrder m_colorOrder;
+};
+
+#endif /* PROCESSING_APA102ENCODER_H_ */
@@ -0,0 +1,396 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Benchmarks for NoteRgbSource and ProcessingChain execution.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "Blend.h"
+#include "ColorCorrection.h"
+#include "Concert.h"
+#include "EqualRangeRgbSource.h"
+#include "IMidiInput.h"
+#include "IPatch.h"
+#include "ITime.h"
+#include "NoteRgbSource.h"
+#include "PianoDecayRgbFunction.h"
+#include "PowerLimiter.h"
+#include "ProcessingBlockFactory.h"
+#include "ProcessingChain.h"
+#include "RgbFunctionFactory.h"
+#include "ThreadParallelExecutor.h"
+
+/** MIDI input which does nothing. Notes are sent to the observers directly. */
+class BenchmarkMidiInput
+    : public IMidiInput
+{
+public:
+    unsigned int getPortCount() const override
+    {
+        return 0;
+    }
+
+    void openPort(int number) override
+    {
+    }
+
+    void subscribe(IObserver& observer) override
+    {
+    }
+
+    void unsubscribe(IObserver& observer) override
+    {
+    }
+};
+
+/** Time provider which is advanced explicitly. */
+class BenchmarkTime
+    : public ITime
+{
+public:
+    uint32_t getMilliseconds() const override
+    {
+        return m_milliseconds;
+    }
+
+    uint64_t getMicroseconds() const override
+    {
+        return static_cast<uint64_t>(m_milliseconds) * 1000;
+    }
+
+    /** Advance to the next frame, cycling through the first second so notes never fade out completely. */
+    void nextFrame()
+    {
+        m_milliseconds = (m_milliseconds + 10) % 1000;
+    }
+
+private:
+    uint32_t m_milliseconds = 0;
+};
+
+/** Number of keys of a piano. */
+static constexpr unsigned int c_numKeys = 88;
+
+/** Note number of the lowest key of a piano. */
+static constexpr uint8_t c_lowestKey = 21;
+
+/** Map the keys of a piano evenly onto a strip. */
+static Processing::TNoteToLightTable createNoteToLightTable(unsigned int stripSize)
+{
+    Processing::TNoteToLightMap map;
+    for(unsigned int key = 0; key < c_numKeys; ++key)
+    {
+        map[c_lowestKey + key] = static_cast<uint16_t>(key * stripSize / c_numKeys);
+    }
+    return Processing::TNoteToLightTable(map);
+}
+
+/** Arguments: polyphony, strip size. */
+static void noteRgbSourceArguments(benchmark::internal::Benchmark* benchmark)
+{
+    for(int polyphony : {1, 10, 40, 88})
+    {
+        for(int stripSize : {24, 88, 300, 1000})
+        {
+            benchmark->Args({polyphony, stripSize});
+        }
+    }
+}
+
+static void NoteRgbSourceExecute(benchmark::State& state)
+{
+    const unsigned int polyphony(state.range(0));
+    const unsigned int stripSize(state.range(1));
+
+    BenchmarkMidiInput midiInput;
+    RgbFunctionFactory rgbFunctionFactory;
+    BenchmarkTime time;
+    NoteRgbSource source(midiInput, rgbFunctionFactory, time);
+    source.setRgbFunction(new PianoDecayRgbFunction);
+    source.activate();
+
+    for(unsigned int i = 0; i < polyphony; ++i)
+    {
+        source.onNoteChange(0, c_lowestKey + i * c_numKeys / polyphony, 100, true);
+    }
+
+    auto noteToLightTable(createNoteToLightTable(stripSize));
+    Processing::TRgbStrip strip(stripSize);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(source.execute(strip, noteToLightTable));
+        time.nextFrame();
+    }
+    state.SetItemsProcessed(state.iterations() * polyphony);
+}
+BENCHMARK(NoteRgbSourceExecute)->Apply(noteRgbSourceArguments);
+
+/** Arguments: chain depth, strip size, compiled. */
+static void processingChainArguments(benchmark::internal::Benchmark* benchmark)
+{
+    for(int depth : {1, 4, 16, 64})
+    {
+        for(int stripSize : {88, 300})
+        {
+            for(int compiled : {0, 1})
+            {
+                benchmark->Args({depth, stripSize, compiled});
+            }
+        }
+    }
+}
+
+static void ProcessingChainExecute(benchmark::State& state)
+{
+    const unsigned int depth(state.range(0));
+    const unsigned int stripSize(state.range(1));
+
+    BenchmarkMidiInput midiInput;
+    RgbFunctionFactory rgbFunctionFactory;
+    BenchmarkTime time;
+    ProcessingBlockFactory processingBlockFactory(midiInput, rgbFunctionFactory, time);
+    const bool compiled(state.range(2) != 0);
+
+    // Every level nests the next one, so each level adds a chain and a source
+    ProcessingChain chain(processingBlockFactory);
+    ProcessingChain* level(&chain);
+    for(unsigned int i = 0; i < depth; ++i)
+    {
+        auto source(new EqualRangeRgbSource);
+        source->setColor(Processing::TRgb(i, 0, 255 - i));
+        level->insertBlock(source);
+        if(i + 1 < depth)
+        {
+            auto nested(new ProcessingChain(processingBlockFactory));
+            level->insertBlock(nested);
+            level = nested;
+        }
+    }
+    chain.setCompiled(compiled);
+    chain.activate();
+
+    auto noteToLightTable(createNoteToLightTable(stripSize));
+    Processing::TRgbStrip strip(stripSize);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(chain.execute(strip, noteToLightTable));
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+BENCHMARK(ProcessingChainExecute)->Apply(processingChainArguments);
+
+/** Arguments: strip size, parallel. */
+static void ParallelRenderExecute(benchmark::State& state)
+{
+    const unsigned int stripSize(state.range(0));
+    const bool parallel(state.range(1) != 0);
+
+    BenchmarkMidiInput midiInput;
+    RgbFunctionFactory rgbFunctionFactory;
+    BenchmarkTime time;
+    ProcessingBlockFactory processingBlockFactory(midiInput, rgbFunctionFactory, time);
+    ThreadParallelExecutor executor;
+
+    // Background with all keys sounding, the worst case for the note source
+    ProcessingChain chain(processingBlockFactory);
+    auto background(new EqualRangeRgbSource);
+    background->setColor({0, 0, 32});
+    chain.insertBlock(background);
+    auto source(new NoteRgbSource(midiInput, rgbFunctionFactory, time));
+    source->setRgbFunction(new PianoDecayRgbFunction);
+    chain.insertBlock(source);
+    chain.setCompiled(true);
+    chain.setParallelExecutor(parallel ? &executor : nullptr);
+    chain.activate();
+
+    for(unsigned int key = 0; key < c_numKeys; ++key)
+    {
+        source->onNoteChange(0, c_lowestKey + key, 100, true);
+    }
+
+    auto noteToLightTable(createNoteToLightTable(stripSize));
+    Processing::TRgbStrip strip(stripSize);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(chain.execute(strip, noteToLightTable));
+        time.nextFrame();
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+}
+BENCHMARK(ParallelRenderExecute)->Args({88, 0})->Args({88, 1})->Args({250, 0})->Args({250, 1});
+
+/** Arguments: blend mode, strip size. */
+static void blendFillArguments(benchmark::internal::Benchmark* benchmark)
+{
+    for(int mode = Processing::BlendReplace; mode <= Processing::BlendAlpha; ++mode)
+    {
+        for(int stripSize : {88, 300})
+        {
+            benchmark->Args({mode, stripSize});
+        }
+    }
+}
+
+static void BlendFill(benchmark::State& state)
+{
+    const Processing::TBlend blend({static_cast<Processing::TBlendMode>(state.range(0)), 128});
+    const unsigned int stripSize(state.range(1));
+
+    Processing::TRgbStrip strip(stripSize);
+    for(unsigned int i = 0; i < stripSize; ++i)
+    {
+        strip[i] = Processing::TRgb(i, 2 * i, 3 * i);
+    }
+    for(auto _ : state)
+    {
+        Processing::blendFill(strip.data(), strip.size(), Processing::TRgb(1, 2, 3), blend);
+        benchmark::DoNotOptimize(strip.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+    state.SetLabel(Processing::getBlendModeName(blend.mode));
+}
+BENCHMARK(BlendFill)->Apply(blendFillArguments);
+
+/** Reference for @ref BlendFill: adding with the color operator for every light. */
+static void BlendFillPerLight(benchmark::State& state)
+{
+    const unsigned int stripSize(state.range(0));
+
+    Processing::TRgbStrip strip(stripSize);
+    for(unsigned int i = 0; i < stripSize; ++i)
+    {
+        strip[i] = Processing::TRgb(i, 2 * i, 3 * i);
+    }
+    for(auto _ : state)
+    {
+        for(auto& light : strip)
+        {
+            light += Processing::TRgb(1, 2, 3);
+        }
+        benchmark::DoNotOptimize(strip.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+}
+BENCHMARK(BlendFillPerLight)->Arg(88)->Arg(300);
+
+static void ColorCorrectionApply(benchmark::State& state)
+{
+    const unsigned int stripSize(state.range(0));
+
+    ColorCorrection colorCorrection;
+    colorCorrection.setGamma(2.2f, 2.2f, 2.2f);
+    colorCorrection.setWhitePoint(Processing::TRgb(255, 200, 150));
+
+    Processing::TRgbStrip input(stripSize), output(stripSize);
+    for(unsigned int i = 0; i < stripSize; ++i)
+    {
+        input[i] = Processing::TRgb(i, 2 * i, 3 * i);
+    }
+    for(auto _ : state)
+    {
+        colorCorrection.apply(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+}
+BENCHMARK(ColorCorrectionApply)->Arg(88)->Arg(300);
+
+static void ColorCorrectionApplyHighPrecision(benchmark::State& state)
+{
+    const unsigned int stripSize(state.range(0));
+
+    ColorCorrection colorCorrection;
+    colorCorrection.setGamma(2.2f, 2.2f, 2.2f);
+    colorCorrection.setWhitePoint(Processing::TRgb(255, 200, 150));
+
+    Processing::TRgbStrip16 input(stripSize), strip(stripSize);
+    for(unsigned int i = 0; i < stripSize; ++i)
+    {
+        input[i] = Processing::TRgb16(200 * i, 150 * i, 100 * i);
+    }
+    for(auto _ : state)
+    {
+        // Corrected in place, so start from the same input every time
+        strip = input;
+        colorCorrection.apply(strip);
+        benchmark::DoNotOptimize(strip.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+}
+BENCHMARK(ColorCorrectionApplyHighPrecision)->Arg(88)->Arg(300);
+
+static void PowerLimiterLimit(benchmark::State& state)
+{
+    const unsigned int stripSize(state.range(0));
+
+    // Budget for half of the strip at full white, so every frame is scaled
+    PowerLimiter powerLimiter;
+    powerLimiter.setModel(20, 20, 20, 1);
+    powerLimiter.setBudget(stripSize * 30);
+
+    const Processing::TRgbStrip input(stripSize, Processing::TRgb(255, 255, 255));
+    Processing::TRgbStrip strip(stripSize);
+    for(auto _ : state)
+    {
+        strip = input;
+        powerLimiter.limit(strip);
+        benchmark::DoNotOptimize(strip.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stripSize);
+}
+BENCHMARK(PowerLimiterLimit)->Arg(88)->Arg(300);
+
+/** Arguments: number of patches. */
+static void ConcertProgramChange(benchmark::State& state)
+{
+    const unsigned int numPatches(state.range(0));
+
+    BenchmarkMidiInput midiInput;
+    RgbFunctionFactory rgbFunctionFactory;
+    BenchmarkTime time;
+    ProcessingBlockFactory processingBlockFactory(midiInput, rgbFunctionFactory, time);
+    Concert concert(midiInput, processingBlockFactory, time);
+    for(unsigned int i = 0; i < numPatches; ++i)
+    {
+        IPatch* patch(concert.getPatch(concert.addPatch()));
+        patch->setBank(i / 128);
+        patch->setProgram(i % 128);
+    }
+    concert.setListeningToProgramChange(true);
+
+    uint8_t program(0);
+    for(auto _ : state)
+    {
+        // Cycle through the programs of the first bank, the change is handled during execution
+        concert.onProgramChange(0, program);
+        concert.execute();
+        program = (program + 1) % 128;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ConcertProgramChange)->Arg(10)->Arg(300);
+
+BENCHMARK_MAIN();
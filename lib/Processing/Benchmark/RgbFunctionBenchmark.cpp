@@ -0,0 +1,98 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Benchmarks for the RGB functions.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "LinearRgbFunction.h"
+#include "PianoDecayRgbFunction.h"
+
+/** Note states of a full piano keyboard, with all notes sounding and pressed at different times. */
+static std::vector<Processing::TNoteState> createNoteStates()
+{
+    std::vector<Processing::TNoteState> noteStates(88);
+    for(unsigned int i = 0; i < noteStates.size(); ++i)
+    {
+        noteStates[i] = {true, true, static_cast<uint8_t>(1 + i), 100 * i};
+    }
+    return noteStates;
+}
+
+template<class TRgbFunction>
+static void calculate(benchmark::State& state)
+{
+    TRgbFunction function;
+    function.setRedConstants({2, 0});
+    function.setGreenConstants({1, 10});
+    function.setBlueConstants({0.5f, 0});
+
+    auto noteStates(createNoteStates());
+    Processing::TTime time(0);
+    for(auto _ : state)
+    {
+        for(const auto& noteState : noteStates)
+        {
+            benchmark::DoNotOptimize(function.calculate(noteState, time));
+        }
+        time = (time + 10) % 20000;
+    }
+    state.SetItemsProcessed(state.iterations() * noteStates.size());
+}
+BENCHMARK_TEMPLATE(calculate, LinearRgbFunction);
+BENCHMARK_TEMPLATE(calculate, PianoDecayRgbFunction);
+
+template<class TRgbFunction>
+static void calculateAll(benchmark::State& state)
+{
+    TRgbFunction function;
+    function.setRedConstants({2, 0});
+    function.setGreenConstants({1, 10});
+    function.setBlueConstants({0.5f, 0});
+
+    auto noteStates(createNoteStates());
+    std::vector<Processing::TNoteToLight> mappings;
+    for(uint8_t i = 0; i < noteStates.size(); ++i)
+    {
+        mappings.push_back({i, i});
+    }
+
+    Processing::TRgbStrip strip(noteStates.size());
+    Processing::TTime time(0);
+    for(auto _ : state)
+    {
+        function.calculateAll(noteStates.data(), noteStates.size(), mappings.data(), mappings.size(), strip, time);
+        benchmark::DoNotOptimize(strip.data());
+        time = (time + 10) % 20000;
+    }
+    state.SetItemsProcessed(state.iterations() * mappings.size());
+}
+BENCHMARK_TEMPLATE(calculateAll, LinearRgbFunction);
+BENCHMARK_TEMPLATE(calculateAll, PianoDecayRgbFunction);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Benchmarks for TRgb arithmetic.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "ProcessingTypes.h"
+
+/** Colors which don't saturate when added, and don't underflow when the second half is subtracted. */
+static std::vector<Processing::TRgb> createColors()
+{
+    std::vector<Processing::TRgb> colors;
+    for(unsigned int i = 0; i < 88; ++i)
+    {
+        colors.push_back(Processing::TRgb(i, 2 * i, 255 - i));
+    }
+    return colors;
+}
+
+static void TRgbAdd(benchmark::State& state)
+{
+    auto colors(createColors());
+    Processing::TRgb sum;
+    for(auto _ : state)
+    {
+        for(const auto& color : colors)
+        {
+            sum += color;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * colors.size());
+}
+BENCHMARK(TRgbAdd);
+
+static void TRgbSubtract(benchmark::State& state)
+{
+    auto colors(createColors());
+    Processing::TRgb difference(255, 255, 255);
+    for(auto _ : state)
+    {
+        for(const auto& color : colors)
+        {
+            difference -= color;
+        }
+        benchmark::DoNotOptimize(difference);
+    }
+    state.SetItemsProcessed(state.iterations() * colors.size());
+}
+BENCHMARK(TRgbSubtract);
+
+static void TRgbMultiply(benchmark::State& state)
+{
+    auto colors(createColors());
+    float factor(0.5f);
+    for(auto _ : state)
+    {
+        for(auto& color : colors)
+        {
+            benchmark::DoNotOptimize(color * factor);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * colors.size());
+}
+BENCHMARK(TRgbMultiply);
+
+static void RgbFromFloat(benchmark::State& state)
+{
+    float value(0.0f);
+    for(auto _ : state)
+    {
+        // Covers both the clamped and the in-range cases
+        benchmark::DoNotOptimize(Processing::rgbFromFloat(value, value - 100.0f, value + 100.0f));
+        value = (value > 300.0f) ? -50.0f : value + 1.5f;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(RgbFromFloat);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,325 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "Blend.h"
+#include "Json11Helper.h"
+#include "Logging.h"
+
+#define LOGGING_COMPONENT "Blend"
+
+namespace Processing
+{
+
+namespace
+{
+
+constexpr const char* c_blendModeJsonKey = "blendMode";
+constexpr const char* c_alphaJsonKey = "alpha";
+
+/** Names of the blend modes, in order of @ref TBlendMode. */
+constexpr const char* c_blendModeNames[] = {"replace", "add", "max", "multiply", "alpha"};
+
+/** Full intensity of a high precision component. */
+constexpr uint32_t c_full16 = 0xff00;
+
+/** Upper bit of every byte in a word. */
+constexpr uint32_t c_highBits = 0x80808080;
+
+/**
+ * Multiply two components where 255 is 1, with rounding.
+ */
+inline uint8_t multiply8(uint8_t a, uint8_t b)
+{
+    uint16_t product(a * b + 128);
+    return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+}
+
+inline uint8_t blendComponent(uint8_t destination, uint8_t source, TBlend blend)
+{
+    switch(blend.mode)
+    {
+        case BlendAdd:
+            return static_cast<uint8_t>(std::min<unsigned int>(destination + source, UINT8_MAX));
+
+        case BlendMax:
+            return std::max(destination, source);
+
+        case BlendMultiply:
+            return multiply8(destination, source);
+
+        case BlendAlpha:
+            // Can't overflow, as both terms are rounded from parts of the same whole
+            return multiply8(source, blend.alpha) + multiply8(destination, UINT8_MAX - blend.alpha);
+
+        case BlendReplace:
+        default:
+            return source;
+    }
+}
+
+inline uint16_t blendComponent(uint16_t destination, uint16_t source, TBlend blend)
+{
+    switch(blend.mode)
+    {
+        case BlendAdd:
+            return static_cast<uint16_t>(std::min<uint32_t>(static_cast<uint32_t>(destination) + source, UINT16_MAX));
+
+        case BlendMax:
+            return std::max(destination, source);
+
+        case BlendMultiply:
+            return static_cast<uint16_t>(std::min<uint32_t>(static_cast<uint32_t>(destination) * source / c_full16,
+                                                            UINT16_MAX));
+
+        case BlendAlpha:
+            return static_cast<uint16_t>((static_cast<uint32_t>(source) * blend.alpha +
+                                          static_cast<uint32_t>(destination) * (UINT8_MAX - blend.alpha) +
+                                          UINT8_MAX / 2) / UINT8_MAX);
+
+        case BlendReplace:
+        default:
+            return source;
+    }
+}
+
+/** Saturating add of the four bytes of a word at once. */
+struct TAddOperation
+{
+    uint8_t operator()(uint8_t a, uint8_t b) const
+    {
+        return static_cast<uint8_t>(std::min<unsigned int>(a + b, UINT8_MAX));
+    }
+
+    uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        // Add the lower 7 bits, so carries stay within the bytes, then fix the upper bits
+        uint32_t sum((a & ~c_highBits) + (b & ~c_highBits));
+        uint32_t upper((a ^ b) & c_highBits);
+        uint32_t overflow(((a & b) | (upper & sum)) & c_highBits);
+
+        // Saturate the bytes which overflowed
+        return (sum ^ upper) | ((overflow >> 7) * UINT8_MAX);
+    }
+};
+
+/** Maximum of the four bytes of a word at once. */
+struct TMaxOperation
+{
+    uint8_t operator()(uint8_t a, uint8_t b) const
+    {
+        return std::max(a, b);
+    }
+
+    uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        // Subtract per byte without borrowing across bytes, then find the bytes which would borrow, i.e. a < b
+        uint32_t difference(((a | c_highBits) - (b & ~c_highBits)) ^ ((a ^ ~b) & c_highBits));
+        uint32_t borrow(((~a & b) | (~(a ^ b) & difference)) & c_highBits);
+        uint32_t selectB((borrow >> 7) * UINT8_MAX);
+
+        return (a & ~selectB) | (b & selectB);
+    }
+};
+
+/**
+ * Apply an operation to a range of lights and a single color, on four bytes at once where possible.
+ */
+template<typename TOperation>
+void blendFillWords(TRgb* lights, std::size_t count, TRgb color, TOperation operation)
+{
+    static_assert(sizeof(TRgb) == 3, "lights must be packed");
+
+    std::size_t light(0);
+    auto blendLight([&](TRgb& destination) {
+        destination.r = operation(destination.r, color.r);
+        destination.g = operation(destination.g, color.g);
+        destination.b = operation(destination.b, color.b);
+    });
+
+    // Lights are 3 bytes, so at most 3 of them are needed to get aligned for word access
+    while((light < count) && ((reinterpret_cast<uintptr_t>(&lights[light]) % sizeof(uint32_t)) != 0))
+    {
+        blendLight(lights[light]);
+        ++light;
+    }
+
+    // 4 lights fit in 3 words, so the color repeats every 3 words
+    const uint8_t pattern[] = {color.r, color.g, color.b, color.r, color.g, color.b,
+                               color.r, color.g, color.b, color.r, color.g, color.b};
+    uint32_t patternWords[3];
+    std::memcpy(patternWords, pattern, sizeof(patternWords));
+
+    uint8_t* bytes(static_cast<uint8_t*>(__builtin_assume_aligned(&lights[light], sizeof(uint32_t))));
+    for(; light + 4 <= count; light += 4)
+    {
+        for(unsigned int i = 0; i < 3; ++i)
+        {
+            // Copies compile to single aligned loads and stores, without violating strict aliasing
+            uint32_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            word = operation(word, patternWords[i]);
+            std::memcpy(bytes, &word, sizeof(word));
+            bytes += sizeof(word);
+        }
+    }
+
+    for(; light < count; ++light)
+    {
+        blendLight(lights[light]);
+    }
+}
+
+} /* namespace */
+
+bool TBlend::operator==(const TBlend& other) const
+{
+    return (mode == other.mode) && (alpha == other.alpha);
+}
+
+bool TBlend::operator!=(const TBlend& other) const
+{
+    return !(other == *this);
+}
+
+const char* getBlendModeName(TBlendMode mode)
+{
+    if(mode < (sizeof(c_blendModeNames) / sizeof(c_blendModeNames[0])))
+    {
+        return c_blendModeNames[mode];
+    }
+
+    return c_blendModeNames[BlendReplace];
+}
+
+bool getBlendModeFromName(const std::string& name, TBlendMode& mode)
+{
+    for(unsigned int i = 0; i < (sizeof(c_blendModeNames) / sizeof(c_blendModeNames[0])); ++i)
+    {
+        if(name == c_blendModeNames[i])
+        {
+            mode = static_cast<TBlendMode>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void addBlendToJson(const TBlend& blend, Json::object& json)
+{
+    json[c_blendModeJsonKey] = getBlendModeName(blend.mode);
+    json[c_alphaJsonKey] = blend.alpha;
+}
+
+void getBlendFromJson(const Json& json, TBlend& blend)
+{
+    // Optional, blocks keep their default behavior
+    Json11Helper helper(__PRETTY_FUNCTION__, json, false /* logMissingKeys */);
+
+    std::string name;
+    if(helper.getItemIfPresent(c_blendModeJsonKey, name) && !getBlendModeFromName(name, blend.mode))
+    {
+        LOG_WARNING_PARAMS("ignoring unknown blend mode '%s'", name.c_str());
+    }
+    helper.getItemIfPresent(c_alphaJsonKey, blend.alpha);
+}
+
+TRgb blendColor(TRgb destination, TRgb source, TBlend blend)
+{
+    return TRgb(blendComponent(destination.r, source.r, blend),
+                blendComponent(destination.g, source.g, blend),
+                blendComponent(destination.b, source.b, blend));
+}
+
+TRgb16 blendColor(TRgb16 destination, TRgb16 source, TBlend blend)
+{
+    return TRgb16(blendComponent(destination.r, source.r, blend),
+                  blendComponent(destination.g, source.g, blend),
+                  blendComponent(destination.b, source.b, blend));
+}
+
+void blendFill(TRgb* lights, std::size_t count, TRgb color, TBlend blend)
+{
+    switch(blend.mode)
+    {
+        case BlendAdd:
+            blendFillWords(lights, count, color, TAddOperation());
+            break;
+
+        case BlendMax:
+            blendFillWords(lights, count, color, TMaxOperation());
+            break;
+
+        case BlendMultiply:
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                lights[i].r = multiply8(lights[i].r, color.r);
+                lights[i].g = multiply8(lights[i].g, color.g);
+                lights[i].b = multiply8(lights[i].b, color.b);
+            }
+            break;
+
+        case BlendAlpha:
+        {
+            // The contribution of the color is the same for every light
+            const TRgb source(multiply8(color.r, blend.alpha),
+                              multiply8(color.g, blend.alpha),
+                              multiply8(color.b, blend.alpha));
+            const uint8_t remainder(UINT8_MAX - blend.alpha);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                lights[i].r = source.r + multiply8(lights[i].r, remainder);
+                lights[i].g = source.g + multiply8(lights[i].g, remainder);
+                lights[i].b = source.b + multiply8(lights[i].b, remainder);
+            }
+            break;
+        }
+
+        case BlendReplace:
+        default:
+            std::fill(lights, lights + count, color);
+            break;
+    }
+}
+
+void blendFill(TRgb16* lights, std::size_t count, TRgb16 color, TBlend blend)
+{
+    if(blend.mode == BlendReplace)
+    {
+        std::fill(lights, lights + count, color);
+        return;
+    }
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        lights[i] = blendColor(lights[i], color, blend);
+    }
+}
+
+} /* namespace Processing */
@@ -0,0 +1,131 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Blend modes, which define how a block combines its output with the strip.
+ */
+
+#ifndef PROCESSING_BLEND_H_
+#define PROCESSING_BLEND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ProcessingTypes.h"
+
+namespace Processing
+{
+
+/** How a block combines its output with the strip it operates on. */
+enum TBlendMode : uint8_t
+{
+    /** Output overwrites the strip. */
+    BlendReplace,
+    /** Output is added to the strip, saturating. */
+    BlendAdd,
+    /** Per component maximum of output and strip. */
+    BlendMax,
+    /** Strip is multiplied by the output, where 255 is 1. */
+    BlendMultiply,
+    /** Output is mixed over the strip, with the opacity of the blend. */
+    BlendAlpha
+};
+
+/** Blend mode and its parameter. */
+struct TBlend
+{
+    TBlendMode mode;
+
+    /** Opacity for @ref BlendAlpha, where 255 is opaque. */
+    uint8_t alpha;
+
+    /**
+     * Compare with another @ref TBlend.
+     */
+    bool operator==(const TBlend& other) const;
+    bool operator!=(const TBlend& other) const;
+};
+
+/**
+ * Get the name of a blend mode, as used in JSON.
+ */
+const char* getBlendModeName(TBlendMode mode);
+
+/**
+ * Get a blend mode from its name.
+ *
+ * @param[in]   name    The name.
+ * @param[out]  mode    The blend mode, only written when found.
+ *
+ * @retval  true    The name is valid.
+ * @retval  false   The name is unknown.
+ */
+bool getBlendModeFromName(const std::string& name, TBlendMode& mode);
+
+/**
+ * Add the blend settings to the JSON object of a block.
+ */
+void addBlendToJson(const TBlend& blend, Json::object& json);
+
+/**
+ * Read the blend settings from the JSON object of a block. Missing keys and unknown modes keep the current setting.
+ */
+void getBlendFromJson(const Json& json, TBlend& blend);
+
+/**
+ * Blend a single color onto another. For blending many lights with the same color, use @ref blendFill.
+ *
+ * @param[in]   destination The color on the strip.
+ * @param[in]   source      The output color of the block.
+ * @param[in]   blend       How to combine them.
+ */
+TRgb blendColor(TRgb destination, TRgb source, TBlend blend);
+
+/**
+ * Like @ref blendColor, with high precision.
+ */
+TRgb16 blendColor(TRgb16 destination, TRgb16 source, TBlend blend);
+
+/**
+ * Blend a single color onto a range of lights.
+ *
+ * The strip is processed as a packed byte buffer. Add and max work on four bytes at once in 32-bit words, which
+ * suits the ESP32. The other modes are plain byte loops, which the compiler can vectorize on targets with SIMD.
+ *
+ * @param[in, out]  lights  First light of the range.
+ * @param[in]       count   Number of lights.
+ * @param[in]       color   The color to blend onto every light.
+ * @param[in]       blend   How to combine them.
+ */
+void blendFill(TRgb* lights, std::size_t count, TRgb color, TBlend blend);
+
+/**
+ * Like @ref blendFill, with high precision.
+ */
+void blendFill(TRgb16* lights, std::size_t count, TRgb16 color, TBlend blend);
+
+} /* namespace Processing */
+
+#endif /* PROCESSING_BLEND_H_ */
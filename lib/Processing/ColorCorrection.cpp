@@ -0,0 +1,201 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+
+#include "ColorCorrection.h"
+#include "Json11Helper.h"
+#include "Logging.h"
+
+#define LOGGING_COMPONENT "ColorCorrection"
+
+ColorCorrection::ColorCorrection()
+    : m_redGamma(1.0f)
+    , m_greenGamma(1.0f)
+    , m_blueGamma(1.0f)
+    , m_whitePoint(UINT8_MAX, UINT8_MAX, UINT8_MAX)
+    , m_redTable()
+    , m_greenTable()
+    , m_blueTable()
+    , m_redHighPrecisionTable()
+    , m_greenHighPrecisionTable()
+    , m_blueHighPrecisionTable()
+{
+    updateTables();
+}
+
+void ColorCorrection::setGamma(float r, float g, float b)
+{
+    if((r <= 0) || (g <= 0) || (b <= 0))
+    {
+        LOG_WARNING("ignoring non-positive gamma");
+        return;
+    }
+
+    m_redGamma = r;
+    m_greenGamma = g;
+    m_blueGamma = b;
+    updateTables();
+}
+
+void ColorCorrection::setWhitePoint(Processing::TRgb whitePoint)
+{
+    m_whitePoint = whitePoint;
+    updateTables();
+}
+
+float ColorCorrection::getRedGamma() const
+{
+    return m_redGamma;
+}
+
+float ColorCorrection::getGreenGamma() const
+{
+    return m_greenGamma;
+}
+
+float ColorCorrection::getBlueGamma() const
+{
+    return m_blueGamma;
+}
+
+Processing::TRgb ColorCorrection::getWhitePoint() const
+{
+    return m_whitePoint;
+}
+
+bool ColorCorrection::isIdentity() const
+{
+    return (m_redGamma == 1.0f) && (m_greenGamma == 1.0f) && (m_blueGamma == 1.0f) &&
+        (m_whitePoint == Processing::TRgb(UINT8_MAX, UINT8_MAX, UINT8_MAX));
+}
+
+void ColorCorrection::apply(const Processing::TRgbStrip& input, Processing::TRgbStrip& output) const
+{
+    output.resize(input.size());
+
+    for(std::size_t led = 0; led < input.size(); ++led)
+    {
+        output[led].r = m_redTable[input[led].r];
+        output[led].g = m_greenTable[input[led].g];
+        output[led].b = m_blueTable[input[led].b];
+    }
+}
+
+void ColorCorrection::apply(Processing::TRgbStrip16& strip) const
+{
+    for(auto& color : strip)
+    {
+        color.r = lookup(m_redHighPrecisionTable, color.r);
+        color.g = lookup(m_greenHighPrecisionTable, color.g);
+        color.b = lookup(m_blueHighPrecisionTable, color.b);
+    }
+}
+
+void ColorCorrection::updateTables()
+{
+    generateTable(m_redTable, m_redGamma, m_whitePoint.r);
+    generateTable(m_greenTable, m_greenGamma, m_whitePoint.g);
+    generateTable(m_blueTable, m_blueGamma, m_whitePoint.b);
+    generateTable(m_redHighPrecisionTable, m_redGamma, m_whitePoint.r);
+    generateTable(m_greenHighPrecisionTable, m_greenGamma, m_whitePoint.g);
+    generateTable(m_blueHighPrecisionTable, m_blueGamma, m_whitePoint.b);
+}
+
+void ColorCorrection::generateTable(TTable& table, float gamma, uint8_t white)
+{
+    for(unsigned int input = 0; input <= UINT8_MAX; ++input)
+    {
+        float normalized(static_cast<float>(input) / UINT8_MAX);
+        float output(white * std::pow(normalized, gamma) + 0.5f);
+        table[input] = static_cast<uint8_t>(output > UINT8_MAX ? UINT8_MAX : output);
+    }
+}
+
+void ColorCorrection::generateTable(THighPrecisionTable& table, float gamma, uint8_t white)
+{
+    for(unsigned int input = 0; input < table.size(); ++input)
+    {
+        // Entries are in 8.8 fixed point. The extra entry is beyond full scale, so it repeats the white point.
+        float normalized(input < UINT8_MAX ? static_cast<float>(input) / UINT8_MAX : 1.0f);
+        float output(256.0f * white * std::pow(normalized, gamma) + 0.5f);
+        table[input] = static_cast<uint16_t>(output > UINT16_MAX ? UINT16_MAX : output);
+    }
+}
+
+uint16_t ColorCorrection::lookup(const THighPrecisionTable& table, uint16_t value)
+{
+    // The integer part selects the entry, the fraction interpolates towards the next one
+    unsigned int index(value >> 8);
+    int32_t fraction(value & 0xff);
+    int32_t low(table[index]), high(table[index + 1]);
+
+    return static_cast<uint16_t>(low + (((high - low) * fraction) >> 8));
+}
+
+Json ColorCorrection::convertToJson() const
+{
+    Json::object json;
+    json[IJsonConvertible::c_objectTypeKey] = getObjectType();
+    json[c_rGammaJsonKey] = m_redGamma;
+    json[c_gGammaJsonKey] = m_greenGamma;
+    json[c_bGammaJsonKey] = m_blueGamma;
+    json[c_rWhiteJsonKey] = m_whitePoint.r;
+    json[c_gWhiteJsonKey] = m_whitePoint.g;
+    json[c_bWhiteJsonKey] = m_whitePoint.b;
+
+    return Json(json);
+}
+
+void ColorCorrection::convertFromJson(const Json& converted)
+{
+    Json11Helper helper(__PRETTY_FUNCTION__, converted);
+
+    float r(m_redGamma), g(m_greenGamma), b(m_blueGamma);
+    helper.getItemIfPresent(c_rGammaJsonKey, r);
+    helper.getItemIfPresent(c_gGammaJsonKey, g);
+    helper.getItemIfPresent(c_bGammaJsonKey, b);
+    helper.getItemIfPresent(c_rWhiteJsonKey, m_whitePoint.r);
+    helper.getItemIfPresent(c_gWhiteJsonKey, m_whitePoint.g);
+    helper.getItemIfPresent(c_bWhiteJsonKey, m_whitePoint.b);
+
+    if((r > 0) && (g > 0) && (b > 0))
+    {
+        m_redGamma = r;
+        m_greenGamma = g;
+        m_blueGamma = b;
+    }
+    else
+    {
+        LOG_WARNING("ignoring non-positive gamma");
+    }
+    updateTables();
+}
+
+std::string ColorCorrection::getObjectType() const
+{
+    return c_typeName;
+}
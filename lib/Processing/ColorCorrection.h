@@ -0,0 +1,157 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Output stage which corrects gamma and white balance of the LED strip.
+ */
+
+#ifndef PROCESSING_COLORCORRECTION_H_
+#define PROCESSING_COLORCORRECTION_H_
+
+#include <array>
+#include <cstdint>
+
+#include "IJsonConvertible.h"
+#include "ProcessingTypes.h"
+
+/**
+ * Output stage which corrects gamma and white balance of the LED strip.
+ *
+ * LEDs are driven linearly by PWM, while the eye perceives brightness logarithmically. Without correction, soft and
+ * loud notes look almost the same. This stage maps every component through a lookup table, which is generated once
+ * when the correction is configured: output = white * (input / 255) ^ gamma. Applying it thus costs one table
+ * lookup per component, instead of a power function.
+ *
+ * High precision strips are corrected before they are quantized, otherwise all low intensities which are resolved by
+ * dithering would end up black. They use a table with an entry per 8-bit input level, and interpolate linearly
+ * between entries for the fraction.
+ *
+ * The default (gamma 1, white point 255) passes colors unchanged.
+ */
+class ColorCorrection
+    : public IJsonConvertible
+{
+public:
+    /**
+     * Constructor.
+     */
+    ColorCorrection();
+
+    /**
+     * Set the gamma per channel.
+     *
+     * @param[in]   r   Red gamma. Must be positive.
+     * @param[in]   g   Green gamma. Must be positive.
+     * @param[in]   b   Blue gamma. Must be positive.
+     */
+    void setGamma(float r, float g, float b);
+
+    /**
+     * Set the white point, which is the output for full white input. Used to balance the channels of LEDs which are
+     * not equally bright.
+     */
+    void setWhitePoint(Processing::TRgb whitePoint);
+
+    float getRedGamma() const;
+    float getGreenGamma() const;
+    float getBlueGamma() const;
+    Processing::TRgb getWhitePoint() const;
+
+    /**
+     * Check whether the correction leaves colors unchanged.
+     */
+    bool isIdentity() const;
+
+    /**
+     * Correct a strip in one pass.
+     *
+     * @param[in]   input   The strip to correct.
+     * @param[out]  output  The corrected strip. Resized to the size of the input if needed.
+     */
+    void apply(const Processing::TRgbStrip& input, Processing::TRgbStrip& output) const;
+
+    /**
+     * Correct a high precision strip in place, before it is quantized.
+     *
+     * @param[in, out]  strip   The strip to correct.
+     */
+    void apply(Processing::TRgbStrip16& strip) const;
+
+    // IJsonConvertible implementation
+    Json convertToJson() const override;
+    void convertFromJson(const Json& converted) override;
+
+protected:
+    // IJsonConvertible implementation
+    std::string getObjectType() const override;
+
+private:
+    typedef std::array<uint8_t, UINT8_MAX + 1> TTable;
+
+    /** High precision table, with an extra entry to interpolate towards for the highest level. */
+    typedef std::array<uint16_t, UINT8_MAX + 2> THighPrecisionTable;
+
+    /**
+     * Regenerate the lookup tables after the parameters changed.
+     */
+    void updateTables();
+
+    /**
+     * Generate the lookup table of a single channel.
+     */
+    static void generateTable(TTable& table, float gamma, uint8_t white);
+
+    /**
+     * Generate the high precision lookup table of a single channel.
+     */
+    static void generateTable(THighPrecisionTable& table, float gamma, uint8_t white);
+
+    /**
+     * Look up a high precision component, interpolating between the table entries.
+     */
+    static uint16_t lookup(const THighPrecisionTable& table, uint16_t value);
+
+    float m_redGamma;
+    float m_greenGamma;
+    float m_blueGamma;
+    Processing::TRgb m_whitePoint;
+
+    /** Lookup tables, generated from the parameters. */
+    TTable m_redTable;
+    TTable m_greenTable;
+    TTable m_blueTable;
+    THighPrecisionTable m_redHighPrecisionTable;
+    THighPrecisionTable m_greenHighPrecisionTable;
+    THighPrecisionTable m_blueHighPrecisionTable;
+
+    static constexpr const char* c_typeName = "ColorCorrection";
+    static constexpr const char* c_rGammaJsonKey = "rGamma";
+    static constexpr const char* c_gGammaJsonKey = "gGamma";
+    static constexpr const char* c_bGammaJsonKey = "bGamma";
+    static constexpr const char* c_rWhiteJsonKey = "rWhite";
+    static constexpr const char* c_gWhiteJsonKey = "gWhite";
+    static constexpr const char* c_bWhiteJsonKey = "bWhite";
+};
+
+#endif /* PROCESSING_COLORCORRECTION_H_ */
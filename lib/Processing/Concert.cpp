@@ -24,6 +24,7 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include <list>
 #include <cassert>
 
@@ -32,20 +33,33 @@
 
 #include "Concert.h"
 #include "IPatch.h"
+#include "ITime.h"
 
 #define LOGGING_COMPONENT "Concert"
 
-Concert::Concert(IMidiInput& midiInput, IProcessingBlockFactory& processingBlockFactory)
+Concert::Concert(IMidiInput& midiInput, IProcessingBlockFactory& processingBlockFactory, const ITime& time)
     : m_noteToLightMap()
+    , m_noteToLightTable()
     , m_strip()
+    , m_colorCorrection()
+    , m_powerLimiter()
+    , m_outputStrip()
+    , m_parallelExecutor(nullptr)
     , m_patches()
+    , m_patchIndex()
+    , m_patchIndexValid(false)
     , m_activePatch(c_invalidPatchPosition)
+    , m_forceUpdate(true)
     , m_listeningToProgramChange(false)
     , m_programChangeChannel(0)
     , m_currentBank(0)
     , m_midiInput(midiInput)
     , m_processingBlockFactory(processingBlockFactory)
+    , m_time(time)
     , m_scheduler()
+    , m_eventHandlingDurations()
+    , m_patchExecutionDurations()
+    , m_observerNotificationDurations()
     , m_mutex()
 {
     m_midiInput.subscribe(*this);
@@ -88,12 +102,21 @@ Concert::TPatchPosition Concert::addPatch(IPatch* patch)
 Concert::TPatchPosition Concert::addPatchInternal(IPatch* patch)
 {
     m_patches.push_back(patch);
+    patch->setObserver(this);
+    m_patchIndexValid = false;
+
+    patch->getProcessingChain().setColorCorrection(&m_colorCorrection);
+    if(m_parallelExecutor != nullptr)
+    {
+        patch->getProcessingChain().setParallelExecutor(m_parallelExecutor);
+    }
 
     if(m_patches.size() == 1)
     {
         // First patch. Activate it.
         patch->activate();
         m_activePatch = 0;
+        m_forceUpdate = true;
     }
 
     return m_patches.size() - 1;
@@ -120,7 +143,9 @@ bool Concert::removePatch(TPatchPosition position)
         return false;
     }
 
+    m_patches.at(position)->setObserver(nullptr);
     m_patches.erase(m_patches.begin() + position);
+    m_patchIndexValid = false;
     return true;
 }
 
@@ -134,6 +159,8 @@ Json Concert::convertToJson() const
     converted[c_programChangeChannelJsonKey] = m_programChangeChannel;
     converted[c_currentBankJsonKey] = m_currentBank;
     converted[c_noteToLightMapJsonKey] = Processing::convert(m_noteToLightMap);
+    converted[c_colorCorrectionJsonKey] = m_colorCorrection.convertToJson();
+    converted[c_powerLimiterJsonKey] = m_powerLimiter.convertToJson();
 
     Json::array convertedPatches;
     for(const IPatch* patch : m_patches)
@@ -158,8 +185,22 @@ void Concert::convertFromJson(const Json& converted)
     if(helper.getItemIfPresent(c_noteToLightMapJsonKey, convertedNoteToLightMap))
     {
         m_noteToLightMap = Processing::convert(convertedNoteToLightMap);
-        // Make sure all mapped lights fit into the strip
-        createMinimumAmountOfLights();
+        updateNoteToLightTable();
+    }
+
+    // Optional, to keep accepting concerts stored before the output stages existed
+    Json11Helper optionalItemsHelper(__PRETTY_FUNCTION__, converted, false /* logMissingKeys */);
+    Json::object convertedColorCorrection;
+    if(optionalItemsHelper.getItemIfPresent(c_colorCorrectionJsonKey, convertedColorCorrection))
+    {
+        m_colorCorrection.convertFromJson(convertedColorCorrection);
+        m_forceUpdate = true;
+    }
+    Json::object convertedPowerLimiter;
+    if(optionalItemsHelper.getItemIfPresent(c_powerLimiterJsonKey, convertedPowerLimiter))
+    {
+        m_powerLimiter.convertFromJson(convertedPowerLimiter);
+        m_forceUpdate = true;
     }
 
     for(IPatch* patch : m_patches)
@@ -167,13 +208,15 @@ void Concert::convertFromJson(const Json& converted)
         delete patch;
     }
     m_patches.clear();
+    m_activePatch = c_invalidPatchPosition;
 
     Json::array convertedPatches;
     if(helper.getItemIfPresent(c_patchesJsonKey, convertedPatches))
     {
         for(const Json& convertedPatch : convertedPatches)
         {
-            m_patches.push_back(m_processingBlockFactory.createPatch(convertedPatch));
+            // Activates the first patch, like when adding patches one by one
+            addPatchInternal(m_processingBlockFactory.createPatch(convertedPatch));
         }
     }
 }
@@ -204,19 +247,27 @@ void Concert::setNoteToLightMap(Processing::TNoteToLightMap noteToLightMap)
     std::lock_guard<std::mutex> lock(m_mutex);
     
     m_noteToLightMap = noteToLightMap;
+    updateNoteToLightTable();
+}
+
+void Concert::updateNoteToLightTable()
+{
+    // Compile once here, so execution doesn't have to traverse the map every cycle.
+    m_noteToLightTable = Processing::TNoteToLightTable(m_noteToLightMap);
 
     // Make sure all mapped lights fit into the strip
     createMinimumAmountOfLights();
+    m_forceUpdate = true;
 }
 
 void Concert::createMinimumAmountOfLights()
 {
     uint16_t highestLightIndex(0);
-    for(const auto& pair : m_noteToLightMap)
+    for(const auto& mapping : m_noteToLightTable)
     {
-        if(pair.second > highestLightIndex)
+        if(mapping.light > highestLightIndex)
         {
-            highestLightIndex = pair.second;
+            highestLightIndex = mapping.light;
         }
     }
 
@@ -263,27 +314,120 @@ void Concert::setCurrentBank(uint16_t bank)
     m_currentBank = bank;
 }
 
+ColorCorrection Concert::getColorCorrection() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_colorCorrection;
+}
+
+void Concert::setColorCorrection(const ColorCorrection& colorCorrection)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_colorCorrection = colorCorrection;
+    m_forceUpdate = true;
+}
+
+PowerLimiter Concert::getPowerLimiter() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_powerLimiter;
+}
+
+void Concert::setPowerLimiter(const PowerLimiter& powerLimiter)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_powerLimiter = powerLimiter;
+    m_forceUpdate = true;
+}
+
+void Concert::setParallelExecutor(IParallelExecutor* executor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_parallelExecutor = executor;
+    for(auto patch : m_patches)
+    {
+        patch->getProcessingChain().setParallelExecutor(executor);
+    }
+}
+
 void Concert::execute()
 {
+    uint64_t startTime(m_time.getMicroseconds());
     m_scheduler.executeAll();
+    uint64_t eventsHandledTime(m_time.getMicroseconds());
+    m_eventHandlingDurations.record(static_cast<uint32_t>(eventsHandledTime - startTime));
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
     if(m_activePatch != c_invalidPatchPosition)
     {
-        m_patches.at(m_activePatch)->execute(m_strip, m_noteToLightMap);
+        IPatch& patch(*m_patches.at(m_activePatch));
+        bool changed(patch.execute(m_strip, m_noteToLightTable));
+        uint64_t executedTime(m_time.getMicroseconds());
+        m_patchExecutionDurations.record(static_cast<uint32_t>(executedTime - eventsHandledTime));
 
-        for(auto observer : m_observers)
+        // Leave observers (and the LEDs) idle when nothing changed
+        if(changed || m_forceUpdate)
         {
-            observer->onStripUpdate(m_strip);
+            // Process into a separate strip: the patch detects changes using the unprocessed state
+            const Processing::TRgbStrip* output(&m_strip);
+            // High precision chains correct before quantization themselves
+            if(!m_colorCorrection.isIdentity() && !patch.getProcessingChain().isHighPrecision())
+            {
+                m_colorCorrection.apply(m_strip, m_outputStrip);
+                output = &m_outputStrip;
+            }
+            if(m_powerLimiter.isEnabled())
+            {
+                if(output != &m_outputStrip)
+                {
+                    m_outputStrip = m_strip;
+                    output = &m_outputStrip;
+                }
+                m_powerLimiter.limit(m_outputStrip);
+            }
+
+            for(auto observer : m_observers)
+            {
+                observer->onStripUpdate(*output);
+            }
+
+            // Keep updating while the limiter recovers, also when the patch does not change
+            m_forceUpdate = m_powerLimiter.isRecovering();
         }
+        m_observerNotificationDurations.record(static_cast<uint32_t>(m_time.getMicroseconds() - executedTime));
     }
 }
 
+Concert::TTimingStatistics Concert::getTimingStatistics() const
+{
+    TTimingStatistics statistics;
+    statistics.eventHandling = m_eventHandlingDurations.getStatistics();
+    statistics.patchExecution = m_patchExecutionDurations.getStatistics();
+    statistics.observerNotification = m_observerNotificationDurations.getStatistics();
+
+    return statistics;
+}
+
+void Concert::resetTimingStatistics()
+{
+    m_eventHandlingDurations.reset();
+    m_patchExecutionDurations.reset();
+    m_observerNotificationDurations.reset();
+}
+
 void Concert::subscribe(IObserver& observer)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_observers.push_back(&observer);
+
+    // Make sure the new observer gets the current state
+    m_forceUpdate = true;
 }
 
 void Concert::unsubscribe(IObserver& observer)
@@ -312,33 +456,77 @@ void Concert::onProgramChange(uint8_t channel, uint8_t program)
             return;
         }
 
-        for(auto patchIt = m_patches.begin(); patchIt != m_patches.end(); ++patchIt)
+        TPatchPosition position(findPatch(m_currentBank, program));
+        if(position == c_invalidPatchPosition)
         {
-            IPatch* patch = *patchIt;
-            if(patch->hasBankAndProgram())
-            {
-                if(patch->getBank() == m_currentBank)
-                {
-                    if(patch->getProgram() == program)
-                    {
-                        // Found a patch which matches the received program number and active bank.
-                        if(m_activePatch != c_invalidPatchPosition)
-                        {
-                            IPatch* activePatch(m_patches.at(m_activePatch));
-                            LOG_INFO_PARAMS("deactivating patch '%s'", activePatch->getName().c_str());
-                            activePatch->deactivate();
-                        }
-                        LOG_INFO_PARAMS("activating patch '%s'", patch->getName().c_str());
-                        patch->activate();
-                        m_activePatch = patchIt - m_patches.begin();
-                    }
-                }
-            }
+            return;
         }
+
+        // Found a patch which matches the received program number and active bank.
+        if(m_activePatch != c_invalidPatchPosition)
+        {
+            IPatch* activePatch(m_patches.at(m_activePatch));
+            LOG_INFO_PARAMS("deactivating patch '%s'", activePatch->getName().c_str());
+            activePatch->deactivate();
+        }
+        IPatch* patch(m_patches.at(position));
+        LOG_INFO_PARAMS("activating patch '%s'", patch->getName().c_str());
+        patch->activate();
+        m_activePatch = position;
+        m_forceUpdate = true;
     };
     m_scheduler.schedule(taskFn);
 }
 
+void Concert::onBankAndProgramChange(const IPatch& patch)
+{
+    // Patches can be edited from any task, so only mark the index for a rebuild on next use, without locking
+    m_patchIndexValid = false;
+}
+
+Concert::TPatchPosition Concert::findPatch(uint16_t bank, uint8_t program)
+{
+    // Mark valid before rebuilding, so a change during the rebuild is not lost
+    if(!m_patchIndexValid.exchange(true))
+    {
+        updatePatchIndex();
+    }
+
+    const uint32_t bankAndProgram((static_cast<uint32_t>(bank) << 8) | program);
+    auto it(std::upper_bound(m_patchIndex.begin(), m_patchIndex.end(), bankAndProgram,
+                             [](uint32_t key, const TPatchIndexEntry& entry) {
+                                 return key < entry.bankAndProgram;
+                             }));
+
+    // Entries with the same key are ordered by position, the last one wins
+    if((it == m_patchIndex.begin()) || ((it - 1)->bankAndProgram != bankAndProgram))
+    {
+        return c_invalidPatchPosition;
+    }
+
+    return (it - 1)->position;
+}
+
+void Concert::updatePatchIndex()
+{
+    m_patchIndex.clear();
+    for(TPatchPosition position = 0; position < static_cast<TPatchPosition>(m_patches.size()); ++position)
+    {
+        const IPatch* patch(m_patches[position]);
+        if(patch->hasBankAndProgram())
+        {
+            uint32_t bankAndProgram((static_cast<uint32_t>(patch->getBank()) << 8) | patch->getProgram());
+            m_patchIndex.push_back({bankAndProgram, position});
+        }
+    }
+
+    // Stable, to keep patches with the same bank and program number ordered by position
+    std::stable_sort(m_patchIndex.begin(), m_patchIndex.end(),
+                     [](const TPatchIndexEntry& a, const TPatchIndexEntry& b) {
+                         return a.bankAndProgram < b.bankAndProgram;
+                     });
+}
+
 void Concert::onControlChange(uint8_t channel, IMidiInterface::TControllerNumber controllerNumber, uint8_t value)
 {
     if((controllerNumber != IMidiInterface::BANK_SELECT_MSB) && (controllerNumber != IMidiInterface::BANK_SELECT_LSB))
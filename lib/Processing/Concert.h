@@ -29,19 +29,25 @@
 #ifndef PROCESSING_CONCERT_H_
 #define PROCESSING_CONCERT_H_
 
+#include <atomic>
 #include <vector>
 #include <list>
 #include <cstdint>
 
 #include "IJsonConvertible.h"
 #include "ProcessingTypes.h"
+#include "ColorCorrection.h"
+#include "PowerLimiter.h"
 #include "Scheduler.h"
+#include "DurationHistogram.h"
 #include "IMidiInterface.h"
 #include "IMidiInput.h"
+#include "IPatch.h"
 
 class IMidiInput;
+class IParallelExecutor;
 class IProcessingBlockFactory;
-class IPatch;
+class ITime;
 
 /**
  * Class which represents a concert.
@@ -52,6 +58,7 @@ class IPatch;
 class Concert
     : public IJsonConvertible
     , public IMidiInput::IObserver
+    , public IPatch::IObserver
 {
 public:
     /**
@@ -59,8 +66,9 @@ public:
      *
      * @param[in]   midiInput               Reference to the MIDI input.
      * @param[in]   processingBlockFactory  Reference to the processing block factory.
+     * @param[in]   time                    Reference to the time provider, used to measure execution times.
      */
-    Concert(IMidiInput& midiInput, IProcessingBlockFactory& processingBlockFactory);
+    Concert(IMidiInput& midiInput, IProcessingBlockFactory& processingBlockFactory, const ITime& time);
 
     /**
      * Destructor.
@@ -148,9 +156,44 @@ public:
     void setProgramChangeChannel(uint8_t programChangeChannel);
     uint16_t getCurrentBank() const;
     void setCurrentBank(uint16_t bank);
+    ColorCorrection getColorCorrection() const;
+    void setColorCorrection(const ColorCorrection& colorCorrection);
+    PowerLimiter getPowerLimiter() const;
+    void setPowerLimiter(const PowerLimiter& powerLimiter);
+
+    /**
+     * Set an executor to render compiled processing chains on multiple cores. Applies to all current and future
+     * patches.
+     *
+     * @param[in]   executor    Pointer to the executor, or nullptr to render serially.
+     */
+    void setParallelExecutor(IParallelExecutor* executor);
 
     void execute();
 
+    /** Execution times of the phases of @ref execute. */
+    struct TTimingStatistics
+    {
+        /** Handling of the MIDI events received since the previous execution. */
+        DurationHistogram::TStatistics eventHandling;
+
+        /** Execution of the active patch. */
+        DurationHistogram::TStatistics patchExecution;
+
+        /** Notification of the observers. */
+        DurationHistogram::TStatistics observerNotification;
+    };
+
+    /**
+     * Get the execution times since construction or the last reset. Can be called from any thread.
+     */
+    TTimingStatistics getTimingStatistics() const;
+
+    /**
+     * Reset the execution times. Can be called from any thread, the reset is carried out by the next execution.
+     */
+    void resetTimingStatistics();
+
     /**
      * Interface to implement by Concert observers.
      */
@@ -173,6 +216,9 @@ public:
     virtual void onChannelPressureChange(uint8_t channel, uint8_t value);
     virtual void onPitchBendChange(uint8_t channel, uint16_t value);
 
+    // IPatch::IObserver implementation
+    virtual void onBankAndProgramChange(const IPatch& patch);
+
 protected:
     // IJsonConvertible implementation
     std::string getObjectType() const;
@@ -184,24 +230,74 @@ private:
     static constexpr const char* c_programChangeChannelJsonKey          = "programChangeChannel";
     static constexpr const char* c_currentBankJsonKey                   = "currentBank";
     static constexpr const char* c_patchesJsonKey                       = "patches";
+    static constexpr const char* c_colorCorrectionJsonKey               = "colorCorrection";
+    static constexpr const char* c_powerLimiterJsonKey                  = "powerLimiter";
 
     typedef std::vector<IPatch*> TPatches;
 
     TPatchPosition addPatchInternal(IPatch* patch);
+
+    /**
+     * Find the patch bound to a bank and program number. Rebuilds the index first if needed. Must be called with the
+     * mutex held.
+     *
+     * @return  The position of the patch, or @ref c_invalidPatchPosition if there is none. If multiple patches match,
+     *          the last one.
+     */
+    TPatchPosition findPatch(uint16_t bank, uint8_t program);
+
+    /** Rebuild @ref m_patchIndex. Must be called with the mutex held. */
+    void updatePatchIndex();
+    void updateNoteToLightTable();
     void createMinimumAmountOfLights();
 
     /** The note-to-light mapping. */
     Processing::TNoteToLightMap m_noteToLightMap;
 
+    /** The note-to-light mapping, compiled for use during execution. */
+    Processing::TNoteToLightTable m_noteToLightTable;
+
     /** The actual state of the RGB LED strip. */
     Processing::TRgbStrip m_strip;
 
+    /**
+     * Correction applied to the strip before it is passed to the observers. Also passed to the processing chains of
+     * the patches, which apply it themselves when executing with high precision.
+     */
+    ColorCorrection m_colorCorrection;
+
+    /** Limiter applied to the strip after the correction, to stay within the current budget. */
+    PowerLimiter m_powerLimiter;
+
+    /** The corrected and limited strip, which is passed to the observers unless both stages are disabled. */
+    Processing::TRgbStrip m_outputStrip;
+
+    /** Executor passed to the processing chains of the patches, if set. */
+    IParallelExecutor* m_parallelExecutor;
+
     /** The collection of patches. */
     TPatches m_patches;
 
+    /** Entry of the patch index. */
+    struct TPatchIndexEntry
+    {
+        /** Bank number in the upper bits, program number in the lower 8 bits. */
+        uint32_t bankAndProgram;
+        TPatchPosition position;
+    };
+
+    /** Patches with a bank and program number, sorted by those and then by position, for fast program changes. */
+    std::vector<TPatchIndexEntry> m_patchIndex;
+
+    /** Whether @ref m_patchIndex is up to date. Cleared by patches without taking the mutex. */
+    std::atomic<bool> m_patchIndexValid;
+
     /** The active patch. */
     TPatchPosition m_activePatch;
 
+    /** Whether observers must be updated at the next execution, even if the active patch reports no change. */
+    bool m_forceUpdate;
+
     /** Whether program changes should be able to change the patch. */
     bool m_listeningToProgramChange;
 
@@ -217,9 +313,21 @@ private:
     /** Reference to the processing block factory. */
     IProcessingBlockFactory& m_processingBlockFactory;
 
+    /** Reference to the time provider. */
+    const ITime& m_time;
+
     /** Scheduler to decouple callbacks */
     Scheduler m_scheduler;
 
+    /** Execution times of the event handling phase. */
+    DurationHistogram m_eventHandlingDurations;
+
+    /** Execution times of the patch execution phase. */
+    DurationHistogram m_patchExecutionDurations;
+
+    /** Execution times of the observer notification phase. */
+    DurationHistogram m_observerNotificationDurations;
+
     std::list<IObserver*> m_observers;
 
     /** Mutex to protect the members. */
@@ -28,10 +28,14 @@
 #include <Json11Helper.h>
 
 #include "EqualRangeRgbSource.h"
+#include "RenderProgram.h"
 
 EqualRangeRgbSource::EqualRangeRgbSource()
     : m_mutex()
     , m_color()
+    , m_blend({Processing::BlendReplace, UINT8_MAX})
+    , m_changed(true)
+    , m_observer(nullptr)
 {
 }
 
@@ -39,6 +43,27 @@ EqualRangeRgbSource::~EqualRangeRgbSource()
 {
 }
 
+void EqualRangeRgbSource::setObserver(IObserver* observer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_observer = observer;
+}
+
+void EqualRangeRgbSource::notifyCompiledStateChange() const
+{
+    IObserver* observer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        observer = m_observer;
+    }
+
+    if(observer != nullptr)
+    {
+        observer->onCompiledStateChange(*this);
+    }
+}
+
 void EqualRangeRgbSource::activate()
 {
 }
@@ -47,16 +72,34 @@ void EqualRangeRgbSource::deactivate()
 {
 }
 
-void EqualRangeRgbSource::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap)
+bool EqualRangeRgbSource::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    for(auto& it : strip)
-    {
-        it.r = m_color.r;
-        it.g = m_color.g;
-        it.b = m_color.b;
-    }
+    Processing::blendFill(strip.data(), strip.size(), m_color, m_blend);
+
+    bool changed(m_changed);
+    m_changed = false;
+    return changed;
+}
+
+bool EqualRangeRgbSource::executeHighPrecision(Processing::TRgbStrip16& strip,
+                                               const Processing::TNoteToLightTable& noteToLightTable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Processing::blendFill(strip.data(), strip.size(), Processing::TRgb16(m_color), m_blend);
+
+    bool changed(m_changed);
+    m_changed = false;
+    return changed;
+}
+
+void EqualRangeRgbSource::compile(RenderProgram& program)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    program.addFill(m_color, m_blend);
 }
 
 Processing::TRgb EqualRangeRgbSource::getColor() const
@@ -67,10 +110,42 @@ Processing::TRgb EqualRangeRgbSource::getColor() const
 }
 
 void EqualRangeRgbSource::setColor(Processing::TRgb color)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(color == m_color)
+        {
+            return;
+        }
+        m_color = color;
+        m_changed = true;
+    }
+
+    notifyCompiledStateChange();
+}
+
+Processing::TBlend EqualRangeRgbSource::getBlend() const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    m_color = color;
+    return m_blend;
+}
+
+void EqualRangeRgbSource::setBlend(Processing::TBlend blend)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(blend == m_blend)
+        {
+            return;
+        }
+        m_blend = blend;
+        m_changed = true;
+    }
+
+    notifyCompiledStateChange();
 }
 
 Json EqualRangeRgbSource::convertToJson() const
@@ -82,18 +157,25 @@ Json EqualRangeRgbSource::convertToJson() const
     json[c_rJsonKey] = m_color.r;
     json[c_gJsonKey] = m_color.g;
     json[c_bJsonKey] = m_color.b;
+    Processing::addBlendToJson(m_blend, json);
 
     return Json(json);
 }
 
 void EqualRangeRgbSource::convertFromJson(const Json& converted)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        Json11Helper helper(__PRETTY_FUNCTION__, converted);
+        helper.getItemIfPresent(c_rJsonKey, m_color.r);
+        helper.getItemIfPresent(c_gJsonKey, m_color.g);
+        helper.getItemIfPresent(c_bJsonKey, m_color.b);
+        Processing::getBlendFromJson(converted, m_blend);
+        m_changed = true;
+    }
 
-    Json11Helper helper(__PRETTY_FUNCTION__, converted);
-    helper.getItemIfPresent(c_rJsonKey, m_color.r);
-    helper.getItemIfPresent(c_gJsonKey, m_color.g);
-    helper.getItemIfPresent(c_bJsonKey, m_color.b);
+    notifyCompiledStateChange();
 }
 
 std::string EqualRangeRgbSource::getObjectType() const
@@ -29,7 +29,10 @@
 #ifndef PROCESSING_EQUALRANGERGBSOURCE_H_
 #define PROCESSING_EQUALRANGERGBSOURCE_H_
 
+#include <mutex>
+
 #include "IProcessingBlock.h"
+#include "Blend.h"
 
 /**
  * RGB source which generates an equal range of colors.
@@ -53,9 +56,13 @@ public:
     EqualRangeRgbSource& operator=(EqualRangeRgbSource&) = delete;
 
     // IProcessingBlock implementation.
+    virtual void setObserver(IObserver* observer);
     virtual void activate();
     virtual void deactivate();
-    virtual void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap);
+    virtual bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable);
+    virtual bool executeHighPrecision(Processing::TRgbStrip16& strip,
+                                      const Processing::TNoteToLightTable& noteToLightTable);
+    virtual void compile(RenderProgram& program);
     virtual Json convertToJson() const;
     virtual void convertFromJson(const Json& converted);
 
@@ -69,6 +76,16 @@ public:
      */
     void setColor(Processing::TRgb color);
 
+    /**
+     * Get how the color is combined with the strip. Defaults to replacing.
+     */
+    Processing::TBlend getBlend() const;
+
+    /**
+     * Set how the color is combined with the strip.
+     */
+    void setBlend(Processing::TBlend blend);
+
 protected:
     // IProcessingBlock implementation
     virtual std::string getObjectType() const;
@@ -83,6 +100,20 @@ private:
 
     /** Output color. */
     Processing::TRgb m_color;
+
+    /** How the color is combined with the strip. */
+    Processing::TBlend m_blend;
+
+    /** Whether the color changed since the last execution. */
+    bool m_changed;
+
+    /** Observer to notify when the color or blend changes, if set. */
+    IObserver* m_observer;
+
+    /**
+     * Notify the observer that compiled programs need the new color and blend. Must be called without the mutex held.
+     */
+    void notifyCompiledStateChange() const;
 };
 
 #endif /* PROCESSING_EQUALRANGERGBSOURCE_H_ */
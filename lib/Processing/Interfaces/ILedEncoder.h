@@ -0,0 +1,67 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Interface for LED chip encoders.
+ */
+
+#ifndef PROCESSING_INTERFACES_ILEDENCODER_H_
+#define PROCESSING_INTERFACES_ILEDENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ProcessingTypes.h"
+
+/**
+ * Interface for encoders, which convert strip colors into the wire format of a specific type of LED chip.
+ */
+class ILedEncoder
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~ILedEncoder() = default;
+
+    /**
+     * Get the size of a frame.
+     *
+     * @param[in]   numLeds     Number of LEDs.
+     *
+     * @return  Size of the frame in bytes.
+     */
+    virtual std::size_t getFrameSize(std::size_t numLeds) const = 0;
+
+    /**
+     * Encode strip colors into a frame.
+     *
+     * @param[in]   strip       The strip colors. LEDs beyond the strip are turned off.
+     * @param[out]  frame       The frame to write, of @ref getFrameSize bytes.
+     * @param[in]   numLeds     Number of LEDs in the frame.
+     */
+    virtual void encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const = 0;
+};
+
+#endif /* PROCESSING_INTERFACES_ILEDENCODER_H_ */
@@ -26,6 +26,9 @@
  * @brief Interface to a patch.
  */
 
+#ifndef PROCESSING_INTERFACES_IPATCH_H_
+#define PROCESSING_INTERFACES_IPATCH_H_
+
 #include "IJsonConvertible.h"
 #include "ProcessingTypes.h"
 
@@ -39,6 +42,28 @@ class IPatch
 public:
     virtual ~IPatch() = default;
 
+    /**
+     * Interface to implement by the owner of a patch, to keep track of its bank and program number.
+     */
+    class IObserver
+    {
+    public:
+        /**
+         * Called after the bank or program number of the patch may have changed. The patch is not locked.
+         */
+        virtual void onBankAndProgramChange(const IPatch& patch) = 0;
+
+    protected:
+        virtual ~IObserver() = default;
+    };
+
+    /**
+     * Set the observer. A patch has a single owner, so it has a single observer.
+     *
+     * @param[in]   observer    Pointer to the observer, or nullptr to remove it.
+     */
+    virtual void setObserver(IObserver* observer) = 0;
+
     /**
      * Get the processing chain.
      */
@@ -62,10 +87,13 @@ public:
     /**
      * Execute this patch on the given strip.
      *
-     * @param   [in/out]    strip           The strip to operate on.
-     * @param   [in/out]    noteToLightMap  To map from note number to light number.
+     * @param   [in/out]    strip               The strip to operate on.
+     * @param   [in]        noteToLightTable    To map from note number to light number.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
      */
-    virtual void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap) = 0;
+    virtual bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) = 0;
 
     /**
      * Check if the patch has a valid bank and program number.
@@ -111,3 +139,5 @@ public:
      */
     virtual void setName(std::string name) = 0;
 };
+
+#endif /* PROCESSING_INTERFACES_IPATCH_H_ */
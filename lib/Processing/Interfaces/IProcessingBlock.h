@@ -34,6 +34,8 @@
 #include "ProcessingTypes.h"
 #include "IJsonConvertible.h"
 
+class RenderProgram;
+
 /**
  * Interface for processing blocks.
  */
@@ -50,6 +52,29 @@ public:
      */
     virtual ~IProcessingBlock() = default;
 
+    /**
+     * Interface to implement by the owner of a block, to keep compiled programs up to date.
+     */
+    class IObserver
+    {
+    public:
+        /**
+         * Called after a change which requires programs containing the block to be compiled again, like a changed
+         * parameter which is copied into the program. Must not block, as the block may be called from any thread.
+         */
+        virtual void onCompiledStateChange(const IProcessingBlock& block) = 0;
+
+    protected:
+        virtual ~IObserver() = default;
+    };
+
+    /**
+     * Set the observer. A block has a single owner, so it has a single observer.
+     *
+     * @param[in]   observer    Pointer to the observer, or nullptr to remove it.
+     */
+    virtual void setObserver(IObserver* observer) = 0;
+
     /**
      * Activate this block.
      *
@@ -68,10 +93,33 @@ public:
     /**
      * Execute this block on the given strip.
      *
-     * @param   [in/out]    strip           The strip to operate on.
-     * @param   [in/out]    noteToLightMap  To map from note number to light number.
+     * @param   [in/out]    strip               The strip to operate on.
+     * @param   [in]        noteToLightTable    To map from note number to light number.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
+     */
+    virtual bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) = 0;
+
+    /**
+     * Execute this block on the given high precision strip.
+     *
+     * @param   [in/out]    strip               The strip to operate on.
+     * @param   [in]        noteToLightTable    To map from note number to light number.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
+     */
+    virtual bool executeHighPrecision(Processing::TRgbStrip16& strip,
+                                      const Processing::TNoteToLightTable& noteToLightTable) = 0;
+
+    /**
+     * Append the operations which render this block to a program. Parameters may be copied into the program, so
+     * the program must be compiled again after changing them. Blocks report such changes to their observer.
+     *
+     * @param   [in/out]    program     The program to append to.
      */
-    virtual void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap) = 0;
+    virtual void compile(RenderProgram& program) = 0;
 };
 
 #endif /* PROCESSING_IPROCESSINGBLOCK_H_ */
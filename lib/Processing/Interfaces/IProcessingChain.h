@@ -29,6 +29,9 @@
 
 #include "IProcessingBlock.h"
 
+class IParallelExecutor;
+class ColorCorrection;
+
 /**
  * Interface for processing chains.
  */
@@ -52,6 +55,46 @@ public:
      * @param[in]   block   Pointer to the processing block.
      */
     virtual void insertBlock(IProcessingBlock* block) = 0;
+
+    /**
+     * Set whether the blocks are executed with high precision. If so, the result is quantized with temporal dithering,
+     * to avoid visible steps at low intensities.
+     */
+    virtual void setHighPrecision(bool highPrecision) = 0;
+
+    /**
+     * Get whether the blocks are executed with high precision.
+     */
+    virtual bool isHighPrecision() const = 0;
+
+    /**
+     * Set whether the chain is executed as a compiled program. If so, the blocks (including those of nested chains)
+     * are compiled into a flat @ref RenderProgram when the chain is activated or changed, instead of being executed
+     * one by one. Parameters of the blocks are copied into the program at that moment. Blocks report later changes to
+     * their chain, and the program is compiled again at the next execution.
+     */
+    virtual void setCompiled(bool compiled) = 0;
+
+    /**
+     * Get whether the chain is executed as a compiled program.
+     */
+    virtual bool isCompiled() const = 0;
+
+    /**
+     * Set an executor to render the compiled program on multiple cores. Only used when the chain is compiled, and the
+     * program consists of blocks which can be rendered per strip segment.
+     *
+     * @param[in]   executor    Pointer to the executor, or nullptr to execute serially.
+     */
+    virtual void setParallelExecutor(IParallelExecutor* executor) = 0;
+
+    /**
+     * Set the color correction of the output. Only used when the chain is executed with high precision, to correct the
+     * strip before it is quantized. The caller is then responsible not to correct the output again.
+     *
+     * @param[in]   colorCorrection Pointer to the color correction, or nullptr to leave the output uncorrected.
+     */
+    virtual void setColorCorrection(const ColorCorrection* colorCorrection) = 0;
 };
 
 
@@ -32,6 +32,8 @@
 #include "IJsonConvertible.h"
 #include "ProcessingTypes.h"
 
+#include <cstddef>
+
 /**
  * Interface for RGB functions.
  */
@@ -45,12 +47,57 @@ public:
     /**
      * Calculate the output color based on the given note state and current time.
      *
+     * The output must be black for notes which have never been played. Once the output for a released note is black,
+     * it must stay black until the note is played again: note sources stop calculating released notes which went
+     * dark, and render them like notes which have never been played.
+     *
      * @param[in]   noteState   The note state.
      * @param[in]   currentTime The current time.
      *
      * @return  The output color.
      */
     virtual Processing::TRgb calculate(const Processing::TNoteState& noteState, Processing::TTime currentTime) const = 0;
+
+    /**
+     * Calculate the output colors for a set of mapped notes at once, and add them to the strip.
+     *
+     * Mappings which refer to a note without state or to a light outside the strip are skipped.
+     *
+     * @param[in]       noteStates      The note states, indexed by note number.
+     * @param[in]       numNoteStates   Number of note states.
+     * @param[in]       mappings        The notes to calculate and the lights to add their output colors to.
+     * @param[in]       numMappings     Number of mappings.
+     * @param[in, out]  strip           The strip to add the output colors to.
+     * @param[in]       currentTime     The current time.
+     */
+    virtual void calculateAll(const Processing::TNoteState* noteStates,
+                              std::size_t numNoteStates,
+                              const Processing::TNoteToLight* mappings,
+                              std::size_t numMappings,
+                              Processing::TRgbStrip& strip,
+                              Processing::TTime currentTime) const = 0;
+
+    /**
+     * Calculate the output color based on the given note state and current time, with high precision.
+     *
+     * @param[in]   noteState   The note state.
+     * @param[in]   currentTime The current time.
+     *
+     * @return  The output color. Rounded down, it differs at most 1 from the result of @ref calculate. Black under
+     *          the same conditions as that result.
+     */
+    virtual Processing::TRgb16 calculateHighPrecision(const Processing::TNoteState& noteState,
+                                                      Processing::TTime currentTime) const = 0;
+
+    /**
+     * Like @ref calculateAll, with high precision.
+     */
+    virtual void calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                           std::size_t numNoteStates,
+                                           const Processing::TNoteToLight* mappings,
+                                           std::size_t numMappings,
+                                           Processing::TRgbStrip16& strip,
+                                           Processing::TTime currentTime) const = 0;
 };
 
 #endif /* PROCESSING_IRGBFUNCTION_H_ */
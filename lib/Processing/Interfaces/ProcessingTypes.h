@@ -32,7 +32,10 @@
 #include "json11.hpp"
 using Json = json11::Json;
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <ostream>
 #include <map>
 #include <vector>
 #include <string>
@@ -126,15 +129,205 @@ struct TLinearConstants
 /** Type for RGB strip data. */
 typedef std::vector<TRgb> TRgbStrip;
 
+/**
+ * Type for single RGB color with high precision, for rendering without visible steps at low intensities.
+ *
+ * Every component is 8.8 fixed point: the upper byte is the @ref TRgb value, the lower byte the fraction. All
+ * arithmetic saturates, and uses integers only.
+ */
+struct TRgb16
+{
+    /**
+     * Default constructor, initializes values to 0.
+     */
+    TRgb16()
+        : r(0), g(0), b(0)
+    {
+    }
+
+    /**
+     * Constructor.
+     *
+     * @param[in]   r   Initial red value.
+     * @param[in]   g   Initial green value.
+     * @param[in]   b   Initial blue value.
+     */
+    TRgb16(uint16_t r, uint16_t g, uint16_t b)
+        : r(r), g(g), b(b)
+    {
+    }
+
+    /**
+     * Construct from a @ref TRgb, without fraction.
+     */
+    explicit TRgb16(const TRgb& color)
+        : r(color.r << 8), g(color.g << 8), b(color.b << 8)
+    {
+    }
+
+    /**
+     * Compare with another @ref TRgb16.
+     */
+    bool operator==(const TRgb16& other) const
+    {
+        return (other.r == r) && (other.g == g) && (other.b == b);
+    }
+
+    bool operator!=(const TRgb16& other) const
+    {
+        return !(other == *this);
+    }
+
+    /**
+     * Add colors together, saturating.
+     */
+    TRgb16& operator+=(const TRgb16& other)
+    {
+        r = addSaturating(r, other.r);
+        g = addSaturating(g, other.g);
+        b = addSaturating(b, other.b);
+        return *this;
+    }
+
+    TRgb16 operator+(const TRgb16& other) const
+    {
+        return TRgb16(*this) += other;
+    }
+
+    /**
+     * Scale every color by a Q15 factor, where 0x8000 is 1.
+     */
+    TRgb16 scale(uint16_t factor) const
+    {
+        return TRgb16(
+            static_cast<uint16_t>(std::min<uint32_t>((static_cast<uint32_t>(r) * factor) >> 15, UINT16_MAX)),
+            static_cast<uint16_t>(std::min<uint32_t>((static_cast<uint32_t>(g) * factor) >> 15, UINT16_MAX)),
+            static_cast<uint16_t>(std::min<uint32_t>((static_cast<uint32_t>(b) * factor) >> 15, UINT16_MAX))
+        );
+    }
+
+    /**
+     * Convert to a @ref TRgb, dropping the fraction.
+     */
+    TRgb toRgb() const
+    {
+        return TRgb(r >> 8, g >> 8, b >> 8);
+    }
+
+    // Implements custom value printing for Google Test
+    friend std::ostream& operator<<(std::ostream& os, const TRgb16& color);
+
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+
+private:
+    static uint16_t addSaturating(uint16_t a, uint16_t b)
+    {
+        uint32_t sum(static_cast<uint32_t>(a) + b);
+        return static_cast<uint16_t>(sum > UINT16_MAX ? UINT16_MAX : sum);
+    }
+};
+
+/**
+ * Construct high precision color from float values in the 0-255 range, clamping if necessary.
+ */
+TRgb16 rgb16FromFloat(float initialR, float initialG, float initialB);
+
+/** Type for high precision RGB strip data. */
+typedef std::vector<TRgb16> TRgbStrip16;
+
 /** Type to map MIDI note numbers to lights. */
 typedef std::map<uint8_t, uint16_t> TNoteToLightMap;
 
 Json convert(const TNoteToLightMap& source);
 TNoteToLightMap convert(const Json& source);
 
-/** Type for actual time in milliseconds. */
+/** Single note-to-light mapping. */
+struct TNoteToLight
+{
+    uint8_t note;
+    uint16_t light;
+
+    /**
+     * Compare with another @ref TNoteToLight.
+     */
+    bool operator==(const TNoteToLight& other) const;
+    bool operator!=(const TNoteToLight& other) const;
+};
+
+/**
+ * Compiled form of a @ref TNoteToLightMap, for use in the render path.
+ *
+ * Holds a dense array indexed by note number, and a packed list of all mappings ordered by note number.
+ * Both are contiguous and have a fixed size, so they can be traversed without pointer chasing or allocation.
+ */
+struct TNoteToLightTable
+{
+    static constexpr unsigned int c_numNotes = 256;
+
+    /** Light number of notes which are not mapped. */
+    static constexpr uint16_t c_unmapped = UINT16_MAX;
+
+    /**
+     * Default constructor, creates an empty table.
+     */
+    TNoteToLightTable();
+
+    /**
+     * Construct from a note-to-light map.
+     *
+     * @param[in]   map     The map to compile.
+     */
+    explicit TNoteToLightTable(const TNoteToLightMap& map);
+
+    /**
+     * Compare with another @ref TNoteToLightTable.
+     */
+    bool operator==(const TNoteToLightTable& other) const;
+    bool operator!=(const TNoteToLightTable& other) const;
+
+    /**
+     * Iterate over the packed list of mappings.
+     */
+    const TNoteToLight* begin() const;
+    const TNoteToLight* end() const;
+
+    /**
+     * Get the number of mappings.
+     */
+    size_t size() const;
+
+    // Implements custom value printing for Google Test
+    friend std::ostream& operator<<(std::ostream& os, const TNoteToLightTable& table);
+
+    /** Light number per note number, or @ref c_unmapped. */
+    std::array<uint16_t, c_numNotes> lights;
+
+    /** Packed list of mappings, of which the first @ref numMappings entries are valid. */
+    std::array<TNoteToLight, c_numNotes> mappings;
+
+    /** Number of valid entries in @ref mappings. */
+    uint16_t numMappings;
+};
+
+/** Type for actual time in milliseconds. Wraps around, so only use differences via @ref getElapsedTime. */
 typedef uint32_t TTime;
 
+/**
+ * Get the time elapsed between two time stamps, taking wrap around into account.
+ *
+ * @param[in]   since   The earlier time stamp.
+ * @param[in]   now     The later time stamp.
+ *
+ * @return  The elapsed time, or 0 if @p since is later than @p now.
+ */
+inline TTime getElapsedTime(TTime since, TTime now)
+{
+    int32_t difference(static_cast<int32_t>(now - since));
+    return difference < 0 ? 0 : static_cast<TTime>(difference);
+}
+
 /** Type for actual note states. */
 struct TNoteState
 {
@@ -144,7 +337,7 @@ struct TNoteState
     bool sounding;
     /** The press down velocity. */
     uint8_t pressDownVelocity;
-    /** The time stamp of the note on event. */
+    /** The arrival time of the note on event. */
     TTime noteOnTimeStamp;
 };
 
@@ -28,35 +28,98 @@
 #include "LinearRgbFunction.h"
 #include "Json11Helper.h"
 
+LinearRgbFunction::LinearRgbFunction()
+    : m_velocityTable()
+    , m_velocityTable16()
+{
+    updateVelocityTable();
+}
+
 Processing::TRgb LinearRgbFunction::calculate(const Processing::TNoteState& noteState, Processing::TTime currentTime) const
 {
-    Processing::TRgb output;
+    if(noteState.sounding)
+    {
+        return m_velocityTable[noteState.pressDownVelocity];
+    }
+
+    return Processing::TRgb();
+}
+
+void LinearRgbFunction::calculateAll(const Processing::TNoteState* noteStates,
+                                       std::size_t numNoteStates,
+                                       const Processing::TNoteToLight* mappings,
+                                       std::size_t numMappings,
+                                       Processing::TRgbStrip& strip,
+                                       Processing::TTime currentTime) const
+{
+    // Qualified call, so it can be inlined instead of dispatched per note
+    for(std::size_t i = 0; i < numMappings; ++i)
+    {
+        const auto& mapping(mappings[i]);
+        if(mapping.note < numNoteStates && mapping.light < strip.size())
+        {
+            strip[mapping.light] += LinearRgbFunction::calculate(noteStates[mapping.note], currentTime);
+        }
+    }
+}
 
+Processing::TRgb16 LinearRgbFunction::calculateHighPrecision(const Processing::TNoteState& noteState,
+                                                             Processing::TTime currentTime) const
+{
     if(noteState.sounding)
     {
-        output = Processing::rgbFromFloat(
-            m_redConstants.factor * noteState.pressDownVelocity + m_redConstants.offset,
-            m_greenConstants.factor * noteState.pressDownVelocity + m_greenConstants.offset,
-            m_blueConstants.factor * noteState.pressDownVelocity + m_blueConstants.offset
-        );
+        return m_velocityTable16[noteState.pressDownVelocity];
+    }
+
+    return Processing::TRgb16();
+}
+
+void LinearRgbFunction::calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                                  std::size_t numNoteStates,
+                                                  const Processing::TNoteToLight* mappings,
+                                                  std::size_t numMappings,
+                                                  Processing::TRgbStrip16& strip,
+                                                  Processing::TTime currentTime) const
+{
+    // Qualified call, so it can be inlined instead of dispatched per note
+    for(std::size_t i = 0; i < numMappings; ++i)
+    {
+        const auto& mapping(mappings[i]);
+        if(mapping.note < numNoteStates && mapping.light < strip.size())
+        {
+            strip[mapping.light] += LinearRgbFunction::calculateHighPrecision(noteStates[mapping.note], currentTime);
+        }
     }
+}
 
-    return output;
+void LinearRgbFunction::updateVelocityTable()
+{
+    for(unsigned int velocity = 0; velocity < m_velocityTable.size(); ++velocity)
+    {
+        float r(m_redConstants.factor * velocity + m_redConstants.offset);
+        float g(m_greenConstants.factor * velocity + m_greenConstants.offset);
+        float b(m_blueConstants.factor * velocity + m_blueConstants.offset);
+        m_velocityTable[velocity] = Processing::rgbFromFloat(r, g, b);
+        m_velocityTable16[velocity] = Processing::rgb16FromFloat(r, g, b);
+    }
 }
 
 void LinearRgbFunction::setRedConstants(Processing::TLinearConstants redConstants)
 {
     m_redConstants = redConstants;
+    updateVelocityTable();
 }
 
 void LinearRgbFunction::setGreenConstants(Processing::TLinearConstants greenConstants)
 {
     m_greenConstants = greenConstants;
+    updateVelocityTable();
 }
 
 void LinearRgbFunction::setBlueConstants(Processing::TLinearConstants blueConstants)
 {
     m_blueConstants = blueConstants;
+    updateVelocityTable();
 }
 
 Processing::TLinearConstants LinearRgbFunction::getRedConstants() const
@@ -97,6 +160,7 @@ void LinearRgbFunction::convertFromJson(const Json& converted)
     helper.getItemIfPresent(c_gOffsetJsonKey, m_greenConstants.offset);
     helper.getItemIfPresent(c_bFactorJsonKey, m_blueConstants.factor);
     helper.getItemIfPresent(c_bOffsetJsonKey, m_blueConstants.offset);
+    updateVelocityTable();
 }
 
 std::string LinearRgbFunction::getObjectType() const
@@ -32,6 +32,8 @@
 #include "IRgbFunction.h"
 #include "ProcessingTypes.h"
 
+#include <array>
+
 /**
  * Function which describes a time invariant linear relation between note state and RGB output.
  */
@@ -42,7 +44,7 @@ public:
     /**
      * Constructor.
      */
-    LinearRgbFunction() = default;
+    LinearRgbFunction();
 
     void setRedConstants(Processing::TLinearConstants redConstants);
     void setGreenConstants(Processing::TLinearConstants greenConstants);
@@ -54,6 +56,20 @@ public:
 
     // IRgbFunction implementation
     Processing::TRgb calculate(const Processing::TNoteState& noteState, Processing::TTime currentTime) const override;
+    void calculateAll(const Processing::TNoteState* noteStates,
+                      std::size_t numNoteStates,
+                      const Processing::TNoteToLight* mappings,
+                      std::size_t numMappings,
+                      Processing::TRgbStrip& strip,
+                      Processing::TTime currentTime) const override;
+    Processing::TRgb16 calculateHighPrecision(const Processing::TNoteState& noteState,
+                                              Processing::TTime currentTime) const override;
+    void calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                   std::size_t numNoteStates,
+                                   const Processing::TNoteToLight* mappings,
+                                   std::size_t numMappings,
+                                   Processing::TRgbStrip16& strip,
+                                   Processing::TTime currentTime) const override;
     Json convertToJson() const override;
     void convertFromJson(const Json& converted) override;
 
@@ -62,6 +78,11 @@ protected:
     std::string getObjectType() const override;
 
 private:
+    /**
+     * Recalculate the velocity table after the constants changed.
+     */
+    void updateVelocityTable();
+
     /**
      * The constants.
      * The defaults are chosen with the maximum MIDI velocity in mind (127), which will result in a value of
@@ -71,6 +92,12 @@ private:
     Processing::TLinearConstants m_greenConstants = {2, 1};
     Processing::TLinearConstants m_blueConstants = {2, 1};
 
+    /** Output color per press down velocity, precalculated from the constants. */
+    std::array<Processing::TRgb, UINT8_MAX + 1> m_velocityTable;
+
+    /** High precision output color per press down velocity, precalculated from the constants. */
+    std::array<Processing::TRgb16, UINT8_MAX + 1> m_velocityTable16;
+
     static constexpr const char* c_rFactorJsonKey = "rFactor";
     static constexpr const char* c_gFactorJsonKey = "gFactor";
     static constexpr const char* c_bFactorJsonKey = "bFactor";
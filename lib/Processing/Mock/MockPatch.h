@@ -32,15 +32,24 @@
 #include <gmock/gmock.h>
 
 #include "../Interfaces/IPatch.h"
+#include "MockProcessingChain.h"
 
 class MockPatch
     : public IPatch
 {
 public:
+    MockPatch()
+        : m_processingChain()
+    {
+        ON_CALL(*this, getProcessingChain())
+            .WillByDefault(::testing::ReturnRef(m_processingChain));
+    }
+
+    MOCK_METHOD1(setObserver, void(IObserver* observer));
     MOCK_CONST_METHOD0(getProcessingChain, IProcessingChain& ());
     MOCK_METHOD0(activate, void());
     MOCK_METHOD0(deactivate, void());
-    MOCK_METHOD2(execute, void(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap));
+    MOCK_METHOD2(execute, bool(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable));
     MOCK_CONST_METHOD0(hasBankAndProgram, bool());
     MOCK_CONST_METHOD0(getBank, uint8_t());
     MOCK_METHOD1(setBank, void(uint8_t bank));
@@ -52,6 +61,9 @@ public:
     MOCK_CONST_METHOD0(convertToJson, Json());
     MOCK_METHOD1(convertFromJson, void(const Json& converted));
 
+    /** Chain returned by default. */
+    ::testing::NiceMock<MockProcessingChain> m_processingChain;
+
 protected:
     MOCK_CONST_METHOD0(getObjectType, std::string());
 };
@@ -32,18 +32,27 @@
 #include <gmock/gmock.h>
 
 #include "../Interfaces/IProcessingBlock.h"
+#include "../RenderProgram.h"
 
 class MockProcessingBlock
     : public IProcessingBlock
 {
 public:
     // IProcessingBlock implementation
+    MOCK_METHOD1(setObserver, void(IObserver* observer));
     MOCK_METHOD0(activate, void());
     MOCK_METHOD0(deactivate, void());
-    MOCK_METHOD2(execute, void(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap));
+    MOCK_METHOD2(execute, bool(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable));
+    MOCK_METHOD2(executeHighPrecision, bool(Processing::TRgbStrip16& strip, const Processing::TNoteToLightTable& noteToLightTable));
     MOCK_CONST_METHOD0(convertToJson, Json());
     MOCK_METHOD1(convertFromJson, void(const Json& converted));
 
+    // Executed as a normal block when compiled, so expectations on execute keep working
+    void compile(RenderProgram& program) override
+    {
+        program.addBlock(*this);
+    }
+
 protected:
     MOCK_CONST_METHOD0(getObjectType, std::string());
 };
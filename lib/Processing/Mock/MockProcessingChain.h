@@ -29,19 +29,34 @@
 
 #include <gmock/gmock.h>
 #include "../Interfaces/IProcessingChain.h"
+#include "../RenderProgram.h"
 
 class MockProcessingChain
     : public IProcessingChain
 {
 public:
+    MOCK_METHOD1(setObserver, void(IObserver* observer));
     MOCK_METHOD2(insertBlock, void(IProcessingBlock* block, unsigned int index));
     MOCK_METHOD1(insertBlock, void(IProcessingBlock* block));
+    MOCK_METHOD1(setHighPrecision, void(bool highPrecision));
+    MOCK_CONST_METHOD0(isHighPrecision, bool());
+    MOCK_METHOD1(setCompiled, void(bool compiled));
+    MOCK_CONST_METHOD0(isCompiled, bool());
+    MOCK_METHOD1(setParallelExecutor, void(IParallelExecutor* executor));
+    MOCK_METHOD1(setColorCorrection, void(const ColorCorrection* colorCorrection));
     MOCK_METHOD0(activate, void());
     MOCK_METHOD0(deactivate, void());
-    MOCK_METHOD2(execute, void(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap));
+    MOCK_METHOD2(execute, bool(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable));
+    MOCK_METHOD2(executeHighPrecision, bool(Processing::TRgbStrip16& strip, const Processing::TNoteToLightTable& noteToLightTable));
     MOCK_CONST_METHOD0(convertToJson, Json());
     MOCK_METHOD1(convertFromJson, void(const Json& converted));
 
+    // Executed as a normal block when compiled, so expectations on execute keep working
+    void compile(RenderProgram& program) override
+    {
+        program.addBlock(*this);
+    }
+
 protected:
     MOCK_CONST_METHOD0(getObjectType, std::string());
 };
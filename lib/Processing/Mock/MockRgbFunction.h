@@ -39,6 +39,47 @@ class MockRgbFunction
 public:
     MOCK_CONST_METHOD2(calculate, Processing::TRgb(const Processing::TNoteState& noteState, Processing::TTime currentTime));
     MOCK_CONST_METHOD0(convertToJson, Json());
+
+    /** Forwards to the mocked single note calculation, so tests can set expectations per note. */
+    void calculateAll(const Processing::TNoteState* noteStates,
+                      std::size_t numNoteStates,
+                      const Processing::TNoteToLight* mappings,
+                      std::size_t numMappings,
+                      Processing::TRgbStrip& strip,
+                      Processing::TTime currentTime) const override
+    {
+        for(std::size_t i = 0; i < numMappings; ++i)
+        {
+            if(mappings[i].note < numNoteStates && mappings[i].light < strip.size())
+            {
+                strip[mappings[i].light] += calculate(noteStates[mappings[i].note], currentTime);
+            }
+        }
+    }
+
+    /** Forwards to the mocked calculation, without fraction. */
+    Processing::TRgb16 calculateHighPrecision(const Processing::TNoteState& noteState,
+                                              Processing::TTime currentTime) const override
+    {
+        return Processing::TRgb16(calculate(noteState, currentTime));
+    }
+
+    void calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                   std::size_t numNoteStates,
+                                   const Processing::TNoteToLight* mappings,
+                                   std::size_t numMappings,
+                                   Processing::TRgbStrip16& strip,
+                                   Processing::TTime currentTime) const override
+    {
+        for(std::size_t i = 0; i < numMappings; ++i)
+        {
+            if(mappings[i].note < numNoteStates && mappings[i].light < strip.size())
+            {
+                strip[mappings[i].light] += calculateHighPrecision(noteStates[mappings[i].note], currentTime);
+            }
+        }
+    }
+
     MOCK_METHOD1(convertFromJson, void(const Json& converted));
 
 protected:
@@ -32,22 +32,95 @@
 #include "ITime.h"
 #include "Json11Helper.h"
 #include "Logging.h"
+#include "RenderProgram.h"
 
-#include <functional>
+#include <algorithm>
 
 #define LOGGING_COMPONENT "NoteRgbSource"
 
+namespace
+{
+
+/**
+ * Let the RGB function render with the precision of the strip.
+ */
+void calculateAll(const IRgbFunction& rgbFunction,
+                  const Processing::TNoteState* noteStates,
+                  std::size_t numNoteStates,
+                  const Processing::TNoteToLight* mappings,
+                  std::size_t numMappings,
+                  Processing::TRgbStrip& strip,
+                  Processing::TTime currentTime)
+{
+    rgbFunction.calculateAll(noteStates, numNoteStates, mappings, numMappings, strip, currentTime);
+}
+
+void calculateAll(const IRgbFunction& rgbFunction,
+                  const Processing::TNoteState* noteStates,
+                  std::size_t numNoteStates,
+                  const Processing::TNoteToLight* mappings,
+                  std::size_t numMappings,
+                  Processing::TRgbStrip16& strip,
+                  Processing::TTime currentTime)
+{
+    rgbFunction.calculateAllHighPrecision(noteStates, numNoteStates, mappings, numMappings, strip, currentTime);
+}
+
+/**
+ * Get the segment of the strip which contains a light.
+ */
+unsigned int getSegment(uint16_t light, std::size_t stripSize, unsigned int numSegments)
+{
+    unsigned int segment(numSegments - 1);
+    while(light < RenderProgram::getSegmentBegin(stripSize, segment, numSegments))
+    {
+        --segment;
+    }
+    return segment;
+}
+
+/**
+ * Check whether blending black changes a light.
+ */
+bool isChangedByBlack(Processing::TBlend blend)
+{
+    return (blend.mode == Processing::BlendReplace) ||
+           (blend.mode == Processing::BlendMultiply) ||
+           (blend.mode == Processing::BlendAlpha);
+}
+
+} /* namespace */
+
 NoteRgbSource::NoteRgbSource(IMidiInput& midiInput,
                              const IRgbFunctionFactory& rgbFunctionFactory,
                              const ITime& time)
     : m_mutex()
-    , m_active()
+    , m_active(false)
     , m_usingPedal(true)
+    , m_blend({Processing::BlendAdd, UINT8_MAX})
     , m_rgbFunctionFactory(rgbFunctionFactory)
     , m_midiInput(midiInput)
     , m_channel(0)
-    , m_scheduler()
+    , m_eventQueue()
+    , m_lastOverflowCount(0)
     , m_noteState()
+    , m_activeNoteMask()
+    , m_activeNotes()
+    , m_numActiveNotes(0)
+    , m_activeMappings()
+    , m_previousMappings()
+    , m_numPreviousMappings(0)
+    , m_numMappings(0)
+    , m_segmentOffsets()
+    , m_idleLights()
+    , m_idleSegmentOffsets()
+    , m_blendChanged(false)
+    , m_renderTime(0)
+    , m_colorMappings()
+    , m_noteColors(IMidiInterface::c_numNotes)
+    , m_previousNoteColors(IMidiInterface::c_numNotes)
+    , m_noteColors16(IMidiInterface::c_numNotes)
+    , m_previousNoteColors16(IMidiInterface::c_numNotes)
     , m_pedalPressed(false)
     , m_rgbFunction(nullptr)
     , m_time(time)
@@ -73,93 +146,373 @@ void NoteRgbSource::deactivate()
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Make sure no notes stay active. Handle remaining events first.
-    m_scheduler.executeAll();
+    handleQueuedEvents();
     for(auto& noteState : m_noteState)
     {
         noteState.pressed = false;
         noteState.sounding = false;
     }
+    m_activeNoteMask.reset();
+    m_numActiveNotes = 0;
 
     m_active = false;
 }
 
-void NoteRgbSource::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap)
+bool NoteRgbSource::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable)
 {
-    m_scheduler.executeAll();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return render(strip, m_noteColors, m_previousNoteColors, noteToLightTable);
+}
+
+bool NoteRgbSource::executeHighPrecision(Processing::TRgbStrip16& strip,
+                                         const Processing::TNoteToLightTable& noteToLightTable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    for(auto pair : noteToLightMap)
+    return render(strip, m_noteColors16, m_previousNoteColors16, noteToLightTable);
+}
+
+void NoteRgbSource::setObserver(IProcessingBlock::IObserver* observer)
+{
+    // Compiled programs don't copy any parameters: they hold a reference to the source, which reads its blend, RGB
+    // function, channel and pedal setting when rendering. So changes don't require compiling again.
+    (void)observer;
+}
+
+void NoteRgbSource::compile(RenderProgram& program)
+{
+    // Notes change every frame, so nothing to copy
+    program.addNotes(*this);
+}
+
+std::unique_lock<std::mutex> NoteRgbSource::beginSegments(const Processing::TNoteToLightTable& noteToLightTable,
+                                                          std::size_t stripSize,
+                                                          unsigned int numSegments)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    prepareRender(noteToLightTable, stripSize, std::min(numSegments, RenderProgram::c_maxSegments));
+
+    return lock;
+}
+
+void NoteRgbSource::renderSegment(Processing::TRgbStrip& strip, unsigned int segment)
+{
+    renderMappings(strip, m_noteColors, segment);
+}
+
+bool NoteRgbSource::endSegments(std::unique_lock<std::mutex> lock)
+{
+    bool changed(finishRender(m_noteColors, m_previousNoteColors));
+    lock.unlock();
+
+    return changed;
+}
+
+template<typename TStrip>
+bool NoteRgbSource::render(TStrip& strip,
+                           TStrip& noteColors,
+                           TStrip& previousNoteColors,
+                           const Processing::TNoteToLightTable& noteToLightTable)
+{
+    prepareRender(noteToLightTable, strip.size(), 1);
+    renderMappings(strip, noteColors, 0);
+
+    return finishRender(noteColors, previousNoteColors);
+}
+
+void NoteRgbSource::prepareRender(const Processing::TNoteToLightTable& noteToLightTable,
+                                  std::size_t stripSize,
+                                  unsigned int numSegments)
+{
+    handleQueuedEvents();
+
+    // Sample time once, so all notes are rendered for the same moment
+    m_renderTime = m_time.getMilliseconds();
+
+    // Find the segment of every mapped light. Only notes in the active set, so idle keys don't cost anything.
+    std::array<uint8_t, IMidiInterface::c_numNotes> segments;
+    m_segmentOffsets.fill(0);
+    if(m_rgbFunction != nullptr)
     {
-        // first: note number, second: light number
-        if(m_rgbFunction != nullptr && pair.second < strip.size())
+        for(std::size_t i = 0; i < m_numActiveNotes; ++i)
         {
-            strip[pair.second] += m_rgbFunction->calculate(m_noteState[pair.first], m_time.getMilliseconds());
+            uint16_t light(noteToLightTable.lights[m_activeNotes[i]]);
+            if(light < stripSize)
+            {
+                segments[i] = getSegment(light, stripSize, numSegments);
+                ++m_segmentOffsets[segments[i] + 1];
+            }
+        }
+    }
+
+    // Turn counts into offsets, and group the mappings by segment
+    for(unsigned int segment = 1; segment <= numSegments; ++segment)
+    {
+        m_segmentOffsets[segment] += m_segmentOffsets[segment - 1];
+    }
+    m_numMappings = m_segmentOffsets[numSegments];
+
+    std::array<std::size_t, RenderProgram::c_maxSegments> next;
+    std::copy(m_segmentOffsets.begin(), m_segmentOffsets.begin() + numSegments, next.begin());
+    for(std::size_t i = 0; (i < m_numActiveNotes) && (m_numMappings != 0); ++i)
+    {
+        uint8_t note(m_activeNotes[i]);
+        uint16_t light(noteToLightTable.lights[note]);
+        if(light < stripSize)
+        {
+            std::size_t position(next[segments[i]]++);
+            m_activeMappings[position] = {note, light};
+            m_colorMappings[position] = {note, static_cast<uint16_t>(position)};
+        }
+    }
+
+    // Idle notes are black. Unless that leaves their lights unchanged, they are blended too, so a note which decays
+    // to black and retires doesn't make its light jump.
+    m_idleSegmentOffsets.fill(0);
+    if(!isChangedByBlack(m_blend))
+    {
+        return;
+    }
+
+    std::size_t numIdleLights(0);
+    for(const auto& mapping : noteToLightTable)
+    {
+        bool rendered((m_rgbFunction != nullptr) && m_activeNoteMask.test(mapping.note));
+        if(!rendered && (mapping.light < stripSize))
+        {
+            segments[numIdleLights++] = getSegment(mapping.light, stripSize, numSegments);
+            ++m_idleSegmentOffsets[segments[numIdleLights - 1] + 1];
+        }
+    }
+    for(unsigned int segment = 1; segment <= numSegments; ++segment)
+    {
+        m_idleSegmentOffsets[segment] += m_idleSegmentOffsets[segment - 1];
+    }
+
+    std::copy(m_idleSegmentOffsets.begin(), m_idleSegmentOffsets.begin() + numSegments, next.begin());
+    std::size_t i(0);
+    for(const auto& mapping : noteToLightTable)
+    {
+        bool rendered((m_rgbFunction != nullptr) && m_activeNoteMask.test(mapping.note));
+        if(!rendered && (mapping.light < stripSize))
+        {
+            m_idleLights[next[segments[i++]]++] = mapping.light;
         }
     }
 }
 
-void NoteRgbSource::onNoteChange(uint8_t channel, uint8_t number, uint8_t velocity, bool on)
+template<typename TStrip>
+void NoteRgbSource::renderMappings(TStrip& strip, TStrip& noteColors, unsigned int segment)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    typedef typename TStrip::value_type TColor;
 
-    if(!m_active)
+    for(std::size_t i = m_idleSegmentOffsets[segment]; i < m_idleSegmentOffsets[segment + 1]; ++i)
+    {
+        auto& light(strip[m_idleLights[i]]);
+        light = Processing::blendColor(light, TColor(), m_blend);
+    }
+
+    const std::size_t begin(m_segmentOffsets[segment]), end(m_segmentOffsets[segment + 1]);
+    if(begin == end)
     {
         return;
     }
 
-    auto fn = [=]() {
-        if(channel == m_channel)
+    // Let the function render into the per-note buffer first, to be able to detect changes
+    std::fill(noteColors.begin() + begin, noteColors.begin() + end, TColor());
+    calculateAll(*m_rgbFunction,
+                 m_noteState.data(), m_noteState.size(),
+                 m_colorMappings.data() + begin, end - begin,
+                 noteColors, m_renderTime);
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+        auto& light(strip[m_activeMappings[i].light]);
+        light = Processing::blendColor(light, noteColors[i], m_blend);
+    }
+}
+
+template<typename TStrip>
+bool NoteRgbSource::finishRender(TStrip& noteColors, TStrip& previousNoteColors)
+{
+    retireActiveNotes(noteColors);
+
+    // The idle lights follow from the active ones
+    bool changed(m_blendChanged || (m_numMappings != m_numPreviousMappings));
+    m_blendChanged = false;
+    for(std::size_t i = 0; (i < m_numMappings) && !changed; ++i)
+    {
+        changed = (m_activeMappings[i] != m_previousMappings[i]) || (noteColors[i] != previousNoteColors[i]);
+    }
+
+    if(changed)
+    {
+        std::copy(m_activeMappings.begin(), m_activeMappings.begin() + m_numMappings, m_previousMappings.begin());
+        m_numPreviousMappings = m_numMappings;
+        noteColors.swap(previousNoteColors);
+    }
+
+    return changed;
+}
+
+void NoteRgbSource::addActiveNote(uint8_t note)
+{
+    if(!m_activeNoteMask.test(note))
+    {
+        m_activeNoteMask.set(note);
+        m_activeNotes[m_numActiveNotes++] = note;
+    }
+}
+
+template<typename TStrip>
+void NoteRgbSource::retireActiveNotes(TStrip& noteColors)
+{
+    typedef typename TStrip::value_type TColor;
+
+    std::bitset<IMidiInterface::c_numNotes> litNotes;
+    for(std::size_t i = 0; i < m_numMappings; ++i)
+    {
+        if(noteColors[i] != TColor())
         {
-            if(on)
-            {
-                m_noteState[number].pressDownVelocity = velocity;
-                m_noteState[number].noteOnTimeStamp = m_time.getMilliseconds();
-                m_noteState[number].pressed = true;
-                m_noteState[number].sounding = true;
-            }
-            else
-            {
-                m_noteState[number].pressed = false;
-                if(!m_pedalPressed)
-                {
-                    m_noteState[number].sounding = false;
-                }
-            }
+            litNotes.set(m_activeMappings[i].note);
+        }
+    }
+
+    std::size_t i(0);
+    while(i < m_numActiveNotes)
+    {
+        uint8_t note(m_activeNotes[i]);
+        if(!m_noteState[note].sounding && !litNotes.test(note))
+        {
+            // Replace by the last one, and check that on the next iteration
+            m_activeNoteMask.reset(note);
+            m_activeNotes[i] = m_activeNotes[--m_numActiveNotes];
+        }
+        else
+        {
+            ++i;
         }
-    };
-    m_scheduler.schedule(fn);
+    }
+
+    // Retired notes rendered black, which is how idle notes are rendered too
+    std::size_t numMappings(0);
+    for(std::size_t position = 0; position < m_numMappings; ++position)
+    {
+        if(m_activeNoteMask.test(m_activeMappings[position].note))
+        {
+            m_activeMappings[numMappings] = m_activeMappings[position];
+            noteColors[numMappings++] = noteColors[position];
+        }
+    }
+    m_numMappings = numMappings;
 }
 
-void NoteRgbSource::onControlChange(uint8_t channel, IMidiInput::TControllerNumber number, uint8_t value)
+void NoteRgbSource::handleQueuedEvents()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    TEvent event;
+    while(m_eventQueue.pop(event))
+    {
+        handleEvent(event);
+    }
 
-    if(!m_active)
+    uint32_t overflowCount(m_eventQueue.getOverflowCount());
+    if(overflowCount != m_lastOverflowCount)
+    {
+        LOG_WARNING_PARAMS("event queue overflow, %u events dropped", overflowCount - m_lastOverflowCount);
+        m_lastOverflowCount = overflowCount;
+    }
+}
+
+void NoteRgbSource::handleEvent(const TEvent& event)
+{
+    if(event.channel != m_channel)
     {
         return;
     }
 
-    // Don't cause scheduling overhead when it's an unimportant controller number.
-    // Channel check must be scheduled as it uses a member
-    if(number == IMidiInterface::DAMPER_PEDAL)
+    switch(event.type)
     {
-        auto fn = [=]() {
-            if(channel == m_channel && m_usingPedal)
+        case TEvent::NOTE_ON:
+            m_noteState[event.number].pressDownVelocity = event.value;
+            m_noteState[event.number].noteOnTimeStamp = event.time;
+            m_noteState[event.number].pressed = true;
+            m_noteState[event.number].sounding = true;
+            addActiveNote(event.number);
+            break;
+
+        case TEvent::NOTE_OFF:
+            m_noteState[event.number].pressed = false;
+            if(!m_pedalPressed)
             {
-                m_pedalPressed = (value >= 64);
+                m_noteState[event.number].sounding = false;
+            }
+            break;
+
+        case TEvent::PEDAL:
+            if(m_usingPedal)
+            {
+                m_pedalPressed = (event.value >= 64);
                 if(!m_pedalPressed)
                 {
-                    // Stop all notes which are sounding due to pedal only
-                    for(int note = 0; note < IMidiInterface::c_numNotes; ++note)
+                    // Stop all notes which are sounding due to pedal only. Others are not sounding anyway.
+                    for(std::size_t i = 0; i < m_numActiveNotes; ++i)
                     {
-                        if(!m_noteState[note].pressed)
+                        auto& noteState(m_noteState[m_activeNotes[i]]);
+                        if(!noteState.pressed)
                         {
-                            m_noteState[note].sounding = false;
+                            noteState.sounding = false;
                         }
                     }
                 }
             }
-        };
-        m_scheduler.schedule(fn);
+            break;
+    }
+}
+
+void NoteRgbSource::onNoteChange(uint8_t channel, uint8_t number, uint8_t velocity, bool on)
+{
+    // Input didn't provide an arrival time, so take it now
+    onTimedNoteChange(channel, number, velocity, on, m_time.getMilliseconds());
+}
+
+void NoteRgbSource::onTimedNoteChange(uint8_t channel, uint8_t number, uint8_t velocity, bool on, uint32_t arrivalTime)
+{
+    // Called from the MIDI input context. Only touch the queue and atomics here.
+    if(!m_active)
+    {
+        return;
+    }
+
+    TEvent event;
+    event.type = on ? TEvent::NOTE_ON : TEvent::NOTE_OFF;
+    event.channel = channel;
+    event.number = number;
+    event.value = velocity;
+    event.time = arrivalTime;
+    m_eventQueue.push(event);
+}
+
+void NoteRgbSource::onControlChange(uint8_t channel, IMidiInput::TControllerNumber number, uint8_t value)
+{
+    // Called from the MIDI input context. Only touch the queue and atomics here.
+    if(!m_active)
+    {
+        return;
+    }
+
+    // Don't fill the queue with unimportant controller numbers.
+    // Channel check is done when handling, as it uses a member
+    if(number == IMidiInterface::DAMPER_PEDAL)
+    {
+        TEvent event;
+        event.type = TEvent::PEDAL;
+        event.channel = channel;
+        event.number = number;
+        event.value = value;
+        event.time = 0;
+        m_eventQueue.push(event);
     }
 }
 
@@ -206,6 +559,24 @@ void NoteRgbSource::setUsingPedal(bool usingPedal)
     m_usingPedal = usingPedal;
 }
 
+Processing::TBlend NoteRgbSource::getBlend() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_blend;
+}
+
+void NoteRgbSource::setBlend(Processing::TBlend blend)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(blend != m_blend)
+    {
+        m_blend = blend;
+        m_blendChanged = true;
+    }
+}
+
 void NoteRgbSource::setRgbFunction(IRgbFunction* rgbFunction)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -223,6 +594,7 @@ Json NoteRgbSource::convertToJson() const
     json[IJsonConvertible::c_objectTypeKey] = getObjectType();
     json[c_usingPedalJsonKey] = m_usingPedal;
     json[c_channelJsonKey] = m_channel;
+    Processing::addBlendToJson(m_blend, json);
     if(m_rgbFunction != nullptr)
     {
         json[c_rgbFunctionJsonKey] = m_rgbFunction->convertToJson();
@@ -238,6 +610,8 @@ void NoteRgbSource::convertFromJson(const Json& converted)
     Json11Helper helper(__PRETTY_FUNCTION__, converted);
     helper.getItemIfPresent(c_usingPedalJsonKey, m_usingPedal);
     helper.getItemIfPresent(c_channelJsonKey, m_channel);
+    Processing::getBlendFromJson(converted, m_blend);
+    m_blendChanged = true;
 
     Json::object convertedRgbFunction;
     if(helper.getItemIfPresent(c_rgbFunctionJsonKey, convertedRgbFunction))
@@ -30,11 +30,15 @@
 #define PROCESSING_NOTERGBSOURCE_H_
 
 #include "IMidiInput.h"
-#include "Scheduler.h"
+#include "SpscQueue.h"
 #include "IProcessingBlock.h"
+#include "RenderProgram.h"
+#include "Blend.h"
 
+#include <atomic>
 #include <mutex>
 #include <array>
+#include <bitset>
 
 class IRgbFunction;
 class IRgbFunctionFactory;
@@ -71,9 +75,13 @@ public:
     NoteRgbSource& operator=(NoteRgbSource&) = delete;
 
     // IProcessingBlock implementation.
+    void setObserver(IProcessingBlock::IObserver* observer) override;
     void activate() override;
     void deactivate() override;
-    void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap) override;
+    bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) override;
+    bool executeHighPrecision(Processing::TRgbStrip16& strip,
+                              const Processing::TNoteToLightTable& noteToLightTable) override;
+    void compile(RenderProgram& program) override;
     Json convertToJson() const override;
     void convertFromJson(const Json& converted) override;
 
@@ -82,10 +90,56 @@ public:
     bool isUsingPedal() const;
     void setUsingPedal(bool usingPedal);
 
+    /**
+     * Get how the note colors are combined with the strip. Defaults to adding.
+     */
+    Processing::TBlend getBlend() const;
+
+    /**
+     * Set how the note colors are combined with the strip.
+     */
+    void setBlend(Processing::TBlend blend);
+
     void setRgbFunction(IRgbFunction* rgbFunction);
 
+    /**
+     * Start an execution which is split into segments of the strip, to render the segments concurrently. Must be
+     * followed by @ref renderSegment for every segment, and then by @ref endSegments. Together, these are equivalent to
+     * @ref execute.
+     *
+     * @param[in]   noteToLightTable    To map from note number to light number.
+     * @param[in]   stripSize           Size of the strip.
+     * @param[in]   numSegments         Number of segments, at most @ref RenderProgram::c_maxSegments. See
+     *                                  @ref RenderProgram::getSegmentBegin for their bounds.
+     *
+     * @return  The lock of the source, to hold until the execution is finished with @ref endSegments.
+     */
+    std::unique_lock<std::mutex> beginSegments(const Processing::TNoteToLightTable& noteToLightTable,
+                                               std::size_t stripSize,
+                                               unsigned int numSegments);
+
+    /**
+     * Render the notes which map to a segment of the strip. Only writes lights within the segment, so different
+     * segments can be rendered concurrently.
+     *
+     * @param[in, out]  strip   The strip to add the note colors to.
+     * @param[in]       segment The segment to render.
+     */
+    void renderSegment(Processing::TRgbStrip& strip, unsigned int segment);
+
+    /**
+     * Finish an execution which is split into segments.
+     *
+     * @param[in]   lock    The lock returned by @ref beginSegments, which is released.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
+     */
+    bool endSegments(std::unique_lock<std::mutex> lock);
+
     // IMidiInput::IObserver implementation
     void onNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on) override;
+    void onTimedNoteChange(uint8_t channel, uint8_t pitch, uint8_t velocity, bool on, uint32_t arrivalTime) override;
     void onControlChange(uint8_t channel, IMidiInput::TControllerNumber controller, uint8_t value) override;
     void onProgramChange(uint8_t channel, uint8_t program) override;
     void onChannelPressureChange(uint8_t channel, uint8_t value) override;
@@ -101,15 +155,101 @@ private:
     static constexpr const char* c_channelJsonKey       = "channel";
     static constexpr const char* c_rgbFunctionJsonKey   = "rgbFunction";
 
-    /** Mutex to protect the members. */
+    /** Maximum number of MIDI events which can be queued between two executions. */
+    static constexpr std::size_t c_eventQueueSize = 128;
+
+    /** Record of a MIDI event, queued by the MIDI input and handled during execution. */
+    struct TEvent
+    {
+        enum TType : uint8_t
+        {
+            NOTE_ON,
+            NOTE_OFF,
+            PEDAL
+        };
+
+        TType type;
+        uint8_t channel;
+        uint8_t number;
+        uint8_t value;
+
+        /** Arrival time of the event. Only used for note on. */
+        Processing::TTime time;
+    };
+
+    /**
+     * Handle all queued events. Must be called with the mutex held.
+     */
+    void handleQueuedEvents();
+
+    /**
+     * Apply an event to the note and pedal state.
+     */
+    void handleEvent(const TEvent& event);
+
+    /**
+     * Add a note to the active set, if not already in it.
+     */
+    void addActiveNote(uint8_t note);
+
+    /**
+     * Remove notes from the active set which are not sounding anymore, and for which the RGB function rendered black.
+     * Reuses the colors of the current execution, so the function isn't calculated again. Released notes which are
+     * not mapped to the strip are removed right away, as they don't render anything. The mappings of removed notes are
+     * dropped, as they rendered the same as idle notes.
+     *
+     * @param[in, out]  noteColors  The note colors of the current execution, at the positions of the mappings.
+     */
+    template<typename TStrip>
+    void retireActiveNotes(TStrip& noteColors);
+
+    /**
+     * Execute with either precision. Must be called with the mutex held.
+     *
+     * @param[in, out]  strip               The strip to add the note colors to.
+     * @param[in, out]  noteColors          Buffer for the note colors.
+     * @param[in, out]  previousNoteColors  The note colors of the previous execution with the same precision.
+     * @param[in]       noteToLightTable    To map from note number to light number.
+     */
+    template<typename TStrip>
+    bool render(TStrip& strip,
+                TStrip& noteColors,
+                TStrip& previousNoteColors,
+                const Processing::TNoteToLightTable& noteToLightTable);
+
+    /**
+     * First phase of rendering: handle the events, and collect the mappings of the active notes, grouped by segment.
+     * Must be called with the mutex held.
+     */
+    void prepareRender(const Processing::TNoteToLightTable& noteToLightTable,
+                       std::size_t stripSize,
+                       unsigned int numSegments);
+
+    /**
+     * Second phase of rendering: render the notes of a segment.
+     */
+    template<typename TStrip>
+    void renderMappings(TStrip& strip, TStrip& noteColors, unsigned int segment);
+
+    /**
+     * Last phase of rendering: detect changes, retire notes which went dark, and keep the result for the next
+     * execution. Must be called with the mutex held.
+     */
+    template<typename TStrip>
+    bool finishRender(TStrip& noteColors, TStrip& previousNoteColors);
+
+    /** Mutex to protect the members. Not taken by the MIDI observer callbacks. */
     mutable std::mutex m_mutex;
 
     /** Whether this block is active. */
-    bool m_active;
+    std::atomic<bool> m_active;
 
     /** Indicates whether pedal should be used. */
     bool m_usingPedal;
 
+    /** How the note colors are combined with the strip. */
+    Processing::TBlend m_blend;
+
     /** Reference to the RGB function factory. */
     const IRgbFunctionFactory& m_rgbFunctionFactory;
 
@@ -119,12 +259,69 @@ private:
     /** MIDI channel to listen to. */
     uint8_t m_channel;
 
-    /** Scheduler to decouple callbacks. */
-    Scheduler m_scheduler;
+    /** Queue to decouple the MIDI input from execution. */
+    SpscQueue<TEvent, c_eventQueueSize> m_eventQueue;
+
+    /** Queue overflow count at the last check, to detect new overflows. */
+    uint32_t m_lastOverflowCount;
 
     /** Actual note states. */
     std::array<Processing::TNoteState, IMidiInterface::c_numNotes> m_noteState;
 
+    /** Notes which are sounding, or which may still produce output after they stopped sounding. */
+    std::bitset<IMidiInterface::c_numNotes> m_activeNoteMask;
+
+    /** Dense list of the notes in @ref m_activeNoteMask, in no particular order. */
+    std::array<uint8_t, IMidiInterface::c_numNotes> m_activeNotes;
+
+    /** Number of valid entries in @ref m_activeNotes. */
+    std::size_t m_numActiveNotes;
+
+    /** Mappings of the active notes, collected during execution. */
+    std::array<Processing::TNoteToLight, IMidiInterface::c_numNotes> m_activeMappings;
+
+    /** Mappings of the active notes at the previous execution. */
+    std::array<Processing::TNoteToLight, IMidiInterface::c_numNotes> m_previousMappings;
+
+    /** Number of valid entries in @ref m_previousMappings. */
+    std::size_t m_numPreviousMappings;
+
+    /** Number of valid entries in @ref m_activeMappings. */
+    std::size_t m_numMappings;
+
+    /** Start of the mappings of every segment in @ref m_activeMappings, and the end of the last segment. */
+    std::array<std::size_t, RenderProgram::c_maxSegments + 1> m_segmentOffsets;
+
+    /**
+     * Lights of the notes which are not rendered, grouped by segment. Blended with black, but only collected for blend
+     * modes in which that changes the lights.
+     */
+    std::array<uint16_t, IMidiInterface::c_numNotes> m_idleLights;
+
+    /** Start of the lights of every segment in @ref m_idleLights, and the end of the last segment. */
+    std::array<std::size_t, RenderProgram::c_maxSegments + 1> m_idleSegmentOffsets;
+
+    /** Whether the blend changed since the last execution. */
+    bool m_blendChanged;
+
+    /** Time for which the notes are rendered. */
+    Processing::TTime m_renderTime;
+
+    /** Mappings from active note to position in @ref m_noteColors, to let the RGB function render there. */
+    std::array<Processing::TNoteToLight, IMidiInterface::c_numNotes> m_colorMappings;
+
+    /** Output colors of the active notes, in the order of @ref m_activeMappings. */
+    Processing::TRgbStrip m_noteColors;
+
+    /** Output colors of the active notes at the previous execution. */
+    Processing::TRgbStrip m_previousNoteColors;
+
+    /** Like @ref m_noteColors, for high precision execution. */
+    Processing::TRgbStrip16 m_noteColors16;
+
+    /** Like @ref m_previousNoteColors, for high precision execution. */
+    Processing::TRgbStrip16 m_previousNoteColors16;
+
     /** Actual pedal pressed state. */
     bool m_pedalPressed;
 
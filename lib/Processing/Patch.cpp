@@ -38,6 +38,7 @@ Patch::Patch(const IProcessingBlockFactory& processingBlockFactory)
     , m_name("Untitled Patch")
     , m_processingChain(processingBlockFactory.createProcessingChain())
     , m_processingBlockFactory(processingBlockFactory)
+    , m_observer(nullptr)
 {
 }
 
@@ -46,6 +47,27 @@ Patch::~Patch()
     delete m_processingChain;
 }
 
+void Patch::setObserver(IObserver* observer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_observer = observer;
+}
+
+void Patch::notifyBankAndProgramChange() const
+{
+    IObserver* observer;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        observer = m_observer;
+    }
+
+    if(observer != nullptr)
+    {
+        observer->onBankAndProgramChange(*this);
+    }
+}
+
 IProcessingChain& Patch::getProcessingChain() const
 {
     return *m_processingChain;
@@ -72,27 +94,31 @@ Json Patch::convertToJson() const
 
 void Patch::convertFromJson(const Json& converted)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    // Get items specific for Patch
-    Json11Helper helper(__PRETTY_FUNCTION__, converted);
-    helper.getItemIfPresent(c_hasBankAndProgramJsonKey, m_hasBankAndProgram);
-    helper.getItemIfPresent(c_programJsonKey, m_program);
-    helper.getItemIfPresent(c_bankJsonKey, m_bank);
-    helper.getItemIfPresent(c_nameJsonKey, m_name);
-    
-    // Get processing chain
-    Json::object convertedProcessingChain;
-    if(helper.getItemIfPresent(c_processingChainJsonKey, convertedProcessingChain))
-    {
-        m_processingChain->convertFromJson(convertedProcessingChain);
-    }
-    else
     {
-        // Reset to default.
-        delete m_processingChain;
-        m_processingChain = m_processingBlockFactory.createProcessingChain();
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Get items specific for Patch
+        Json11Helper helper(__PRETTY_FUNCTION__, converted);
+        helper.getItemIfPresent(c_hasBankAndProgramJsonKey, m_hasBankAndProgram);
+        helper.getItemIfPresent(c_programJsonKey, m_program);
+        helper.getItemIfPresent(c_bankJsonKey, m_bank);
+        helper.getItemIfPresent(c_nameJsonKey, m_name);
+    
+        // Get processing chain
+        Json::object convertedProcessingChain;
+        if(helper.getItemIfPresent(c_processingChainJsonKey, convertedProcessingChain))
+        {
+            m_processingChain->convertFromJson(convertedProcessingChain);
+        }
+        else
+        {
+            // Reset to default.
+            delete m_processingChain;
+            m_processingChain = m_processingBlockFactory.createProcessingChain();
+        }
     }
+
+    notifyBankAndProgramChange();
 }
 
 std::string Patch::getObjectType() const
@@ -110,9 +136,9 @@ void Patch::deactivate()
     m_processingChain->deactivate();
 }
 
-void Patch::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap)
+bool Patch::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable)
 {
-    m_processingChain->execute(strip, noteToLightMap);
+    return m_processingChain->execute(strip, noteToLightTable);
 }
 
 uint8_t Patch::getBank() const
@@ -124,9 +150,12 @@ uint8_t Patch::getBank() const
 
 void Patch::setBank(uint8_t bank)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bank = bank;
+    }
 
-    m_bank = bank;
+    notifyBankAndProgramChange();
 }
 
 bool Patch::hasBankAndProgram() const
@@ -145,17 +174,23 @@ uint8_t Patch::getProgram() const
 
 void Patch::clearBankAndProgram()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasBankAndProgram = false;
+    }
 
-    m_hasBankAndProgram = false;
+    notifyBankAndProgramChange();
 }
 
 void Patch::setProgram(uint8_t program)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_program = program;
+        m_hasBankAndProgram = true;
+    }
 
-    m_program = program;
-    m_hasBankAndProgram = true;
+    notifyBankAndProgramChange();
 }
 
 std::string Patch::getName() const
@@ -69,10 +69,11 @@ public:
     virtual void convertFromJson(const Json& converted);
 
     // IPatch implementation
+    virtual void setObserver(IObserver* observer);
     virtual IProcessingChain& getProcessingChain() const;
     virtual void activate();
     virtual void deactivate();
-    virtual void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap);
+    virtual bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable);
     virtual bool hasBankAndProgram() const;
     virtual uint8_t getBank() const;
     virtual void setBank(uint8_t bank);
@@ -113,6 +114,12 @@ private:
     IProcessingChain* m_processingChain;
 
     const IProcessingBlockFactory& m_processingBlockFactory;
+
+    /** The observer, if any. */
+    IObserver* m_observer;
+
+    /** Tell the observer that the bank or program number may have changed. Must be called without the mutex held. */
+    void notifyBankAndProgramChange() const;
 };
 
 #endif /* PROCESSING_PATCH_H_ */
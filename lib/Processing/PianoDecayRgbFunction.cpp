@@ -37,8 +37,97 @@ Processing::TRgb PianoDecayRgbFunction::calculate(const Processing::TNoteState&
         return startColor;
     }
 
-    uint32_t soundingTime(currentTime - noteState.noteOnTimeStamp);
+    // Round to the nearest table entry. The curve ends at zero, so anything beyond the table is off.
+    // Note on may be stamped slightly after the current time was sampled, which must not count as a long time ago
+    uint32_t soundingTime(Processing::getElapsedTime(noteState.noteOnTimeStamp, currentTime));
+    uint32_t index((soundingTime + c_intensityTableResolutionMs / 2) / c_intensityTableResolutionMs);
+    if(index >= c_intensityTableSize)
+    {
+        return Processing::TRgb{0, 0, 0};
+    }
+
+    uint32_t intensity(getIntensityTable()[index]);
+    return Processing::TRgb(
+        static_cast<uint8_t>((startColor.r * intensity) >> c_intensityFractionBits),
+        static_cast<uint8_t>((startColor.g * intensity) >> c_intensityFractionBits),
+        static_cast<uint8_t>((startColor.b * intensity) >> c_intensityFractionBits)
+    );
+}
 
+void PianoDecayRgbFunction::calculateAll(const Processing::TNoteState* noteStates,
+                                           std::size_t numNoteStates,
+                                           const Processing::TNoteToLight* mappings,
+                                           std::size_t numMappings,
+                                           Processing::TRgbStrip& strip,
+                                           Processing::TTime currentTime) const
+{
+    // Qualified call, so it can be inlined instead of dispatched per note
+    for(std::size_t i = 0; i < numMappings; ++i)
+    {
+        const auto& mapping(mappings[i]);
+        if(mapping.note < numNoteStates && mapping.light < strip.size())
+        {
+            strip[mapping.light] += PianoDecayRgbFunction::calculate(noteStates[mapping.note], currentTime);
+        }
+    }
+}
+
+Processing::TRgb16 PianoDecayRgbFunction::calculateHighPrecision(const Processing::TNoteState& noteState,
+                                                                 Processing::TTime currentTime) const
+{
+    auto startColor(LinearRgbFunction::calculateHighPrecision(noteState, currentTime));
+    if(startColor == Processing::TRgb16())
+    {
+        return startColor;
+    }
+
+    uint32_t soundingTime(Processing::getElapsedTime(noteState.noteOnTimeStamp, currentTime));
+    uint32_t index((soundingTime + c_intensityTableResolutionMs / 2) / c_intensityTableResolutionMs);
+    if(index >= c_intensityTableSize)
+    {
+        return Processing::TRgb16();
+    }
+
+    static_assert(c_intensityFractionBits == 15, "scaling expects Q15 intensities");
+    return startColor.scale(getIntensityTable()[index]);
+}
+
+void PianoDecayRgbFunction::calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                                      std::size_t numNoteStates,
+                                                      const Processing::TNoteToLight* mappings,
+                                                      std::size_t numMappings,
+                                                      Processing::TRgbStrip16& strip,
+                                                      Processing::TTime currentTime) const
+{
+    // Qualified call, so it can be inlined instead of dispatched per note
+    for(std::size_t i = 0; i < numMappings; ++i)
+    {
+        const auto& mapping(mappings[i]);
+        if(mapping.note < numNoteStates && mapping.light < strip.size())
+        {
+            strip[mapping.light] += PianoDecayRgbFunction::calculateHighPrecision(noteStates[mapping.note],
+                                                                                  currentTime);
+        }
+    }
+}
+
+const PianoDecayRgbFunction::TIntensityTable& PianoDecayRgbFunction::getIntensityTable()
+{
+    static const TIntensityTable table = []() {
+        TIntensityTable initialTable;
+        for(uint32_t index = 0; index < c_intensityTableSize; ++index)
+        {
+            float factor(calculateIntensityFactor(index * c_intensityTableResolutionMs));
+            initialTable[index] = static_cast<uint16_t>(factor * (1u << c_intensityFractionBits) + 0.5f);
+        }
+        return initialTable;
+    }();
+
+    return table;
+}
+
+float PianoDecayRgbFunction::calculateIntensityFactor(uint32_t soundingTime)
+{
     float timeProgress, decayFactor, startIntensityFactor;
     if(soundingTime < c_fastDecayDurationMs)
     {
@@ -55,8 +144,7 @@ Processing::TRgb PianoDecayRgbFunction::calculate(const Processing::TNoteState&
         startIntensityFactor = 1.0f - c_fastDecayFactor;
     }
 
-    float intensityFactor(startIntensityFactor - (timeProgress * decayFactor));
-    return startColor * intensityFactor;
+    return startIntensityFactor - (timeProgress * decayFactor);
 }
 
 std::string PianoDecayRgbFunction::getObjectType() const
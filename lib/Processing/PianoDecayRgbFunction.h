@@ -29,10 +29,15 @@
 
 #include "LinearRgbFunction.h"
 
+#include <array>
 #include <stdint.h>
 
 /**
  * RGB function which slowly dims sounding notes to visually mimic the sound of piano strings.
+ *
+ * The decay curve is precalculated into a table of Q15 intensity factors at @ref c_intensityTableResolutionMs
+ * resolution, shared by all instances. Compared to evaluating the curve in floating point, each color channel may
+ * differ by at most 1.
  */
 class PianoDecayRgbFunction : public LinearRgbFunction
 {
@@ -48,6 +53,20 @@ public:
 
     // IRgbFunction implementation
     Processing::TRgb calculate(const Processing::TNoteState& noteState, Processing::TTime currentTime) const override;
+    void calculateAll(const Processing::TNoteState* noteStates,
+                      std::size_t numNoteStates,
+                      const Processing::TNoteToLight* mappings,
+                      std::size_t numMappings,
+                      Processing::TRgbStrip& strip,
+                      Processing::TTime currentTime) const override;
+    Processing::TRgb16 calculateHighPrecision(const Processing::TNoteState& noteState,
+                                              Processing::TTime currentTime) const override;
+    void calculateAllHighPrecision(const Processing::TNoteState* noteStates,
+                                   std::size_t numNoteStates,
+                                   const Processing::TNoteToLight* mappings,
+                                   std::size_t numMappings,
+                                   Processing::TRgbStrip16& strip,
+                                   Processing::TTime currentTime) const override;
 
 protected:
     // IRgbFunction implementation
@@ -59,6 +78,23 @@ private:
 
     static constexpr uint32_t c_slowDecayDurationMs = 13800;
     static constexpr float c_slowDecayFactor = 0.5f;
+
+    static constexpr uint32_t c_intensityTableResolutionMs = 4;
+    static constexpr uint32_t c_intensityTableSize =
+        (c_fastDecayDurationMs + c_slowDecayDurationMs) / c_intensityTableResolutionMs;
+    static constexpr unsigned int c_intensityFractionBits = 15;
+
+    typedef std::array<uint16_t, c_intensityTableSize> TIntensityTable;
+
+    /**
+     * Get the intensity table, which is calculated on first use.
+     */
+    static const TIntensityTable& getIntensityTable();
+
+    /**
+     * Calculate the intensity factor for the given sounding time, in floating point.
+     */
+    static float calculateIntensityFactor(uint32_t soundingTime);
 };
 
 #endif /* LIB_PROCESSING_PIANODECAYRGBFUNCTION_H_ */
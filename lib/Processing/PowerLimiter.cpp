@@ -0,0 +1,184 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "PowerLimiter.h"
+#include "Json11Helper.h"
+
+constexpr uint16_t PowerLimiter::c_unityScale;
+constexpr uint16_t PowerLimiter::c_recoveryStep;
+
+PowerLimiter::PowerLimiter()
+    : m_budget(0)
+    , m_redCurrent(20)
+    , m_greenCurrent(20)
+    , m_blueCurrent(20)
+    , m_idleCurrent(0)
+    , m_estimatedCurrent(0)
+    , m_requiredScale(c_unityScale)
+    , m_scale(c_unityScale)
+{
+}
+
+void PowerLimiter::setBudget(uint32_t milliamps)
+{
+    m_budget = milliamps;
+}
+
+void PowerLimiter::setModel(uint16_t red, uint16_t green, uint16_t blue, uint16_t idle)
+{
+    m_redCurrent = red;
+    m_greenCurrent = green;
+    m_blueCurrent = blue;
+    m_idleCurrent = idle;
+}
+
+uint32_t PowerLimiter::getBudget() const
+{
+    return m_budget;
+}
+
+uint16_t PowerLimiter::getRedCurrent() const
+{
+    return m_redCurrent;
+}
+
+uint16_t PowerLimiter::getGreenCurrent() const
+{
+    return m_greenCurrent;
+}
+
+uint16_t PowerLimiter::getBlueCurrent() const
+{
+    return m_blueCurrent;
+}
+
+uint16_t PowerLimiter::getIdleCurrent() const
+{
+    return m_idleCurrent;
+}
+
+bool PowerLimiter::isEnabled() const
+{
+    return m_budget != 0;
+}
+
+void PowerLimiter::limit(Processing::TRgbStrip& strip)
+{
+    if(!isEnabled())
+    {
+        return;
+    }
+
+    uint32_t sumR(0), sumG(0), sumB(0);
+    for(const auto& color : strip)
+    {
+        sumR += color.r;
+        sumG += color.g;
+        sumB += color.b;
+    }
+
+    // Channel current, multiplied by the maximum channel value to stay in integers
+    uint64_t channelCurrent(static_cast<uint64_t>(sumR) * m_redCurrent +
+                            static_cast<uint64_t>(sumG) * m_greenCurrent +
+                            static_cast<uint64_t>(sumB) * m_blueCurrent);
+    uint32_t idleCurrent(static_cast<uint32_t>(m_idleCurrent * strip.size()));
+    m_estimatedCurrent = idleCurrent + static_cast<uint32_t>(channelCurrent / UINT8_MAX);
+
+    if(m_estimatedCurrent <= m_budget)
+    {
+        m_requiredScale = c_unityScale;
+    }
+    else if(idleCurrent >= m_budget)
+    {
+        // Only the channel current can be scaled
+        m_requiredScale = 0;
+    }
+    else
+    {
+        // Channel current exceeds the remaining budget here, so the result is below unity
+        m_requiredScale = static_cast<uint16_t>(
+            ((static_cast<uint64_t>(m_budget - idleCurrent) * UINT8_MAX) << 8) / channelCurrent);
+    }
+
+    if(m_requiredScale < m_scale)
+    {
+        m_scale = m_requiredScale;
+    }
+    else
+    {
+        m_scale = std::min<uint16_t>(m_requiredScale, m_scale + c_recoveryStep);
+    }
+
+    if(m_scale < c_unityScale)
+    {
+        for(auto& color : strip)
+        {
+            color.r = static_cast<uint8_t>((color.r * m_scale) >> 8);
+            color.g = static_cast<uint8_t>((color.g * m_scale) >> 8);
+            color.b = static_cast<uint8_t>((color.b * m_scale) >> 8);
+        }
+    }
+}
+
+uint32_t PowerLimiter::getEstimatedCurrent() const
+{
+    return m_estimatedCurrent;
+}
+
+bool PowerLimiter::isRecovering() const
+{
+    return m_scale < m_requiredScale;
+}
+
+Json PowerLimiter::convertToJson() const
+{
+    Json::object json;
+    json[IJsonConvertible::c_objectTypeKey] = getObjectType();
+    json[c_budgetJsonKey] = static_cast<int>(m_budget);
+    json[c_rCurrentJsonKey] = m_redCurrent;
+    json[c_gCurrentJsonKey] = m_greenCurrent;
+    json[c_bCurrentJsonKey] = m_blueCurrent;
+    json[c_idleCurrentJsonKey] = m_idleCurrent;
+
+    return Json(json);
+}
+
+void PowerLimiter::convertFromJson(const Json& converted)
+{
+    Json11Helper helper(__PRETTY_FUNCTION__, converted);
+    helper.getItemIfPresent(c_budgetJsonKey, m_budget);
+    helper.getItemIfPresent(c_rCurrentJsonKey, m_redCurrent);
+    helper.getItemIfPresent(c_gCurrentJsonKey, m_greenCurrent);
+    helper.getItemIfPresent(c_bCurrentJsonKey, m_blueCurrent);
+    helper.getItemIfPresent(c_idleCurrentJsonKey, m_idleCurrent);
+}
+
+std::string PowerLimiter::getObjectType() const
+{
+    return c_typeName;
+}
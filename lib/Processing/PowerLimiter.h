@@ -0,0 +1,140 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Output stage which limits the estimated current drawn by the LED strip.
+ */
+
+#ifndef PROCESSING_POWERLIMITER_H_
+#define PROCESSING_POWERLIMITER_H_
+
+#include <cstdint>
+
+#include "IJsonConvertible.h"
+#include "ProcessingTypes.h"
+
+/**
+ * Output stage which limits the estimated current drawn by the LED strip.
+ *
+ * The current is estimated from the frame with a linear model: every LED draws an idle current, plus a current per
+ * channel which is proportional to the channel value. When the estimate exceeds the budget, the frame is scaled down
+ * with an integer factor, so the strip stays within what the power supply can deliver. Limiting takes effect
+ * immediately, while the scale factor recovers gradually, to prevent visible pumping.
+ *
+ * The default budget of 0 disables limiting.
+ */
+class PowerLimiter
+    : public IJsonConvertible
+{
+public:
+    /**
+     * Constructor.
+     */
+    PowerLimiter();
+
+    /**
+     * Set the current budget.
+     *
+     * @param[in]   milliamps   The maximum current of the strip, or 0 to disable limiting.
+     */
+    void setBudget(uint32_t milliamps);
+
+    /**
+     * Set the current model.
+     *
+     * @param[in]   red     Current per LED in mA, with red at full intensity.
+     * @param[in]   green   Current per LED in mA, with green at full intensity.
+     * @param[in]   blue    Current per LED in mA, with blue at full intensity.
+     * @param[in]   idle    Current per LED in mA, when off.
+     */
+    void setModel(uint16_t red, uint16_t green, uint16_t blue, uint16_t idle);
+
+    uint32_t getBudget() const;
+    uint16_t getRedCurrent() const;
+    uint16_t getGreenCurrent() const;
+    uint16_t getBlueCurrent() const;
+    uint16_t getIdleCurrent() const;
+
+    /**
+     * Check whether limiting is enabled.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Estimate the current of a strip, and scale it down if it exceeds the budget.
+     *
+     * @param[in, out]  strip   The strip to limit.
+     */
+    void limit(Processing::TRgbStrip& strip);
+
+    /**
+     * Get the estimated current of the last strip passed to @ref limit, before scaling.
+     */
+    uint32_t getEstimatedCurrent() const;
+
+    /**
+     * Check whether the scale factor is still recovering. If so, the next strip will be scaled differently, even
+     * when it is equal to the last one.
+     */
+    bool isRecovering() const;
+
+    // IJsonConvertible implementation
+    Json convertToJson() const override;
+    void convertFromJson(const Json& converted) override;
+
+protected:
+    // IJsonConvertible implementation
+    std::string getObjectType() const override;
+
+private:
+    /** Scale factor which leaves the strip unchanged. The scale factor has 8 fraction bits. */
+    static constexpr uint16_t c_unityScale = 1 << 8;
+
+    /** Maximum increase of the scale factor per frame. At 100 frames per second, recovery takes 0.5 seconds. */
+    static constexpr uint16_t c_recoveryStep = c_unityScale / 50;
+
+    uint32_t m_budget;
+    uint16_t m_redCurrent;
+    uint16_t m_greenCurrent;
+    uint16_t m_blueCurrent;
+    uint16_t m_idleCurrent;
+
+    /** Estimated current of the last strip. */
+    uint32_t m_estimatedCurrent;
+
+    /** Scale factor which was needed to fit the last strip into the budget. */
+    uint16_t m_requiredScale;
+
+    /** Scale factor which was applied to the last strip. */
+    uint16_t m_scale;
+
+    static constexpr const char* c_typeName = "PowerLimiter";
+    static constexpr const char* c_budgetJsonKey = "budget";
+    static constexpr const char* c_rCurrentJsonKey = "rCurrent";
+    static constexpr const char* c_gCurrentJsonKey = "gCurrent";
+    static constexpr const char* c_bCurrentJsonKey = "bCurrent";
+    static constexpr const char* c_idleCurrentJsonKey = "idleCurrent";
+};
+
+#endif /* PROCESSING_POWERLIMITER_H_ */
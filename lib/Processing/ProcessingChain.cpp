@@ -30,6 +30,7 @@
 
 #include "ProcessingChain.h"
 
+#include "ColorCorrection.h"
 #include "IProcessingBlock.h"
 #include "IProcessingBlockFactory.h"
 
@@ -40,6 +41,17 @@ ProcessingChain::ProcessingChain(const IProcessingBlockFactory& processingBlockF
     , m_processingBlockFactory(processingBlockFactory)
     , m_active()
     , m_processingChain()
+    , m_changed(true)
+    , m_lastStripSize(0)
+    , m_highPrecision(false)
+    , m_highPrecisionStrip()
+    , m_ditherer()
+    , m_compiled(false)
+    , m_program()
+    , m_parallelExecutor(nullptr)
+    , m_colorCorrection(nullptr)
+    , m_observer(nullptr)
+    , m_programValid(true)
 {
 }
 
@@ -58,7 +70,11 @@ void ProcessingChain::insertBlock(IProcessingBlock* block, unsigned int index)
     }
 
     m_processingChain.insert(m_processingChain.begin() + index, block);
+    block->setObserver(this);
     m_active ? block->activate() : block->deactivate();
+    updateProgram();
+    m_changed = true;
+    notifyCompiledStateChange();
 }
 
 void ProcessingChain::insertBlock(IProcessingBlock* block)
@@ -66,7 +82,11 @@ void ProcessingChain::insertBlock(IProcessingBlock* block)
     std::lock_guard<std::mutex> lock(m_mutex);
 
     m_processingChain.insert(m_processingChain.end(), block);
+    block->setObserver(this);
     m_active ? block->activate() : block->deactivate();
+    updateProgram();
+    m_changed = true;
+    notifyCompiledStateChange();
 }
 
 Json ProcessingChain::convertToJson() const
@@ -82,6 +102,8 @@ Json ProcessingChain::convertToJson() const
         convertedChain.push_back(processingBlock->convertToJson());
     }
     converted[c_processingChainJsonKey] = convertedChain;
+    converted[c_highPrecisionJsonKey] = m_highPrecision;
+    converted[c_compiledJsonKey] = m_compiled;
 
     return Json(converted);
 }
@@ -98,7 +120,9 @@ void ProcessingChain::convertFromJson(const Json& converted)
     {
         for(auto convertedBlock : convertedChain)
         {
-            m_processingChain.push_back(m_processingBlockFactory.createProcessingBlock(convertedBlock));
+            IProcessingBlock* block(m_processingBlockFactory.createProcessingBlock(convertedBlock));
+            block->setObserver(this);
+            m_processingChain.push_back(block);
         }
     }
     else
@@ -106,7 +130,18 @@ void ProcessingChain::convertFromJson(const Json& converted)
         LOG_ERROR("convertFromJson: JSON does not contain list of processing blocks. Chain will stay empty.");
     }
 
+    // Optional, older configurations don't have it
+    Json11Helper optionalItemsHelper(__PRETTY_FUNCTION__, converted, false /* logMissingKeys */);
+    optionalItemsHelper.getItemIfPresent(c_highPrecisionJsonKey, m_highPrecision);
+    optionalItemsHelper.getItemIfPresent(c_compiledJsonKey, m_compiled);
+    m_ditherer.reset();
+
     updateAllBlockStates();
+    updateProgram();
+    m_changed = true;
+
+    // Programs containing this chain refer to the deleted blocks
+    notifyCompiledStateChange();
 }
 
 std::string ProcessingChain::getObjectType() const
@@ -124,6 +159,8 @@ void ProcessingChain::activate()
     }
 
     m_active = true;
+    updateProgram();
+    m_changed = true;
 }
 
 void ProcessingChain::deactivate()
@@ -136,12 +173,30 @@ void ProcessingChain::deactivate()
     }
 
     m_active = false;
+    m_changed = true;
 }
 
-void ProcessingChain::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap)
+bool ProcessingChain::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    if(m_highPrecision)
+    {
+        // Sized once, so this doesn't allocate
+        m_highPrecisionStrip.assign(strip.size(), Processing::TRgb16());
+        bool changed(executeBlocksHighPrecision(m_highPrecisionStrip, noteToLightTable));
+
+        // Correct before quantization, so low intensities are dithered instead of corrected to black
+        if((m_colorCorrection != nullptr) && !m_colorCorrection->isIdentity())
+        {
+            m_colorCorrection->apply(m_highPrecisionStrip);
+        }
+
+        // Also changes while the dithered output alternates
+        changed |= m_ditherer.quantize(m_highPrecisionStrip, strip);
+        return changed;
+    }
+
     // Start clean
     for(auto& color : strip)
     {
@@ -150,9 +205,199 @@ void ProcessingChain::execute(Processing::TRgbStrip& strip, const Processing::TN
         color.b = 0;
     }
 
+    return executeBlocks(strip, noteToLightTable);
+}
+
+bool ProcessingChain::executeBlocks(Processing::TRgbStrip& strip,
+                                    const Processing::TNoteToLightTable& noteToLightTable)
+{
+    // All blocks must be executed, so don't short-circuit
+    bool changed(m_changed || strip.size() != m_lastStripSize);
+    std::unique_lock<RenderProgram> programLock(m_program, std::defer_lock);
+    changed |= lockProgram(programLock);
+    if(m_compiled && (m_parallelExecutor != nullptr) && m_program.isSegmentable())
+    {
+        changed |= m_program.executeParallel(strip, noteToLightTable, *m_parallelExecutor);
+    }
+    else if(m_compiled)
+    {
+        changed |= m_program.execute(strip, noteToLightTable);
+    }
+    else
+    {
+        for(auto processingBlock : m_processingChain)
+        {
+            changed |= processingBlock->execute(strip, noteToLightTable);
+        }
+    }
+
+    m_changed = false;
+    m_lastStripSize = strip.size();
+    return changed;
+}
+
+bool ProcessingChain::executeHighPrecision(Processing::TRgbStrip16& strip,
+                                           const Processing::TNoteToLightTable& noteToLightTable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Start clean
+    for(auto& color : strip)
+    {
+        color = Processing::TRgb16();
+    }
+
+    return executeBlocksHighPrecision(strip, noteToLightTable);
+}
+
+bool ProcessingChain::executeBlocksHighPrecision(Processing::TRgbStrip16& strip,
+                                                 const Processing::TNoteToLightTable& noteToLightTable)
+{
+    // All blocks must be executed, so don't short-circuit
+    bool changed(m_changed || strip.size() != m_lastStripSize);
+    std::unique_lock<RenderProgram> programLock(m_program, std::defer_lock);
+    changed |= lockProgram(programLock);
+    if(m_compiled)
+    {
+        changed |= m_program.executeHighPrecision(strip, noteToLightTable);
+    }
+    else
+    {
+        for(auto processingBlock : m_processingChain)
+        {
+            changed |= processingBlock->executeHighPrecision(strip, noteToLightTable);
+        }
+    }
+
+    m_changed = false;
+    m_lastStripSize = strip.size();
+    return changed;
+}
+
+void ProcessingChain::setHighPrecision(bool highPrecision)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(highPrecision != m_highPrecision)
+    {
+        m_highPrecision = highPrecision;
+        m_ditherer.reset();
+        m_changed = true;
+
+        // Determines whether programs containing this chain flatten it, see compile
+        notifyCompiledStateChange();
+    }
+}
+
+bool ProcessingChain::isHighPrecision() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_highPrecision;
+}
+
+void ProcessingChain::setCompiled(bool compiled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(compiled != m_compiled)
+    {
+        m_compiled = compiled;
+        updateProgram();
+        m_changed = true;
+    }
+}
+
+bool ProcessingChain::isCompiled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_compiled;
+}
+
+void ProcessingChain::setParallelExecutor(IParallelExecutor* executor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_parallelExecutor = executor;
+}
+
+void ProcessingChain::setColorCorrection(const ColorCorrection* colorCorrection)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_colorCorrection = colorCorrection;
+}
+
+void ProcessingChain::compile(RenderProgram& program)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(m_highPrecision)
+    {
+        // Keeps its own quantization, so can't be flattened
+        program.addBlock(*this);
+        return;
+    }
+
+    // Blocks can be replaced under the lock of this chain only, so it must be held while they are executed. Like
+    // execute, start clean.
+    program.addLock(m_mutex);
+    program.addClear();
     for(auto processingBlock : m_processingChain)
     {
-        processingBlock->execute(strip, noteToLightMap);
+        processingBlock->compile(program);
+    }
+}
+
+void ProcessingChain::setObserver(IProcessingBlock::IObserver* observer)
+{
+    m_observer = observer;
+}
+
+void ProcessingChain::onCompiledStateChange(const IProcessingBlock& block)
+{
+    // Don't lock, the block may be changed while this chain is locked. Programs containing this chain contain the
+    // operations of the block as well, so pass it on.
+    (void)block;
+    m_programValid = false;
+    notifyCompiledStateChange();
+}
+
+void ProcessingChain::notifyCompiledStateChange() const
+{
+    IProcessingBlock::IObserver* observer(m_observer);
+    if(observer != nullptr)
+    {
+        observer->onCompiledStateChange(*this);
+    }
+}
+
+bool ProcessingChain::lockProgram(std::unique_lock<RenderProgram>& programLock)
+{
+    // Nested chains can change until their locks are taken, so check again once they are
+    bool compiled(false);
+    programLock.lock();
+    while(!m_programValid.exchange(true))
+    {
+        programLock.unlock();
+        updateProgram();
+        compiled = m_compiled;
+        programLock.lock();
+    }
+
+    return compiled;
+}
+
+void ProcessingChain::updateProgram()
+{
+    m_program.clear();
+    if(m_compiled)
+    {
+        for(auto processingBlock : m_processingChain)
+        {
+            processingBlock->compile(m_program);
+        }
     }
 }
 
@@ -163,6 +408,9 @@ void ProcessingChain::deleteProcessingBlocks()
         delete processingBlock;
     }
     m_processingChain.clear();
+
+    // Don't keep references to the deleted blocks
+    m_program.clear();
 }
 
 void ProcessingChain::updateAllBlockStates()
@@ -29,10 +29,13 @@
 #ifndef PROCESSING_PROCESSINGCHAIN_H_
 #define PROCESSING_PROCESSINGCHAIN_H_
 
+#include <atomic>
 #include <mutex>
 #include <list>
 
 #include "IProcessingChain.h"
+#include "TemporalDitherer.h"
+#include "RenderProgram.h"
 
 class IProcessingBlockFactory;
 
@@ -41,6 +44,7 @@ class IProcessingBlockFactory;
  */
 class ProcessingChain
     : public IProcessingChain
+    , public IProcessingBlock::IObserver
 {
 public:
     /**
@@ -59,20 +63,35 @@ public:
     ProcessingChain& operator=(const ProcessingChain&) = delete;
 
     // IProcessingChain implementation
+    virtual void setObserver(IProcessingBlock::IObserver* observer);
     virtual void activate();
     virtual void deactivate();
-    virtual void execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightMap& noteToLightMap);
+    virtual bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable);
+    virtual bool executeHighPrecision(Processing::TRgbStrip16& strip,
+                                      const Processing::TNoteToLightTable& noteToLightTable);
     virtual void insertBlock(IProcessingBlock* block, unsigned int index);
     virtual void insertBlock(IProcessingBlock* block);
+    virtual void setHighPrecision(bool highPrecision);
+    virtual bool isHighPrecision() const;
+    virtual void setCompiled(bool compiled);
+    virtual bool isCompiled() const;
+    virtual void setParallelExecutor(IParallelExecutor* executor);
+    virtual void setColorCorrection(const ColorCorrection* colorCorrection);
+    virtual void compile(RenderProgram& program);
     virtual Json convertToJson() const;
     virtual void convertFromJson(const Json& converted);
 
+    // IProcessingBlock::IObserver implementation
+    virtual void onCompiledStateChange(const IProcessingBlock& block);
+
 protected:
     // IProcessingBlock implementation
     virtual std::string getObjectType() const;
 
 private:
     static constexpr const char* c_processingChainJsonKey = "processingChain";
+    static constexpr const char* c_highPrecisionJsonKey = "highPrecision";
+    static constexpr const char* c_compiledJsonKey = "compiled";
 
     /** Mutex to protect the members. */
     mutable std::mutex m_mutex;
@@ -86,6 +105,77 @@ private:
     /** The processing chain. Using a vector for optimal traversal. */
     std::vector<IProcessingBlock*> m_processingChain;
 
+    /** Whether blocks were added, removed, activated or deactivated since the last execution. */
+    bool m_changed;
+
+    /** Strip size at the last execution. */
+    std::size_t m_lastStripSize;
+
+    /** Whether the blocks are executed with high precision. */
+    bool m_highPrecision;
+
+    /** High precision strip for the blocks to operate on, before quantization. */
+    Processing::TRgbStrip16 m_highPrecisionStrip;
+
+    /** Quantizes the high precision strip. */
+    TemporalDitherer m_ditherer;
+
+    /** Whether the chain is executed as a compiled program. */
+    bool m_compiled;
+
+    /** The compiled program, if @ref m_compiled is set. */
+    RenderProgram m_program;
+
+    /** Executor to render the compiled program on multiple cores, if set. */
+    IParallelExecutor* m_parallelExecutor;
+
+    /** Color correction to apply before quantization, if set. */
+    const ColorCorrection* m_colorCorrection;
+
+    /**
+     * Observer to notify when programs containing this chain must be compiled again, if set. Atomic, as changes are
+     * passed on from the blocks without locking.
+     */
+    std::atomic<IProcessingBlock::IObserver*> m_observer;
+
+    /**
+     * Whether @ref m_program is up to date with the blocks, including those of nested chains. Cleared without
+     * locking when a block reports a change, and compiled again at the next execution.
+     */
+    std::atomic<bool> m_programValid;
+
+    /**
+     * Compile the blocks into @ref m_program, if compilation is enabled. Must be called with the mutex held.
+     */
+    void updateProgram();
+
+    /**
+     * Take the locks of the nested chains in @ref m_program, and compile the blocks again if they reported changes
+     * since the last execution. Must be called with the mutex held.
+     *
+     * @param[in/out]   programLock     Lock of the program, which is held afterwards.
+     *
+     * @retval  true    The program was compiled again, so the output may change.
+     * @retval  false   The program is still up to date.
+     */
+    bool lockProgram(std::unique_lock<RenderProgram>& programLock);
+
+    /**
+     * Notify the observer that programs containing this chain must be compiled again.
+     */
+    void notifyCompiledStateChange() const;
+
+    /**
+     * Execute all blocks, or the compiled program. Must be called with the mutex held.
+     */
+    bool executeBlocks(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable);
+
+    /**
+     * Execute all blocks, or the compiled program, on a high precision strip. Must be called with the mutex held.
+     */
+    bool executeBlocksHighPrecision(Processing::TRgbStrip16& strip,
+                                    const Processing::TNoteToLightTable& noteToLightTable);
+
     void deleteProcessingBlocks();
 
     /** Activates/deactivates every block in the chain, based on whether we're active or not. */
@@ -135,6 +135,30 @@ TRgb rgbFromFloat(float initialR, float initialG, float initialB)
     return TRgb((uint8_t)initialR, (uint8_t)initialG, (uint8_t)initialB);
 }
 
+std::ostream& operator<<(std::ostream& os, const TRgb16& color)
+{
+    return os <<
+        "{.r = " << color.r <<
+        ", .g = " << color.g <<
+        ", .b = " << color.b << "}";
+}
+
+TRgb16 rgb16FromFloat(float initialR, float initialG, float initialB)
+{
+    // Scale to 8.8 fixed point, and clamp just below 256
+    const float scale(256.0f), max(UINT16_MAX);
+    float r(initialR * scale), g(initialG * scale), b(initialB * scale);
+
+    if(r > max) {r = max;}
+    if(r <   0) {r =   0;}
+    if(g > max) {g = max;}
+    if(g <   0) {g =   0;}
+    if(b > max) {b = max;}
+    if(b <   0) {b =   0;}
+
+    return TRgb16((uint16_t)r, (uint16_t)g, (uint16_t)b);
+}
+
 bool TLinearConstants::operator==(const TLinearConstants &other) const
 {
     return (factor == other.factor) && (offset == other.offset);
@@ -178,6 +202,75 @@ TNoteToLightMap convert(const Json& source)
     return converted;
 }
 
+bool TNoteToLight::operator==(const TNoteToLight& other) const
+{
+    return (note == other.note) && (light == other.light);
+}
+
+bool TNoteToLight::operator!=(const TNoteToLight& other) const
+{
+    return !(other == *this);
+}
+
+constexpr unsigned int TNoteToLightTable::c_numNotes;
+constexpr uint16_t TNoteToLightTable::c_unmapped;
+
+TNoteToLightTable::TNoteToLightTable()
+    : lights()
+    , mappings()
+    , numMappings(0)
+{
+    lights.fill(c_unmapped);
+}
+
+TNoteToLightTable::TNoteToLightTable(const TNoteToLightMap& map)
+    : TNoteToLightTable()
+{
+    // std::map is ordered by key, so the packed list ends up ordered by note number.
+    for(const auto& pair : map)
+    {
+        lights[pair.first] = pair.second;
+        mappings[numMappings] = {pair.first, pair.second};
+        ++numMappings;
+    }
+}
+
+bool TNoteToLightTable::operator==(const TNoteToLightTable& other) const
+{
+    // Dense array contains all information, mappings are derived from it.
+    return lights == other.lights;
+}
+
+bool TNoteToLightTable::operator!=(const TNoteToLightTable& other) const
+{
+    return !(other == *this);
+}
+
+const TNoteToLight* TNoteToLightTable::begin() const
+{
+    return mappings.data();
+}
+
+const TNoteToLight* TNoteToLightTable::end() const
+{
+    return mappings.data() + numMappings;
+}
+
+size_t TNoteToLightTable::size() const
+{
+    return numMappings;
+}
+
+std::ostream& operator<<(std::ostream& os, const TNoteToLightTable& table)
+{
+    os << "{";
+    for(const auto& mapping : table)
+    {
+        os << static_cast<unsigned int>(mapping.note) << ": " << mapping.light << ", ";
+    }
+    return os << "}";
+}
+
 } /* namespace Processing */
 
 
@@ -0,0 +1,281 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "RenderProgram.h"
+
+#include "IParallelExecutor.h"
+#include "IProcessingBlock.h"
+#include "NoteRgbSource.h"
+
+namespace
+{
+
+inline bool executeNotes(NoteRgbSource& source,
+                         Processing::TRgbStrip& strip,
+                         const Processing::TNoteToLightTable& noteToLightTable)
+{
+    // Qualified call, to avoid virtual dispatch
+    return source.NoteRgbSource::execute(strip, noteToLightTable);
+}
+
+inline bool executeNotes(NoteRgbSource& source,
+                         Processing::TRgbStrip16& strip,
+                         const Processing::TNoteToLightTable& noteToLightTable)
+{
+    return source.NoteRgbSource::executeHighPrecision(strip, noteToLightTable);
+}
+
+inline bool executeBlock(IProcessingBlock& block,
+                         Processing::TRgbStrip& strip,
+                         const Processing::TNoteToLightTable& noteToLightTable)
+{
+    return block.execute(strip, noteToLightTable);
+}
+
+inline bool executeBlock(IProcessingBlock& block,
+                         Processing::TRgbStrip16& strip,
+                         const Processing::TNoteToLightTable& noteToLightTable)
+{
+    return block.executeHighPrecision(strip, noteToLightTable);
+}
+
+} /* namespace */
+
+constexpr unsigned int RenderProgram::c_maxSegments;
+constexpr unsigned int RenderProgram::c_maxParallelNoteSources;
+
+RenderProgram::RenderProgram()
+    : m_ops()
+    , m_segmentable(true)
+    , m_numNoteSources(0)
+    , m_locks()
+{
+}
+
+void RenderProgram::clear()
+{
+    m_ops.clear();
+    m_segmentable = true;
+    m_numNoteSources = 0;
+    m_locks.clear();
+}
+
+void RenderProgram::addClear()
+{
+    addFill(Processing::TRgb());
+}
+
+void RenderProgram::addFill(Processing::TRgb color, Processing::TBlend blend)
+{
+    if(!m_ops.empty() && (m_ops.back().code == OpFill))
+    {
+        TOp& previous(m_ops.back());
+        if(blend.mode == Processing::BlendReplace)
+        {
+            // Overwrites the result of the preceding fill, which has no other effects
+            previous.color = color;
+            previous.blend = blend;
+            return;
+        }
+
+        if(previous.blend.mode == Processing::BlendReplace)
+        {
+            // The strip is uniform after the preceding fill, so blend once now instead of for every LED
+            previous.color = Processing::blendColor(previous.color, color, blend);
+            return;
+        }
+    }
+
+    m_ops.push_back(TOp{OpFill, color, blend, nullptr, nullptr});
+}
+
+void RenderProgram::addNotes(NoteRgbSource& source)
+{
+    m_ops.push_back(TOp{OpNotes, Processing::TRgb(), Processing::TBlend(), &source, nullptr});
+
+    // The locks of the note sources are held in a fixed array during parallel execution
+    if(++m_numNoteSources > c_maxParallelNoteSources)
+    {
+        m_segmentable = false;
+    }
+}
+
+void RenderProgram::addBlock(IProcessingBlock& block)
+{
+    m_ops.push_back(TOp{OpBlock, Processing::TRgb(), Processing::TBlend(), nullptr, &block});
+
+    // Could write anywhere
+    m_segmentable = false;
+}
+
+void RenderProgram::addLock(std::mutex& mutex)
+{
+    m_locks.push_back(&mutex);
+}
+
+void RenderProgram::lock()
+{
+    for(auto mutex : m_locks)
+    {
+        mutex->lock();
+    }
+}
+
+void RenderProgram::unlock()
+{
+    for(auto mutex = m_locks.rbegin(); mutex != m_locks.rend(); ++mutex)
+    {
+        (*mutex)->unlock();
+    }
+}
+
+std::size_t RenderProgram::size() const
+{
+    return m_ops.size();
+}
+
+template <typename TStrip>
+bool RenderProgram::run(TStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) const
+{
+    typedef typename TStrip::value_type TColor;
+
+    // All operations must be executed, so don't short-circuit
+    bool changed(false);
+    for(const auto& op : m_ops)
+    {
+        switch(op.code)
+        {
+            case OpFill:
+                // Fills are constant, so they never change the strip by themselves
+                Processing::blendFill(strip.data(), strip.size(), TColor(op.color), op.blend);
+                break;
+
+            case OpNotes:
+                changed |= executeNotes(*op.noteRgbSource, strip, noteToLightTable);
+                break;
+
+            case OpBlock:
+                changed |= executeBlock(*op.block, strip, noteToLightTable);
+                break;
+        }
+    }
+
+    return changed;
+}
+
+bool RenderProgram::execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) const
+{
+    return run(strip, noteToLightTable);
+}
+
+bool RenderProgram::executeHighPrecision(Processing::TRgbStrip16& strip,
+                                         const Processing::TNoteToLightTable& noteToLightTable) const
+{
+    return run(strip, noteToLightTable);
+}
+
+bool RenderProgram::isSegmentable() const
+{
+    return m_segmentable;
+}
+
+bool RenderProgram::executeParallel(Processing::TRgbStrip& strip,
+                                    const Processing::TNoteToLightTable& noteToLightTable,
+                                    IParallelExecutor& executor) const
+{
+    const unsigned int numSegments(std::min(executor.getNumParts(), c_maxSegments));
+
+    // Released when leaving the scope, also if the executor throws
+    std::array<std::unique_lock<std::mutex>, c_maxParallelNoteSources> noteLocks;
+    std::size_t numNoteLocks(0);
+    for(const auto& op : m_ops)
+    {
+        if(op.code == OpNotes)
+        {
+            noteLocks[numNoteLocks++] = op.noteRgbSource->beginSegments(noteToLightTable, strip.size(), numSegments);
+        }
+    }
+
+    // Capture a single reference only, so the job fits into std::function without allocating
+    struct TContext
+    {
+        const RenderProgram& program;
+        Processing::TRgbStrip& strip;
+        unsigned int numSegments;
+    } context{*this, strip, numSegments};
+    executor.execute([&context](unsigned int part) {
+        if(part < context.numSegments)
+        {
+            context.program.renderSegment(context.strip, part, context.numSegments);
+        }
+    });
+
+    // All note sources must finish, so don't short-circuit
+    bool changed(false);
+    numNoteLocks = 0;
+    for(const auto& op : m_ops)
+    {
+        if(op.code == OpNotes)
+        {
+            changed |= op.noteRgbSource->endSegments(std::move(noteLocks[numNoteLocks++]));
+        }
+    }
+
+    return changed;
+}
+
+void RenderProgram::renderSegment(Processing::TRgbStrip& strip, unsigned int segment, unsigned int numSegments) const
+{
+    const std::size_t begin(getSegmentBegin(strip.size(), segment, numSegments));
+    const std::size_t end(getSegmentBegin(strip.size(), segment + 1, numSegments));
+
+    for(const auto& op : m_ops)
+    {
+        switch(op.code)
+        {
+            case OpFill:
+                Processing::blendFill(strip.data() + begin, end - begin, op.color, op.blend);
+                break;
+
+            case OpNotes:
+                op.noteRgbSource->renderSegment(strip, segment);
+                break;
+
+            case OpBlock:
+                // Not segmentable, excluded by the precondition
+                break;
+        }
+    }
+}
+
+std::size_t RenderProgram::getSegmentBegin(std::size_t stripSize, unsigned int segment, unsigned int numSegments)
+{
+    return stripSize * segment / numSegments;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Flat program which renders a compiled processing chain.
+ */
+
+#ifndef PROCESSING_RENDERPROGRAM_H_
+#define PROCESSING_RENDERPROGRAM_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ProcessingTypes.h"
+#include "Blend.h"
+
+class IParallelExecutor;
+class IProcessingBlock;
+class NoteRgbSource;
+
+/**
+ * Flat program which renders a compiled processing chain.
+ *
+ * Processing blocks append operations to the program in @ref IProcessingBlock::compile. Nested chains append the
+ * operations of their blocks, so the program is a linear list regardless of the nesting depth. Fills are executed
+ * without calling the block which compiled them, note sources are called without virtual dispatch, and other blocks
+ * are called as usual.
+ *
+ * The chain which owns the program must serialize compilation and execution. Nested chains add their lock to the
+ * program, as their blocks can be changed without the lock of the owner. The owner takes these locks around every
+ * execution with @ref lock.
+ *
+ * Fills and note sources only write their own lights. If a program consists of these only, it can render segments
+ * of the strip concurrently, see @ref executeParallel.
+ */
+class RenderProgram
+{
+public:
+    /** Maximum number of segments the strip is split into for parallel execution. */
+    static constexpr unsigned int c_maxSegments = 4;
+
+    /** Maximum number of note sources in a segmentable program, as each holds a lock during parallel execution. */
+    static constexpr unsigned int c_maxParallelNoteSources = 4;
+
+    /**
+     * Constructor. Creates an empty program.
+     */
+    RenderProgram();
+
+    /**
+     * Remove all operations.
+     */
+    void clear();
+
+    /**
+     * Append an operation which sets all LEDs to black.
+     */
+    void addClear();
+
+    /**
+     * Append an operation which blends a color onto all LEDs. A fill directly after a replacing fill is folded into
+     * it, as the strip is uniform at that point.
+     *
+     * @param[in]   color   The color, which is copied into the program.
+     * @param[in]   blend   How to combine the color with the strip.
+     */
+    void addFill(Processing::TRgb color, Processing::TBlend blend = {Processing::BlendReplace, UINT8_MAX});
+
+    /**
+     * Append an operation which renders the notes of a note source.
+     *
+     * @param[in]   source  The note source, which must outlive the program.
+     */
+    void addNotes(NoteRgbSource& source);
+
+    /**
+     * Append an operation which executes a block.
+     *
+     * @param[in]   block   The block, which must outlive the program.
+     */
+    void addBlock(IProcessingBlock& block);
+
+    /**
+     * Add a lock which must be held while the program executes, like that of a nested chain whose blocks are part of
+     * the program. Locks are taken in the order they are added.
+     *
+     * @param[in]   mutex   The lock, which must outlive the program.
+     */
+    void addLock(std::mutex& mutex);
+
+    /**
+     * Take all locks of the program. Makes the program usable with std::unique_lock.
+     */
+    void lock();
+
+    /**
+     * Release all locks of the program.
+     *
+     * @pre The program is not changed while it is locked.
+     */
+    void unlock();
+
+    /**
+     * Get the number of operations.
+     */
+    std::size_t size() const;
+
+    /**
+     * Execute the program.
+     *
+     * @param   [in/out]    strip               The strip to operate on.
+     * @param   [in]        noteToLightTable    To map from note number to light number.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
+     */
+    bool execute(Processing::TRgbStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) const;
+
+    /**
+     * Execute the program on a high precision strip.
+     *
+     * @see execute
+     */
+    bool executeHighPrecision(Processing::TRgbStrip16& strip,
+                              const Processing::TNoteToLightTable& noteToLightTable) const;
+
+    /**
+     * Check whether the program can render segments of the strip concurrently. Requires at most
+     * @ref c_maxParallelNoteSources note sources.
+     */
+    bool isSegmentable() const;
+
+    /**
+     * Execute the program, rendering a segment of the strip per part of the executor. Note sources handle their
+     * events before, and detect changes after the segments are rendered. The result is the same as of @ref execute.
+     *
+     * @pre The program is segmentable.
+     *
+     * @param   [in/out]    strip               The strip to operate on.
+     * @param   [in]        noteToLightTable    To map from note number to light number.
+     * @param   [in]        executor            The executor. Parts beyond @ref c_maxSegments do nothing.
+     *
+     * @retval  true    The strip may have changed compared to the previous execution.
+     * @retval  false   The strip is the same as after the previous execution, given the same input.
+     */
+    bool executeParallel(Processing::TRgbStrip& strip,
+                         const Processing::TNoteToLightTable& noteToLightTable,
+                         IParallelExecutor& executor) const;
+
+    /**
+     * Get the first light of a segment. Segments are consecutive and equally sized, give or take one light.
+     *
+     * @param[in]   stripSize   Size of the strip.
+     * @param[in]   segment     The segment. Pass the number of segments to get the end of the last segment.
+     * @param[in]   numSegments Number of segments.
+     */
+    static std::size_t getSegmentBegin(std::size_t stripSize, unsigned int segment, unsigned int numSegments);
+
+private:
+    enum TOpCode : uint8_t
+    {
+        OpFill,
+        OpNotes,
+        OpBlock
+    };
+
+    /** A single operation. */
+    struct TOp
+    {
+        TOpCode code;
+
+        /** Parameters, depending on the operation code. */
+        Processing::TRgb color;
+        Processing::TBlend blend;
+        NoteRgbSource* noteRgbSource;
+        IProcessingBlock* block;
+    };
+
+    template <typename TStrip>
+    bool run(TStrip& strip, const Processing::TNoteToLightTable& noteToLightTable) const;
+
+    /**
+     * Render a segment of the strip, during parallel execution.
+     */
+    void renderSegment(Processing::TRgbStrip& strip, unsigned int segment, unsigned int numSegments) const;
+
+    /** The operations. */
+    std::vector<TOp> m_ops;
+
+    /** Whether all operations only write their own lights. */
+    bool m_segmentable;
+
+    /** Number of note source operations. */
+    unsigned int m_numNoteSources;
+
+    /** Locks to hold while executing. */
+    std::vector<std::mutex*> m_locks;
+};
+
+#endif /* PROCESSING_RENDERPROGRAM_H_ */
@@ -0,0 +1,93 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TemporalDitherer.h"
+
+namespace
+{
+
+/**
+ * Quantize a single color component.
+ *
+ * @param[in]       value       The 8.8 fixed point value.
+ * @param[in, out]  fraction    The fraction carried over.
+ *
+ * @return  The quantized value.
+ */
+inline uint8_t quantizeComponent(uint16_t value, uint8_t& fraction)
+{
+    uint32_t sum(static_cast<uint32_t>(value) + fraction);
+    if(sum > UINT16_MAX)
+    {
+        // Saturated, nothing to carry over
+        fraction = 0;
+        return UINT8_MAX;
+    }
+
+    fraction = static_cast<uint8_t>(sum);
+    return static_cast<uint8_t>(sum >> 8);
+}
+
+} /* namespace */
+
+TemporalDitherer::TemporalDitherer()
+    : m_fractions()
+{
+}
+
+bool TemporalDitherer::quantize(const Processing::TRgbStrip16& input, Processing::TRgbStrip& output)
+{
+    bool changed(false);
+    if(output.size() != input.size())
+    {
+        output.resize(input.size());
+        changed = true;
+    }
+    if(m_fractions.size() != input.size())
+    {
+        m_fractions.resize(input.size(), TFraction{0, 0, 0});
+    }
+
+    for(std::size_t led = 0; led < input.size(); ++led)
+    {
+        auto& fraction(m_fractions[led]);
+        Processing::TRgb quantized(quantizeComponent(input[led].r, fraction.r),
+                                   quantizeComponent(input[led].g, fraction.g),
+                                   quantizeComponent(input[led].b, fraction.b));
+        if(quantized != output[led])
+        {
+            output[led] = quantized;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void TemporalDitherer::reset()
+{
+    m_fractions.clear();
+}
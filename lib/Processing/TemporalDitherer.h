@@ -0,0 +1,81 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Quantization of high precision strips with temporal dithering.
+ */
+
+#ifndef PROCESSING_TEMPORALDITHERER_H_
+#define PROCESSING_TEMPORALDITHERER_H_
+
+#include <vector>
+
+#include "ProcessingTypes.h"
+
+/**
+ * Quantizes high precision strips to 8 bits per color, with temporal dithering.
+ *
+ * The fraction which is dropped for an LED is carried over to the same LED in the next frame. Over a number of frames,
+ * the average output thus matches the high precision value. For example, a value of 0.25 is output as 1 once every
+ * four frames, instead of always being 0.
+ */
+class TemporalDitherer
+{
+public:
+    /**
+     * Constructor.
+     */
+    TemporalDitherer();
+
+    /**
+     * Quantize a strip.
+     *
+     * @param[in]       input   The high precision strip.
+     * @param[in, out]  output  The quantized strip. Holds the previous output on entry, to detect changes. Resized
+     *                          to the size of the input if needed.
+     *
+     * @retval  true    The output changed.
+     * @retval  false   The output is the same as on entry.
+     */
+    bool quantize(const Processing::TRgbStrip16& input, Processing::TRgbStrip& output);
+
+    /**
+     * Forget the fractions carried over.
+     */
+    void reset();
+
+private:
+    /** Fractions carried over for a single LED. */
+    struct TFraction
+    {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+
+    /** Fractions carried over, per LED. */
+    std::vector<TFraction> m_fractions;
+};
+
+#endif /* PROCESSING_TEMPORALDITHERER_H_ */
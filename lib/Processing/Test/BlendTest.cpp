@@ -0,0 +1,190 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../Blend.h"
+#include "Mock/LoggingTest.h"
+#include "Mock/MockTime.h"
+
+using Processing::TBlend;
+using Processing::TRgb;
+using Processing::TRgb16;
+using ::testing::_;
+using ::testing::StrEq;
+using ::testing::HasSubstr;
+using ::testing::NiceMock;
+
+class BlendTest
+    : public LoggingTest
+{
+public:
+    BlendTest()
+        : LoggingTest()
+        , m_mockTime()
+    {
+        LoggingEntryPoint::setTime(&m_mockTime);
+    }
+
+    /**
+     * Check that filling a range gives the same result as blending every light separately, for every combination of
+     * byte values.
+     */
+    void checkFillMatchesColor(TBlend blend)
+    {
+        // Start at an odd light, so the alignment is different from the strip
+        Processing::TRgbStrip strip(257), reference(257);
+        for(unsigned int source = 0; source <= UINT8_MAX; ++source)
+        {
+            for(unsigned int i = 0; i < strip.size(); ++i)
+            {
+                // All values on every component, in a different order
+                strip[i] = TRgb(i, UINT8_MAX - i, i * 7);
+                reference[i] = blendColor(strip[i], TRgb(source, source, UINT8_MAX - source), blend);
+            }
+
+            Processing::blendFill(strip.data() + 1, strip.size() - 1,
+                                  TRgb(source, source, UINT8_MAX - source), blend);
+            strip[0] = reference[0];
+            ASSERT_EQ(reference, strip) << "source " << source;
+        }
+    }
+
+    NiceMock<MockTime> m_mockTime;
+};
+
+TEST_F(BlendTest, blendColor)
+{
+    const TRgb destination(100, 200, 30), source(200, 100, 0);
+
+    EXPECT_EQ(TRgb(200, 100, 0), blendColor(destination, source, {Processing::BlendReplace, 255}));
+    EXPECT_EQ(TRgb(255, 255, 30), blendColor(destination, source, {Processing::BlendAdd, 255}));
+    EXPECT_EQ(TRgb(200, 200, 30), blendColor(destination, source, {Processing::BlendMax, 255}));
+    EXPECT_EQ(TRgb(78, 78, 0), blendColor(destination, source, {Processing::BlendMultiply, 255}));
+    EXPECT_EQ(TRgb(150, 150, 15), blendColor(destination, source, {Processing::BlendAlpha, 128}));
+
+    // Alpha extremes
+    EXPECT_EQ(source, blendColor(destination, source, {Processing::BlendAlpha, 255}));
+    EXPECT_EQ(destination, blendColor(destination, source, {Processing::BlendAlpha, 0}));
+
+    // Multiplying by full white has no effect
+    EXPECT_EQ(destination, blendColor(destination, TRgb(255, 255, 255), {Processing::BlendMultiply, 255}));
+}
+
+TEST_F(BlendTest, blendColorHighPrecision)
+{
+    const TRgb16 destination(0x6400, 0xc800, 0x1e80), source(0xc800, 0x6400, 0);
+
+    EXPECT_EQ(source, blendColor(destination, source, {Processing::BlendReplace, 255}));
+    EXPECT_EQ(TRgb16(0xffff, 0xffff, 0x1e80), blendColor(destination, source, {Processing::BlendAdd, 255}));
+    EXPECT_EQ(TRgb16(0xc800, 0xc800, 0x1e80), blendColor(destination, source, {Processing::BlendMax, 255}));
+    EXPECT_EQ(destination, blendColor(destination, TRgb16(TRgb(255, 255, 255)), {Processing::BlendMultiply, 255}));
+    EXPECT_EQ(source, blendColor(destination, source, {Processing::BlendAlpha, 255}));
+    EXPECT_EQ(destination, blendColor(destination, source, {Processing::BlendAlpha, 0}));
+
+    // Keeps the fraction, which the 8-bit version would round away
+    EXPECT_EQ(TRgb16(38450, 38350, 3889), blendColor(destination, source, {Processing::BlendAlpha, 128}));
+}
+
+TEST_F(BlendTest, fillMatchesColor)
+{
+    checkFillMatchesColor({Processing::BlendReplace, 255});
+    checkFillMatchesColor({Processing::BlendAdd, 255});
+    checkFillMatchesColor({Processing::BlendMax, 255});
+    checkFillMatchesColor({Processing::BlendMultiply, 255});
+    checkFillMatchesColor({Processing::BlendAlpha, 0});
+    checkFillMatchesColor({Processing::BlendAlpha, 100});
+    checkFillMatchesColor({Processing::BlendAlpha, 255});
+}
+
+TEST_F(BlendTest, fillShortRanges)
+{
+    // Shorter than a word group, at every alignment
+    for(unsigned int offset = 0; offset < 4; ++offset)
+    {
+        for(unsigned int count = 0; count < 8; ++count)
+        {
+            Processing::TRgbStrip strip(12, {250, 1, 2});
+            Processing::blendFill(strip.data() + offset, count, {10, 10, 10}, {Processing::BlendAdd, 255});
+
+            for(unsigned int i = 0; i < strip.size(); ++i)
+            {
+                bool inRange((i >= offset) && (i < offset + count));
+                EXPECT_EQ(inRange ? TRgb(255, 11, 12) : TRgb(250, 1, 2), strip[i]);
+            }
+        }
+    }
+}
+
+TEST_F(BlendTest, fillHighPrecision)
+{
+    Processing::TRgbStrip16 strip(5, TRgb16(0x1000, 0x2000, 0x3000));
+    Processing::blendFill(strip.data(), strip.size(), TRgb16(0x2000, 0x1000, 0x3080), {Processing::BlendMax, 255});
+    EXPECT_EQ(Processing::TRgbStrip16(5, TRgb16(0x2000, 0x2000, 0x3080)), strip);
+}
+
+TEST_F(BlendTest, names)
+{
+    for(auto mode : {Processing::BlendReplace, Processing::BlendAdd, Processing::BlendMax,
+                     Processing::BlendMultiply, Processing::BlendAlpha})
+    {
+        Processing::TBlendMode converted(Processing::BlendReplace);
+        EXPECT_TRUE(Processing::getBlendModeFromName(Processing::getBlendModeName(mode), converted));
+        EXPECT_EQ(mode, converted);
+    }
+
+    Processing::TBlendMode converted(Processing::BlendMax);
+    EXPECT_FALSE(Processing::getBlendModeFromName("screen", converted));
+    EXPECT_EQ(Processing::BlendMax, converted);
+}
+
+TEST_F(BlendTest, json)
+{
+    Json::object json;
+    Processing::addBlendToJson({Processing::BlendAlpha, 42}, json);
+    EXPECT_EQ("alpha", json.at("blendMode").string_value());
+    EXPECT_EQ(42, json.at("alpha").int_value());
+
+    TBlend converted({Processing::BlendReplace, 255});
+    Processing::getBlendFromJson(Json(json), converted);
+    EXPECT_EQ(TBlend({Processing::BlendAlpha, 42}), converted);
+
+    // Missing keys keep the current setting
+    converted = {Processing::BlendMax, 7};
+    Processing::getBlendFromJson(Json(Json::object()), converted);
+    EXPECT_EQ(TBlend({Processing::BlendMax, 7}), converted);
+}
+
+TEST_F(BlendTest, jsonWithUnknownMode)
+{
+    Json::object json;
+    json["blendMode"] = "screen";
+
+    EXPECT_CALL(m_mockLoggingTarget, logMessage(_, Logging::LogLevel_Warning, StrEq("Blend"), HasSubstr("screen")));
+    TBlend converted({Processing::BlendAdd, 255});
+    Processing::getBlendFromJson(Json(json), converted);
+    EXPECT_EQ(Processing::BlendAdd, converted.mode);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../ColorCorrection.h"
+#include "Mock/LoggingTest.h"
+#include "Mock/MockTime.h"
+
+using Processing::TRgb;
+using ::testing::StrEq;
+using ::testing::HasSubstr;
+using ::testing::NiceMock;
+
+class ColorCorrectionTest
+    : public LoggingTest
+{
+public:
+    ColorCorrectionTest()
+        : LoggingTest()
+        , m_colorCorrection()
+        , m_input({{0, 0, 0}, {1, 2, 3}, {128, 128, 128}, {255, 255, 255}})
+        , m_output()
+        , m_mockTime()
+    {
+        LoggingEntryPoint::setTime(&m_mockTime);
+    }
+
+    ColorCorrection m_colorCorrection;
+    Processing::TRgbStrip m_input;
+    Processing::TRgbStrip m_output;
+    NiceMock<MockTime> m_mockTime;
+};
+
+TEST_F(ColorCorrectionTest, defaultIsIdentity)
+{
+    EXPECT_TRUE(m_colorCorrection.isIdentity());
+
+    m_colorCorrection.apply(m_input, m_output);
+    EXPECT_EQ(m_input, m_output);
+}
+
+TEST_F(ColorCorrectionTest, gamma)
+{
+    m_colorCorrection.setGamma(2.0f, 1.0f, 3.0f);
+    EXPECT_FALSE(m_colorCorrection.isIdentity());
+
+    m_colorCorrection.apply(m_input, m_output);
+    ASSERT_EQ(m_input.size(), m_output.size());
+
+    // Black and full white are not affected
+    EXPECT_EQ(TRgb(0, 0, 0), m_output[0]);
+    EXPECT_EQ(TRgb(255, 255, 255), m_output[3]);
+
+    // Low values are darkened most: 255 * (128 / 255) ^ gamma, rounded
+    EXPECT_EQ(TRgb(0, 2, 0), m_output[1]);
+    EXPECT_EQ(TRgb(64, 128, 32), m_output[2]);
+}
+
+TEST_F(ColorCorrectionTest, whitePoint)
+{
+    m_colorCorrection.setWhitePoint({255, 200, 100});
+    EXPECT_FALSE(m_colorCorrection.isIdentity());
+
+    m_colorCorrection.apply(m_input, m_output);
+    EXPECT_EQ(TRgb(0, 0, 0), m_output[0]);
+    EXPECT_EQ(TRgb(128, 100, 50), m_output[2]);
+    EXPECT_EQ(TRgb(255, 200, 100), m_output[3]);
+}
+
+TEST_F(ColorCorrectionTest, highPrecision)
+{
+    m_colorCorrection.setGamma(2.2f, 2.2f, 2.2f);
+
+    // 14, 14.5 and 255
+    Processing::TRgbStrip16 strip({{0x0e00, 0x0e80, 0xff00}});
+    m_colorCorrection.apply(strip);
+
+    // 256 * 255 * (14 / 255) ^ 2.2, rounded. The 8-bit correction gives 0.
+    EXPECT_EQ(110, strip[0].r);
+    // Interpolated between 14 and 15
+    EXPECT_EQ(119, strip[0].g);
+    EXPECT_EQ(0xff00, strip[0].b);
+}
+
+TEST_F(ColorCorrectionTest, ignoreInvalidGamma)
+{
+    m_colorCorrection.setGamma(2.0f, 2.0f, 2.0f);
+
+    EXPECT_CALL(m_mockLoggingTarget, logMessage(_, Logging::LogLevel_Warning, StrEq("ColorCorrection"), HasSubstr("gamma")));
+    m_colorCorrection.setGamma(0.0f, 1.0f, 1.0f);
+
+    EXPECT_EQ(2.0f, m_colorCorrection.getRedGamma());
+    EXPECT_EQ(2.0f, m_colorCorrection.getGreenGamma());
+    EXPECT_EQ(2.0f, m_colorCorrection.getBlueGamma());
+}
+
+TEST_F(ColorCorrectionTest, convertToJson)
+{
+    m_colorCorrection.setGamma(2.2f, 2.5f, 2.8f);
+    m_colorCorrection.setWhitePoint({255, 200, 100});
+
+    Json::object converted(m_colorCorrection.convertToJson().object_items());
+    EXPECT_EQ("ColorCorrection", converted.at("objectType").string_value());
+    EXPECT_FLOAT_EQ(2.2f, converted.at("rGamma").number_value());
+    EXPECT_FLOAT_EQ(2.5f, converted.at("gGamma").number_value());
+    EXPECT_FLOAT_EQ(2.8f, converted.at("bGamma").number_value());
+    EXPECT_EQ(255, converted.at("rWhite").int_value());
+    EXPECT_EQ(200, converted.at("gWhite").int_value());
+    EXPECT_EQ(100, converted.at("bWhite").int_value());
+}
+
+TEST_F(ColorCorrectionTest, convertFromJson)
+{
+    Json::object converted;
+    converted["objectType"] = "ColorCorrection";
+    converted["rGamma"] = 2.0;
+    converted["gGamma"] = 1.0;
+    converted["bGamma"] = 3.0;
+    converted["rWhite"] = 255;
+    converted["gWhite"] = 200;
+    converted["bWhite"] = 100;
+
+    m_colorCorrection.convertFromJson(Json(converted));
+    EXPECT_EQ(2.0f, m_colorCorrection.getRedGamma());
+    EXPECT_EQ(1.0f, m_colorCorrection.getGreenGamma());
+    EXPECT_EQ(3.0f, m_colorCorrection.getBlueGamma());
+    EXPECT_EQ(TRgb(255, 200, 100), m_colorCorrection.getWhitePoint());
+
+    // Tables are regenerated
+    m_colorCorrection.apply(m_input, m_output);
+    EXPECT_EQ(TRgb(64, 100, 13), m_output[2]);
+}
@@ -29,6 +29,8 @@
 #include "../Concert.h"
 #include "../Mock/MockProcessingBlockFactory.h"
 #include "../Mock/MockPatch.h"
+#include "../Mock/MockProcessingChain.h"
+#include "ThreadParallelExecutor.h"
 #include "Mock/MockTime.h"
 #include "LoggingEntryPoint.h"
 
@@ -36,9 +38,11 @@ using testing::_;
 using testing::SaveArg;
 using testing::Return;
 using testing::ReturnNew;
+using testing::ReturnRef;
 using testing::Expectation;
 using testing::NiceMock;
 using testing::SetArgReferee;
+using testing::DoAll;
 
 class MockObserver
     : public Concert::IObserver
@@ -57,7 +61,7 @@ public:
         , m_mockTime()
     {
         LoggingEntryPoint::setTime(&m_mockTime);
-        m_concert = new Concert(m_mockMidiInput, m_mockProcessingBlockFactory);
+        m_concert = new Concert(m_mockMidiInput, m_mockProcessingBlockFactory, m_mockTime);
 
         ON_CALL(m_mockProcessingBlockFactory, createPatch())
             .WillByDefault(ReturnNew<NiceMock<MockPatch>>());
@@ -133,10 +137,10 @@ TEST_F(ConcertTest, execute)
 
     Processing::TRgbStrip newStripValues({{42, 43, 44}});
 
-    // The mock patch should be executed, and given the configured note to light map.
+    // The mock patch should be executed, and given the configured note to light map in compiled form.
     // Let the mock patch set some values on the strip during its execute
-    EXPECT_CALL(*mockPatch, execute(_, map))
-        .WillOnce(SetArgReferee<0>(newStripValues));
+    EXPECT_CALL(*mockPatch, execute(_, Processing::TNoteToLightTable(map)))
+        .WillOnce(DoAll(SetArgReferee<0>(newStripValues), Return(true)));
 
     // The new strip values should be notified
     EXPECT_CALL(observer, onStripUpdate(newStripValues));
@@ -144,6 +148,146 @@ TEST_F(ConcertTest, execute)
     m_concert->execute();
 }
 
+TEST_F(ConcertTest, executeWithColorCorrection)
+{
+    MockPatch* mockPatch(new NiceMock<MockPatch>);
+    m_concert->addPatch(mockPatch);
+
+    MockObserver observer;
+    m_concert->subscribe(observer);
+
+    ColorCorrection colorCorrection;
+    colorCorrection.setWhitePoint({255, 200, 100});
+    m_concert->setColorCorrection(colorCorrection);
+
+    Processing::TRgbStrip newStripValues({{255, 255, 255}});
+    EXPECT_CALL(*mockPatch, execute(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(newStripValues), Return(true)));
+
+    // Observers get the corrected strip
+    EXPECT_CALL(observer, onStripUpdate(Processing::TRgbStrip({{255, 200, 100}})));
+
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, executeWithColorCorrectionHighPrecision)
+{
+    MockPatch* mockPatch(new NiceMock<MockPatch>);
+
+    // The chain gets the correction, to apply it before quantization
+    EXPECT_CALL(mockPatch->m_processingChain, setColorCorrection(testing::NotNull()));
+    ON_CALL(mockPatch->m_processingChain, isHighPrecision())
+        .WillByDefault(Return(true));
+    m_concert->addPatch(mockPatch);
+
+    MockObserver observer;
+    m_concert->subscribe(observer);
+
+    ColorCorrection colorCorrection;
+    colorCorrection.setWhitePoint({255, 200, 100});
+    m_concert->setColorCorrection(colorCorrection);
+
+    Processing::TRgbStrip newStripValues({{255, 255, 255}});
+    EXPECT_CALL(*mockPatch, execute(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(newStripValues), Return(true)));
+
+    // Already corrected by the chain, so not corrected again
+    EXPECT_CALL(observer, onStripUpdate(newStripValues));
+
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, executeWithPowerLimiter)
+{
+    MockPatch* mockPatch(new NiceMock<MockPatch>);
+    m_concert->addPatch(mockPatch);
+
+    MockObserver observer;
+    m_concert->subscribe(observer);
+
+    PowerLimiter powerLimiter;
+    powerLimiter.setModel(20, 20, 20, 0);
+    powerLimiter.setBudget(30);
+    m_concert->setPowerLimiter(powerLimiter);
+
+    Processing::TRgbStrip whiteStrip({{255, 255, 255}}), darkStrip({{0, 0, 0}});
+    EXPECT_CALL(*mockPatch, execute(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(whiteStrip), Return(true)))
+        .WillOnce(DoAll(SetArgReferee<0>(darkStrip), Return(true)))
+        .WillRepeatedly(Return(false));
+
+    // Observers get the limited strip
+    EXPECT_CALL(observer, onStripUpdate(Processing::TRgbStrip({{127, 127, 127}})));
+    m_concert->execute();
+    testing::Mock::VerifyAndClearExpectations(&observer);
+
+    // While the limiter recovers, observers are updated even if the patch does not change
+    EXPECT_CALL(observer, onStripUpdate(darkStrip))
+        .Times(26);
+    for(unsigned int frame = 0; frame < 26; ++frame)
+    {
+        m_concert->execute();
+    }
+    testing::Mock::VerifyAndClearExpectations(&observer);
+
+    EXPECT_CALL(observer, onStripUpdate(_))
+        .Times(0);
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, executeWithoutChanges)
+{
+    MockPatch* mockPatch(new NiceMock<MockPatch>);
+    m_concert->addPatch(mockPatch);
+
+    MockObserver observer;
+    m_concert->subscribe(observer);
+
+    // A new observer always gets the current state
+    EXPECT_CALL(*mockPatch, execute(_, _))
+        .WillRepeatedly(Return(false));
+    EXPECT_CALL(observer, onStripUpdate(_));
+    m_concert->execute();
+    testing::Mock::VerifyAndClearExpectations(&observer);
+
+    // Unchanged strip should not be notified
+    EXPECT_CALL(observer, onStripUpdate(_))
+        .Times(0);
+    m_concert->execute();
+    testing::Mock::VerifyAndClearExpectations(&observer);
+
+    // Changed strip should
+    EXPECT_CALL(*mockPatch, execute(_, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(observer, onStripUpdate(_));
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, timingStatistics)
+{
+    auto mockPatch(new NiceMock<MockPatch>);
+    m_concert->addPatch(mockPatch);
+
+    // Start, events handled, patch executed, observers notified
+    EXPECT_CALL(m_mockTime, getMicroseconds())
+        .WillOnce(Return(100))
+        .WillOnce(Return(105))
+        .WillOnce(Return(125))
+        .WillOnce(Return(128));
+    m_concert->execute();
+
+    auto statistics(m_concert->getTimingStatistics());
+    EXPECT_EQ(1, statistics.eventHandling.count);
+    EXPECT_EQ(5, statistics.eventHandling.max);
+    EXPECT_EQ(1, statistics.patchExecution.count);
+    EXPECT_EQ(20, statistics.patchExecution.max);
+    EXPECT_EQ(1, statistics.observerNotification.count);
+    EXPECT_EQ(3, statistics.observerNotification.max);
+
+    m_concert->resetTimingStatistics();
+    EXPECT_EQ(0, m_concert->getTimingStatistics().patchExecution.count);
+}
+
 TEST_F(ConcertTest, executeWithMultiplePatches)
 {
     auto mockPatch(new NiceMock<MockPatch>);
@@ -200,6 +344,112 @@ TEST_F(ConcertTest, patchChangeOnProgramChange)
     m_concert->execute();
 }
 
+TEST_F(ConcertTest, patchChangeOnProgramChangeAfterEdit)
+{
+    uint8_t program(42);
+
+    auto mockPatch(new NiceMock<MockPatch>);
+    auto mockPatch2(new NiceMock<MockPatch>);
+    IPatch::IObserver* observer(nullptr);
+    EXPECT_CALL(*mockPatch2, setObserver(_))
+        .WillOnce(SaveArg<0>(&observer));
+
+    m_concert->addPatch(mockPatch);
+    m_concert->addPatch(mockPatch2);
+    ASSERT_NE(nullptr, observer);
+
+    uint8_t channel(2);
+    m_concert->setListeningToProgramChange(true);
+    m_concert->setProgramChangeChannel(channel);
+
+    // Not bound to a program yet
+    EXPECT_CALL(*mockPatch2, activate())
+        .Times(0);
+    m_concert->onProgramChange(channel, program);
+    m_concert->execute();
+    testing::Mock::VerifyAndClearExpectations(mockPatch2);
+
+    // Edited patch notifies the concert
+    ON_CALL(*mockPatch2, getProgram())
+        .WillByDefault(Return(program));
+    ON_CALL(*mockPatch2, hasBankAndProgram())
+        .WillByDefault(Return(true));
+    observer->onBankAndProgramChange(*mockPatch2);
+
+    EXPECT_CALL(*mockPatch, deactivate());
+    EXPECT_CALL(*mockPatch2, activate());
+    m_concert->onProgramChange(channel, program);
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, patchChangeOnProgramChangeWithManyPatches)
+{
+    std::vector<NiceMock<MockPatch>*> mockPatches;
+    for(unsigned int i = 0; i < 300; ++i)
+    {
+        auto mockPatch(new NiceMock<MockPatch>);
+        ON_CALL(*mockPatch, getBank())
+            .WillByDefault(Return(i / 128));
+        ON_CALL(*mockPatch, getProgram())
+            .WillByDefault(Return(i % 128));
+        ON_CALL(*mockPatch, hasBankAndProgram())
+            .WillByDefault(Return(true));
+        m_concert->addPatch(mockPatch);
+        mockPatches.push_back(mockPatch);
+    }
+    m_concert->setListeningToProgramChange(true);
+
+    EXPECT_CALL(*mockPatches[2 * 128 + 5], activate());
+    sendBankSelectSequence(0, 2);
+    m_concert->onProgramChange(0, 5);
+    m_concert->execute();
+
+    // Without edits, the patches are not queried again
+    for(auto mockPatch : mockPatches)
+    {
+        EXPECT_CALL(*mockPatch, hasBankAndProgram())
+            .Times(0);
+        EXPECT_CALL(*mockPatch, getBank())
+            .Times(0);
+        EXPECT_CALL(*mockPatch, getProgram())
+            .Times(0);
+    }
+    EXPECT_CALL(*mockPatches[128 + 7], activate());
+    sendBankSelectSequence(0, 1);
+    m_concert->onProgramChange(0, 7);
+    m_concert->execute();
+
+    // Nothing bound
+    sendBankSelectSequence(0, 3);
+    m_concert->onProgramChange(0, 0);
+    m_concert->execute();
+}
+
+TEST_F(ConcertTest, patchChangeOnProgramChangeWithSameProgram)
+{
+    auto mockPatch(new NiceMock<MockPatch>);
+    auto mockPatch2(new NiceMock<MockPatch>);
+    auto mockPatch3(new NiceMock<MockPatch>);
+    for(auto patch : {mockPatch2, mockPatch3})
+    {
+        ON_CALL(*patch, getProgram())
+            .WillByDefault(Return(42));
+        ON_CALL(*patch, hasBankAndProgram())
+            .WillByDefault(Return(true));
+    }
+    m_concert->addPatch(mockPatch);
+    m_concert->addPatch(mockPatch2);
+    m_concert->addPatch(mockPatch3);
+
+    // Last one wins
+    EXPECT_CALL(*mockPatch2, activate())
+        .Times(0);
+    EXPECT_CALL(*mockPatch3, activate());
+    m_concert->setListeningToProgramChange(true);
+    m_concert->onProgramChange(0, 42);
+    m_concert->execute();
+}
+
 TEST_F(ConcertTest, addPatch)
 {
     EXPECT_EQ(0, m_concert->addPatch());
@@ -207,6 +457,31 @@ TEST_F(ConcertTest, addPatch)
     EXPECT_EQ(2, m_concert->addPatch(new NiceMock<MockPatch>));
 }
 
+TEST_F(ConcertTest, parallelExecutorPassedToPatches)
+{
+    ThreadParallelExecutor executor(1);
+    NiceMock<MockProcessingChain> chain, chain2;
+
+    auto mockPatch(new NiceMock<MockPatch>);
+    ON_CALL(*mockPatch, getProcessingChain())
+        .WillByDefault(ReturnRef(chain));
+    m_concert->addPatch(mockPatch);
+
+    EXPECT_CALL(chain, setParallelExecutor(&executor));
+    m_concert->setParallelExecutor(&executor);
+
+    // Also for patches added later
+    auto mockPatch2(new NiceMock<MockPatch>);
+    ON_CALL(*mockPatch2, getProcessingChain())
+        .WillByDefault(ReturnRef(chain2));
+    EXPECT_CALL(chain2, setParallelExecutor(&executor));
+    m_concert->addPatch(mockPatch2);
+
+    // Delete the patches before the chains they refer to
+    delete m_concert;
+    m_concert = nullptr;
+}
+
 TEST_F(ConcertTest, getPatch)
 {
     auto mockPatch(new NiceMock<MockPatch>);
@@ -274,6 +549,8 @@ TEST_F(ConcertTest, convertToJson)
     EXPECT_EQ(2, converted.at("currentBank").number_value());
     EXPECT_EQ(3, converted.at("programChangeChannel").number_value());
     EXPECT_EQ(Processing::convert(map), converted.at("noteToLightMap").object_items());
+    EXPECT_EQ(ColorCorrection().convertToJson(), converted.at("colorCorrection"));
+    EXPECT_EQ(PowerLimiter().convertToJson(), converted.at("powerLimiter"));
     
     Json::array patches = converted.at("patches").array_items();
     EXPECT_EQ(2, patches.size());
@@ -293,6 +570,23 @@ TEST_F(ConcertTest, convertFromJson)
                     "1": 10,
                     "2": 20
                 },
+                "colorCorrection": {
+                    "objectType": "ColorCorrection",
+                    "rGamma": 2.2,
+                    "gGamma": 2.2,
+                    "bGamma": 2.2,
+                    "rWhite": 255,
+                    "gWhite": 200,
+                    "bWhite": 100
+                },
+                "powerLimiter": {
+                    "objectType": "PowerLimiter",
+                    "budget": 4000,
+                    "rCurrent": 12,
+                    "gCurrent": 13,
+                    "bCurrent": 14,
+                    "idleCurrent": 1
+                },
                 "patches": [
                     {
                         "objectType": "MockPatch",
@@ -317,6 +611,11 @@ TEST_F(ConcertTest, convertFromJson)
     ON_CALL(*convertedPatch2, getName())
         .WillByDefault(Return(name2));
 
+    // First patch becomes active
+    EXPECT_CALL(*convertedPatch1, activate());
+    EXPECT_CALL(*convertedPatch2, activate())
+        .Times(0);
+
     // Re-create the sub-objects of the above test input, 
     // so we can verify that they are passed to the factory in order.
     Json::object mockPatch1Json;
@@ -346,4 +645,12 @@ TEST_F(ConcertTest, convertFromJson)
     expectedMap[2] = 20;
     EXPECT_EQ(expectedMap, m_concert->getNoteToLightMap());
     EXPECT_EQ(21, m_concert->getStripSize());
+
+    ColorCorrection colorCorrection(m_concert->getColorCorrection());
+    EXPECT_FLOAT_EQ(2.2f, colorCorrection.getRedGamma());
+    EXPECT_EQ(Processing::TRgb(255, 200, 100), colorCorrection.getWhitePoint());
+
+    PowerLimiter powerLimiter(m_concert->getPowerLimiter());
+    EXPECT_EQ(4000, powerLimiter.getBudget());
+    EXPECT_EQ(14, powerLimiter.getBlueCurrent());
 }
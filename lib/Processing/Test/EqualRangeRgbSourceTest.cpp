@@ -29,6 +29,7 @@
 #include <vector>
 #include <string>
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 #include "Json11Helper.h"
 #include "../EqualRangeRgbSource.h"
@@ -36,6 +37,14 @@
 #include "LoggingEntryPoint.h"
 
 using ::testing::NiceMock;
+using ::testing::Ref;
+
+class MockBlockObserver
+    : public IProcessingBlock::IObserver
+{
+public:
+    MOCK_METHOD1(onCompiledStateChange, void(const IProcessingBlock& block));
+};
 
 class EqualRangeRgbSourceTest
     : public ::testing::Test
@@ -60,7 +69,7 @@ TEST_F(EqualRangeRgbSourceTest, executeDifferentColors)
     for(const auto& colorIt : colors)
     {
         m_source.setColor(colorIt);
-        m_source.execute(strip, Processing::TNoteToLightMap());
+        EXPECT_TRUE(m_source.execute(strip, Processing::TNoteToLightTable()));
         for(const auto& outputIt : strip)
         {
             EXPECT_EQ(outputIt, colorIt);
@@ -68,6 +77,23 @@ TEST_F(EqualRangeRgbSourceTest, executeDifferentColors)
     }
 
 }
+
+TEST_F(EqualRangeRgbSourceTest, reportsChanges)
+{
+    Processing::TRgbStrip strip(20);
+
+    m_source.setColor({1, 2, 3});
+    EXPECT_TRUE(m_source.execute(strip, Processing::TNoteToLightTable()));
+    EXPECT_FALSE(m_source.execute(strip, Processing::TNoteToLightTable()));
+
+    // Same color
+    m_source.setColor({1, 2, 3});
+    EXPECT_FALSE(m_source.execute(strip, Processing::TNoteToLightTable()));
+
+    m_source.setColor({4, 5, 6});
+    EXPECT_TRUE(m_source.execute(strip, Processing::TNoteToLightTable()));
+}
+
 TEST_F(EqualRangeRgbSourceTest, convertFromJson)
 {
     std::string err;
@@ -121,14 +147,73 @@ TEST_F(EqualRangeRgbSourceTest, convertFromJsonWithMissingColor)
     EXPECT_EQ(m_source.getColor(), Processing::TRgb({10, 0, 30}));
 }
 
+TEST_F(EqualRangeRgbSourceTest, blend)
+{
+    Processing::TRgbStrip strip(20, {100, 200, 30});
+
+    m_source.setColor({50, 100, 0});
+    m_source.setBlend({Processing::BlendAlpha, 128});
+    EXPECT_TRUE(m_source.execute(strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(20, {75, 150, 15}), strip);
+
+    // Same blend
+    m_source.setBlend({Processing::BlendAlpha, 128});
+    EXPECT_FALSE(m_source.execute(strip, Processing::TNoteToLightTable()));
+
+    strip.assign(20, {100, 200, 30});
+    m_source.setBlend({Processing::BlendAdd, 255});
+    EXPECT_TRUE(m_source.execute(strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(20, {150, 255, 30}), strip);
+}
+
+TEST_F(EqualRangeRgbSourceTest, convertFromJsonWithBlend)
+{
+    std::string err;
+    Json j = Json::parse(R"(
+        {
+            "objectType": "EqualRangeRgbSource",
+            "r": 10,
+            "g": 20,
+            "b": 30,
+            "blendMode": "multiply",
+            "alpha": 100
+        }
+        )",
+        err,
+        json11::STANDARD);
+
+    m_source.convertFromJson(j);
+    EXPECT_EQ(Processing::BlendMultiply, m_source.getBlend().mode);
+    EXPECT_EQ(100, m_source.getBlend().alpha);
+}
+
 TEST_F(EqualRangeRgbSourceTest, convertToJson)
 {
     m_source.setColor(Processing::TRgb({40, 50, 60}));
 
     Json::object j = m_source.convertToJson().object_items();
-    EXPECT_EQ(4, j.size());
+    EXPECT_EQ(6, j.size());
     EXPECT_EQ("EqualRangeRgbSource", j.at("objectType").string_value());
     EXPECT_EQ(40, j.at("r").number_value());
     EXPECT_EQ(50, j.at("g").number_value());
     EXPECT_EQ(60, j.at("b").number_value());
+    EXPECT_EQ("replace", j.at("blendMode").string_value());
+    EXPECT_EQ(255, j.at("alpha").number_value());
+}
+
+TEST_F(EqualRangeRgbSourceTest, observer)
+{
+    MockBlockObserver observer;
+    m_source.setObserver(&observer);
+
+    // Color and blend are copied into compiled programs
+    EXPECT_CALL(observer, onCompiledStateChange(Ref(m_source)))
+        .Times(3);
+    m_source.setColor({1, 2, 3});
+    m_source.setColor({1, 2, 3});
+    m_source.setBlend({Processing::BlendAdd, UINT8_MAX});
+    m_source.convertFromJson(m_source.convertToJson());
+
+    m_source.setObserver(nullptr);
+    m_source.setColor({4, 5, 6});
 }
@@ -0,0 +1,132 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit tests for the LED encoders.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "../Ws2801Encoder.h"
+#include "../Apa102Encoder.h"
+#include "../Ws2812Encoder.h"
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Each;
+
+namespace
+{
+
+std::vector<uint8_t> encode(const ILedEncoder& encoder, const Processing::TRgbStrip& strip, std::size_t numLeds)
+{
+    // Fill with garbage, to check that every byte is written
+    std::vector<uint8_t> frame(encoder.getFrameSize(numLeds), 0x55);
+    encoder.encode(strip, frame.data(), numLeds);
+
+    return frame;
+}
+
+} /* namespace */
+
+TEST(Ws2801EncoderTest, encode)
+{
+    Ws2801Encoder encoder;
+    Processing::TRgbStrip strip({{1, 2, 3}, {4, 5, 6}});
+
+    EXPECT_THAT(encode(encoder, strip, 2), ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+TEST(Ws2801EncoderTest, colorOrder)
+{
+    Ws2801Encoder encoder(LedColorOrder_Grb);
+    Processing::TRgbStrip strip({{1, 2, 3}});
+
+    EXPECT_THAT(encode(encoder, strip, 1), ElementsAre(2, 1, 3));
+}
+
+TEST(Ws2801EncoderTest, ledsBeyondStripAreOff)
+{
+    Ws2801Encoder encoder;
+    Processing::TRgbStrip strip({{1, 2, 3}});
+
+    EXPECT_THAT(encode(encoder, strip, 2), ElementsAre(1, 2, 3, 0, 0, 0));
+}
+
+TEST(Apa102EncoderTest, encode)
+{
+    Apa102Encoder encoder;
+    Processing::TRgbStrip strip({{1, 2, 3}, {4, 5, 6}});
+
+    EXPECT_THAT(encode(encoder, strip, 2), ElementsAreArray({
+        0, 0, 0, 0,
+        0xff, 3, 2, 1,
+        0xff, 6, 5, 4,
+        0, 0, 0, 0,
+        0
+    }));
+}
+
+TEST(Apa102EncoderTest, globalBrightness)
+{
+    Apa102Encoder encoder(3, LedColorOrder_Rgb);
+    Processing::TRgbStrip strip({{1, 2, 3}});
+
+    auto frame(encode(encoder, strip, 1));
+    ASSERT_LE(8, frame.size());
+    EXPECT_EQ(0xe3, frame[4]);
+    EXPECT_EQ(1, frame[5]);
+    EXPECT_EQ(2, frame[6]);
+    EXPECT_EQ(3, frame[7]);
+}
+
+TEST(Apa102EncoderTest, endFrameCoversStrip)
+{
+    Apa102Encoder encoder;
+
+    // Start frame, LEDs, reset frame, and at least half a clock per LED
+    EXPECT_EQ(4 + 4 * 32 + 4 + 2, encoder.getFrameSize(32));
+    EXPECT_EQ(4 + 4 * 33 + 4 + 3, encoder.getFrameSize(33));
+}
+
+TEST(Ws2812EncoderTest, encode)
+{
+    Ws2812Encoder encoder;
+    Processing::TRgbStrip strip({{0x00, 0xff, 0x1b}});
+
+    auto frame(encode(encoder, strip, 1));
+    ASSERT_EQ(12 + 120, frame.size());
+
+    // GRB, 2 bits per byte: 1000 for zero, 1110 for one
+    std::vector<uint8_t> led(frame.begin(), frame.begin() + 12);
+    EXPECT_THAT(led, ElementsAre(0xee, 0xee, 0xee, 0xee,
+                                 0x88, 0x88, 0x88, 0x88,
+                                 0x88, 0x8e, 0xe8, 0xee));
+
+    // Latch, and the data line low when idle
+    std::vector<uint8_t> latch(frame.begin() + 12, frame.end());
+    EXPECT_THAT(latch, Each(0));
+}
@@ -34,15 +34,20 @@
 #include "Test/MidiInputObserverTest.h"
 #include "Mock/LoggingTest.h"
 #include "Mock/MockTime.h"
+#include "IParallelExecutor.h"
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
 
 
 using ::testing::_;
 using ::testing::SaveArg;
 using ::testing::Return;
 using ::testing::HasSubstr;
+using ::testing::StrEq;
 using ::testing::Each;
-using ::testing::InSequence;
-using ::testing::AnyNumber;
+using ::testing::Field;
 
 #define LOGGING_COMPONENT "NoteRgbSource"
 
@@ -84,6 +89,8 @@ public:
                  }
              })")
     {
+        LoggingEntryPoint::setTime(&m_mockTime);
+
         for(int i = 0; i < c_StripSize; ++i)
         {
             // Default: simple 1-to-1 mapping
@@ -131,7 +138,7 @@ TEST_F(NoteRgbSourceTest, noNotesSounding)
 
     auto expectedStrip(m_strip);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     // No notes sounding should leave strip untouched
     ASSERT_EQ(expectedStrip, m_strip);
@@ -143,7 +150,7 @@ TEST_F(NoteRgbSourceTest, noteOn)
     m_observer->onNoteChange(0, 0, 1, true);
     m_observer->onNoteChange(0, 5, 6, true);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     // Default: white, factor 255, so any velocity >0 will cause full on
     auto reference = Processing::TRgbStrip(c_StripSize);
@@ -153,6 +160,136 @@ TEST_F(NoteRgbSourceTest, noteOn)
     EXPECT_EQ(reference, m_strip);
 }
 
+TEST_F(NoteRgbSourceTest, noteOnHighPrecision)
+{
+    m_observer->onNoteChange(0, 0, 1, true);
+    m_observer->onNoteChange(0, 5, 6, true);
+
+    Processing::TRgbStrip16 strip(c_StripSize);
+    m_noteRgbSource->executeHighPrecision(strip, Processing::TNoteToLightTable(m_noteToLightMap));
+
+    auto reference = Processing::TRgbStrip16(c_StripSize);
+    reference[0] = Processing::TRgb16(Processing::TRgb(0xff, 0xff, 0xff));
+    reference[5] = Processing::TRgb16(Processing::TRgb(0xff, 0xff, 0xff));
+
+    EXPECT_EQ(reference, strip);
+}
+
+TEST_F(NoteRgbSourceTest, segments)
+{
+    m_observer->onNoteChange(0, 0, 1, true);
+    m_observer->onNoteChange(0, 5, 6, true);
+    m_observer->onNoteChange(0, 9, 6, true);
+
+    // Segments start at lights 0, 3 and 6, and can be rendered in any order
+    auto lock = m_noteRgbSource->beginSegments(Processing::TNoteToLightTable(m_noteToLightMap), c_StripSize, 3);
+    m_noteRgbSource->renderSegment(m_strip, 2);
+    auto reference = Processing::TRgbStrip(c_StripSize);
+    reference[9] = {0xff, 0xff, 0xff};
+    EXPECT_EQ(reference, m_strip);
+
+    m_noteRgbSource->renderSegment(m_strip, 1);
+    m_noteRgbSource->renderSegment(m_strip, 0);
+    EXPECT_TRUE(m_noteRgbSource->endSegments(std::move(lock)));
+    EXPECT_FALSE(lock.owns_lock());
+
+    reference[0] = {0xff, 0xff, 0xff};
+    reference[5] = {0xff, 0xff, 0xff};
+    EXPECT_EQ(reference, m_strip);
+
+    // Same result as a normal execution, so no change
+    resetStrip();
+    EXPECT_FALSE(m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap)));
+    EXPECT_EQ(reference, m_strip);
+}
+
+TEST_F(NoteRgbSourceTest, segmentsReleaseLockWhenJobThrows)
+{
+    class ThrowingExecutor
+        : public IParallelExecutor
+    {
+    public:
+        unsigned int getNumParts() const override
+        {
+            return 2;
+        }
+
+        void execute(const TJob& job) override
+        {
+            (void)job;
+            throw std::runtime_error("job failed");
+        }
+    } executor;
+
+    RenderProgram program;
+    program.addNotes(*m_noteRgbSource);
+    ASSERT_TRUE(program.isSegmentable());
+    EXPECT_THROW(program.executeParallel(m_strip, Processing::TNoteToLightTable(m_noteToLightMap), executor),
+                 std::runtime_error);
+
+    // Would block if the source were still locked
+    auto execution = std::async(std::launch::async, [this]() {
+        m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    });
+    EXPECT_EQ(std::future_status::ready, execution.wait_for(std::chrono::seconds(1)));
+}
+
+TEST_F(NoteRgbSourceTest, tooManyNoteSourcesAreNotSegmentable)
+{
+    RenderProgram program;
+    for(unsigned int i = 0; i < RenderProgram::c_maxParallelNoteSources; ++i)
+    {
+        program.addNotes(*m_noteRgbSource);
+    }
+    EXPECT_TRUE(program.isSegmentable());
+
+    program.addNotes(*m_noteRgbSource);
+    EXPECT_FALSE(program.isSegmentable());
+}
+
+TEST_F(NoteRgbSourceTest, blend)
+{
+    m_observer->onNoteChange(0, 0, 1, true);
+    m_observer->onNoteChange(0, 5, 6, true);
+
+    m_noteRgbSource->setBlend({Processing::BlendMultiply, 255});
+    EXPECT_EQ(Processing::BlendMultiply, m_noteRgbSource->getBlend().mode);
+
+    // Idle notes count as black
+    m_strip.assign(c_StripSize, {10, 20, 30});
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap)));
+    auto reference = Processing::TRgbStrip(c_StripSize);
+    reference[0] = {10, 20, 30};
+    reference[5] = {10, 20, 30};
+    EXPECT_EQ(reference, m_strip);
+
+    // Dark notes darken their lights
+    m_strip.assign(c_StripSize, {10, 20, 30});
+    m_noteRgbSource->setRgbFunction(new NiceMock<MockRgbFunction>);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    reference = Processing::TRgbStrip(c_StripSize);
+    EXPECT_EQ(reference, m_strip);
+
+    // Only mapped lights inside the strip are blended
+    Processing::TNoteToLightMap otherMap;
+    otherMap[3] = 2;
+    otherMap[4] = c_StripSize;
+    m_strip.assign(c_StripSize, {10, 20, 30});
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(otherMap));
+    reference = Processing::TRgbStrip(c_StripSize, {10, 20, 30});
+    reference[2] = {};
+    EXPECT_EQ(reference, m_strip);
+    m_strip.assign(c_StripSize, {10, 20, 30});
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    reference = Processing::TRgbStrip(c_StripSize);
+
+    // Changing the blend is reported
+    m_strip.assign(c_StripSize, {10, 20, 30});
+    m_noteRgbSource->setBlend({Processing::BlendReplace, 255});
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap)));
+    EXPECT_EQ(reference, m_strip);
+}
+
 TEST_F(NoteRgbSourceTest, deactivateDisablesAllNotes)
 {
     // (channel, number, velocity, on/off)
@@ -160,7 +297,7 @@ TEST_F(NoteRgbSourceTest, deactivateDisablesAllNotes)
     m_observer->onNoteChange(0, 0, 1, true);
     m_observer->onNoteChange(0, 5, 6, true);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     EXPECT_THAT(m_strip, Each(Processing::TRgb({0, 0, 0})));
 }
@@ -173,7 +310,7 @@ TEST_F(NoteRgbSourceTest, noteOff)
 
     m_observer->onNoteChange(0, 0, 8, false);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     // Default: white, factor 255, so any velocity >0 will cause full on
     auto reference = Processing::TRgbStrip(c_StripSize);
@@ -186,7 +323,7 @@ TEST_F(NoteRgbSourceTest, ignoreOtherChannel)
 {
     m_observer->onNoteChange(1, 0, 1, true);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_THAT(m_strip, Each(Processing::TRgb({0, 0, 0})));
 }
 
@@ -198,7 +335,7 @@ TEST_F(NoteRgbSourceTest, ignorePedal)
     m_observer->onControlChange(0, IMidiInterface::DAMPER_PEDAL, 0xff);
     m_observer->onNoteChange(0, 0, 1, false);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_THAT(m_strip, Each(Processing::TRgb({0, 0, 0})));
 }
 
@@ -217,7 +354,7 @@ TEST_F(NoteRgbSourceTest, usePedal)
     // Both notes are still sounding
     reference[0] = {0xff, 0xff, 0xff};
     reference[2] = {0xff, 0xff, 0xff};
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_EQ(reference, m_strip);
 
     // Release keys
@@ -226,7 +363,7 @@ TEST_F(NoteRgbSourceTest, usePedal)
 
     // Both notes are still sounding
     resetStrip();
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_EQ(reference, m_strip);
 
     // Release pedal
@@ -236,7 +373,7 @@ TEST_F(NoteRgbSourceTest, usePedal)
     reference[0] = {0, 0, 0};
     reference[2] = {0, 0, 0};
     resetStrip();
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_EQ(reference, m_strip);
 }
 
@@ -267,41 +404,161 @@ TEST_F(NoteRgbSourceTest, otherRgbFunction)
     m_observer->onNoteChange(0, 0, 1, true);
     m_observer->onNoteChange(0, 5, 6, true);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
+    // Notes which were never played are not rendered
     auto reference = Processing::TRgbStrip(c_StripSize);
     reference[0] = {0, 0, 1};
-    reference[1] = {1, 0, 0};
-    reference[2] = {1, 0, 0};
-    reference[3] = {1, 0, 0};
-    reference[4] = {1, 0, 0};
     reference[5] = {0, 0, 1};
-    reference[6] = {1, 0, 0};
-    reference[7] = {1, 0, 0};
-    reference[8] = {1, 0, 0};
-    reference[9] = {1, 0, 0};
 
     EXPECT_EQ(reference, m_strip);
+
+    // Released notes stay rendered as long as the function produces output for them
+    m_observer->onNoteChange(0, 5, 0, false);
+    resetStrip();
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+
+    reference[5] = {1, 0, 0};
+    EXPECT_EQ(reference, m_strip);
+}
+
+TEST_F(NoteRgbSourceTest, releasedNoteRetiresWhenDark)
+{
+    MockRgbFunction* mockRgbFunction = new MockRgbFunction();
+    m_noteRgbSource->setRgbFunction(mockRgbFunction);
+
+    // (channel, number, velocity, on/off)
+    m_observer->onNoteChange(0, 3, 1, true);
+    EXPECT_CALL(*mockRgbFunction, calculate(_, _))
+        .WillOnce(Return(Processing::TRgb(1, 2, 3)));
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    EXPECT_EQ(Processing::TRgb(1, 2, 3), m_strip[3]);
+    testing::Mock::VerifyAndClearExpectations(mockRgbFunction);
+
+    // Released note is calculated once per execution while it decays
+    m_observer->onNoteChange(0, 3, 0, false);
+    EXPECT_CALL(*mockRgbFunction, calculate(_, _))
+        .WillOnce(Return(Processing::TRgb(1, 0, 0)));
+    resetStrip();
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    EXPECT_EQ(Processing::TRgb(1, 0, 0), m_strip[3]);
+    testing::Mock::VerifyAndClearExpectations(mockRgbFunction);
+
+    // Function reports released note dark: it should not be calculated anymore afterwards
+    EXPECT_CALL(*mockRgbFunction, calculate(_, _))
+        .WillOnce(Return(Processing::TRgb()));
+    resetStrip();
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    EXPECT_THAT(m_strip, Each(Processing::TRgb({0, 0, 0})));
+}
+
+TEST_F(NoteRgbSourceTest, decayingNoteFadesIntoIdleLight)
+{
+    const Processing::TRgb background(100, 100, 100);
+    for(auto mode : {Processing::BlendMultiply, Processing::BlendAlpha})
+    {
+        SCOPED_TRACE(mode);
+        auto* mockRgbFunction(new NiceMock<MockRgbFunction>);
+        ON_CALL(*mockRgbFunction, calculate(_, _)).WillByDefault(Return(Processing::TRgb()));
+        ON_CALL(*mockRgbFunction, calculate(_, 0)).WillByDefault(Return(Processing::TRgb(200, 200, 200)));
+        ON_CALL(*mockRgbFunction, calculate(_, 1)).WillByDefault(Return(Processing::TRgb(100, 100, 100)));
+        ON_CALL(*mockRgbFunction, calculate(_, 2)).WillByDefault(Return(Processing::TRgb(50, 50, 50)));
+        m_noteRgbSource->setRgbFunction(mockRgbFunction);
+        m_noteRgbSource->setBlend({mode, 128});
+
+        // (channel, number, velocity, on/off)
+        ON_CALL(m_mockTime, getMilliseconds()).WillByDefault(Return(0));
+        m_observer->onNoteChange(0, 3, 1, true);
+        m_observer->onNoteChange(0, 3, 0, false);
+
+        // The light only gets darker while the note decays, and stays as it was when the note retires
+        std::vector<Processing::TRgb> lights;
+        for(unsigned int frame = 0; frame < 6; ++frame)
+        {
+            ON_CALL(m_mockTime, getMilliseconds()).WillByDefault(Return(frame));
+            m_strip.assign(c_StripSize, background);
+            m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+            lights.push_back(m_strip[3]);
+        }
+        EXPECT_NE(background, lights.front());
+
+        for(std::size_t frame = 1; frame < lights.size(); ++frame)
+        {
+            EXPECT_LE(lights[frame].r, lights[frame - 1].r) << "frame " << frame;
+        }
+        EXPECT_EQ(lights[3], lights[4]);
+        EXPECT_EQ(lights[4], lights[5]);
+
+        // Same as the lights of idle notes
+        EXPECT_EQ(m_strip[2], lights.back());
+    }
+}
+
+TEST_F(NoteRgbSourceTest, reportsChanges)
+{
+    Processing::TNoteToLightTable table(m_noteToLightMap);
+
+    // Silence
+    EXPECT_FALSE(m_noteRgbSource->execute(m_strip, table));
+
+    // (channel, number, velocity, on/off)
+    m_observer->onNoteChange(0, 3, 1, true);
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, table));
+
+    // Held note with time invariant output
+    resetStrip();
+    EXPECT_FALSE(m_noteRgbSource->execute(m_strip, table));
+    EXPECT_EQ(Processing::TRgb(0xff, 0xff, 0xff), m_strip[3]);
+
+    // Other mapping
+    Processing::TNoteToLightMap otherMap;
+    otherMap[3] = 4;
+    resetStrip();
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(otherMap)));
+    resetStrip();
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, table));
+
+    m_observer->onNoteChange(0, 3, 0, false);
+    resetStrip();
+    EXPECT_TRUE(m_noteRgbSource->execute(m_strip, table));
+    EXPECT_FALSE(m_noteRgbSource->execute(m_strip, table));
 }
 
 TEST_F(NoteRgbSourceTest, timePassedToRgbFunction)
 {
+    // Time is sampled once per execution after handling the note events, and passed for all notes
     EXPECT_CALL(m_mockTime, getMilliseconds())
+        .WillOnce(Return(40))
+        .WillOnce(Return(41))
         .WillOnce(Return(42))
-        .WillOnce(Return(43))
-        .WillRepeatedly(Return(44));
+        .WillRepeatedly(Return(43));
 
     MockRgbFunction* mockRgbFunction = new MockRgbFunction();
-    {
-        InSequence dummy;
-        EXPECT_CALL(*mockRgbFunction, calculate(_, 42));
-        EXPECT_CALL(*mockRgbFunction, calculate(_, 43));
-        EXPECT_CALL(*mockRgbFunction, calculate(_, 44))
-            .Times(AnyNumber());
-        m_noteRgbSource->setRgbFunction(mockRgbFunction);
+    EXPECT_CALL(*mockRgbFunction, calculate(_, 42))
+        .Times(2);
+    m_noteRgbSource->setRgbFunction(mockRgbFunction);
 
-        m_noteRgbSource->execute(m_strip, m_noteToLightMap);
-    }
+    // (channel, number, velocity, on/off)
+    m_observer->onNoteChange(0, 0, 1, true);
+    m_observer->onNoteChange(0, 5, 6, true);
+
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+}
+
+TEST_F(NoteRgbSourceTest, arrivalTimeUsedAsNoteOnTimeStamp)
+{
+    EXPECT_CALL(m_mockTime, getMilliseconds())
+        .WillRepeatedly(Return(50));
+
+    MockRgbFunction* mockRgbFunction = new MockRgbFunction();
+    EXPECT_CALL(*mockRgbFunction, calculate(Field(&Processing::TNoteState::noteOnTimeStamp, 37), 50));
+    m_noteRgbSource->setRgbFunction(mockRgbFunction);
+
+    // (channel, number, velocity, on/off, arrival time)
+    m_observer->onTimedNoteChange(0, 0, 1, true, 37);
+
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 }
 
 TEST_F(NoteRgbSourceTest, otherNoteToLightMap)
@@ -314,7 +571,7 @@ TEST_F(NoteRgbSourceTest, otherNoteToLightMap)
     m_observer->onNoteChange(0, 0, 1, true);
     m_observer->onNoteChange(0, 5, 6, true);
 
-    m_noteRgbSource->execute(m_strip, m_noteToLightMap);
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     // Default: white, factor 255, so any velocity >0 will cause full on
     auto reference = Processing::TRgbStrip(c_StripSize);
@@ -331,7 +588,7 @@ TEST_F(NoteRgbSourceTest, doNotWriteOutsideStrip)
     m_observer->onNoteChange(0, 9, 6, true);
 
     auto shorterStrip = Processing::TRgbStrip(5);
-    m_noteRgbSource->execute(shorterStrip, m_noteToLightMap);
+    m_noteRgbSource->execute(shorterStrip, Processing::TNoteToLightTable(m_noteToLightMap));
 
     // Default: white, factor 255, so any velocity >0 will cause full on
     auto reference = Processing::TRgbStrip(5);
@@ -340,6 +597,32 @@ TEST_F(NoteRgbSourceTest, doNotWriteOutsideStrip)
     EXPECT_EQ(reference, shorterStrip);
 }
 
+TEST_F(NoteRgbSourceTest, eventQueueOverflow)
+{
+    // Flood the event queue before it is drained by execute
+    for(int i = 0; i < 1000; ++i)
+    {
+        m_observer->onNoteChange(0, 0, 1, true);
+    }
+    // (channel, number, velocity, on/off)
+    m_observer->onNoteChange(0, 5, 6, true);
+
+    EXPECT_CALL(m_mockLoggingTarget, logMessage(_, Logging::LogLevel_Warning, StrEq(LOGGING_COMPONENT), HasSubstr("overflow")));
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+
+    // Last event was dropped
+    auto reference = Processing::TRgbStrip(c_StripSize);
+    reference[0] = {0xff, 0xff, 0xff};
+    EXPECT_EQ(reference, m_strip);
+
+    // Queue is usable again, and no new warning
+    m_observer->onNoteChange(0, 5, 6, true);
+    resetStrip();
+    m_noteRgbSource->execute(m_strip, Processing::TNoteToLightTable(m_noteToLightMap));
+    reference[5] = {0xff, 0xff, 0xff};
+    EXPECT_EQ(reference, m_strip);
+}
+
 TEST_F(NoteRgbSourceTest, deleteRgbFunction)
 {
     MockRgbFunction* mock1 = new MockRgbFunction();
@@ -377,6 +660,8 @@ TEST_F(NoteRgbSourceTest, convertToJson)
     EXPECT_EQ(false, j.at("usingPedal").bool_value());
     EXPECT_EQ("MockRgbFunction", j.at("rgbFunction").object_items().at("objectType").string_value());
     EXPECT_EQ(42, j.at("rgbFunction").object_items().at("someParameter").int_value());
+    EXPECT_EQ("add", j.at("blendMode").string_value());
+    EXPECT_EQ(255, j.at("alpha").int_value());
 }
 
 TEST_F(NoteRgbSourceTest, convertFromJson)
@@ -398,12 +683,19 @@ TEST_F(NoteRgbSourceTest, convertFromJson)
     m_noteRgbSource->convertFromJson(j);
     EXPECT_EQ(6, m_noteRgbSource->getChannel());
     EXPECT_EQ(false, m_noteRgbSource->isUsingPedal());
+    EXPECT_EQ(Processing::BlendAdd, m_noteRgbSource->getBlend().mode);
+
+    // Play some notes on the new channel, to have the new function called for them
+    for(uint8_t note = 0; note < 3; ++note)
+    {
+        m_observer->onNoteChange(6, note, 1, true);
+    }
 
     Processing::TRgbStrip reference(3);
     reference[0] = {1, 2, 3};
     reference[1] = {1, 2, 3};
     reference[2] = {1, 2, 3};
     Processing::TRgbStrip testStrip(3);
-    m_noteRgbSource->execute(testStrip, m_noteToLightMap);
+    m_noteRgbSource->execute(testStrip, Processing::TNoteToLightTable(m_noteToLightMap));
     EXPECT_EQ(reference, testStrip);
 }
@@ -0,0 +1,75 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "ProcessingTypes.h"
+
+using namespace Processing;
+
+TEST(TNoteToLightTableTest, defaultConstructor)
+{
+    TNoteToLightTable table;
+    EXPECT_EQ(0, table.size());
+    EXPECT_EQ(table.begin(), table.end());
+    for(uint16_t note = 0; note < TNoteToLightTable::c_numNotes; ++note)
+    {
+        EXPECT_EQ(TNoteToLightTable::c_unmapped, table.lights[note]);
+    }
+}
+
+TEST(TNoteToLightTableTest, constructFromMap)
+{
+    TNoteToLightMap map;
+    map[50] = 2;
+    map[21] = 0;
+    map[30] = 1;
+    TNoteToLightTable table(map);
+
+    ASSERT_EQ(3, table.size());
+    EXPECT_EQ(0, table.lights[21]);
+    EXPECT_EQ(1, table.lights[30]);
+    EXPECT_EQ(2, table.lights[50]);
+    EXPECT_EQ(TNoteToLightTable::c_unmapped, table.lights[22]);
+
+    // Mappings are kept in note order, like the map they were compiled from
+    std::vector<TNoteToLight> expected({{21, 0}, {30, 1}, {50, 2}});
+    std::vector<TNoteToLight> actual(table.begin(), table.end());
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(TNoteToLightTableTest, equality)
+{
+    TNoteToLightMap map;
+    map[60] = 10;
+    TNoteToLightMap otherMap;
+    otherMap[60] = 11;
+
+    EXPECT_EQ(TNoteToLightTable(map), TNoteToLightTable(map));
+    EXPECT_NE(TNoteToLightTable(map), TNoteToLightTable(otherMap));
+    EXPECT_NE(TNoteToLightTable(map), TNoteToLightTable());
+}
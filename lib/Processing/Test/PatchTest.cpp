@@ -33,6 +33,14 @@ using ::testing::Return;
 using ::testing::NiceMock;
 using ::testing::_;
 using ::testing::Invoke;
+using ::testing::Ref;
+
+class MockPatchObserver
+    : public IPatch::IObserver
+{
+public:
+    MOCK_METHOD1(onBankAndProgramChange, void(const IPatch& patch));
+};
 
 class PatchTest
     : public ::testing::Test
@@ -114,6 +122,34 @@ TEST_F(PatchTest, convertFromJson)
     EXPECT_EQ("Awesome patch", m_patch->getName());
 }
 
+TEST_F(PatchTest, observer)
+{
+    MockPatchObserver observer;
+    m_patch->setObserver(&observer);
+
+    // Patch is not locked during the notification
+    uint8_t program(0);
+    EXPECT_CALL(observer, onBankAndProgramChange(Ref(*m_patch)))
+        .Times(4)
+        .WillRepeatedly(Invoke([&](const IPatch& patch) { program = patch.getProgram(); }));
+    m_patch->setBank(1);
+    m_patch->setProgram(2);
+    EXPECT_EQ(2, program);
+    m_patch->clearBankAndProgram();
+
+    Json::object j;
+    j["processingChain"] = Json::object();
+    j["bank"] = 1;
+    j["program"] = 3;
+    j["hasBankAndProgram"] = true;
+    j["name"] = std::string("Awesome patch");
+    m_patch->convertFromJson(Json(j));
+    EXPECT_EQ(3, program);
+
+    m_patch->setObserver(nullptr);
+    m_patch->setProgram(4);
+}
+
 TEST_F(PatchTest, activate)
 {
     EXPECT_CALL(*m_processingChain, activate());
@@ -131,20 +167,22 @@ TEST_F(PatchTest, execute)
     Processing::TRgbStrip strip;
     strip.push_back(Processing::TRgb({0, 0, 0}));
 
-    // Pass a map with something we can verify
+    // Pass a table with something we can verify
     Processing::TNoteToLightMap map;
     map[42] = 42;
+    Processing::TNoteToLightTable table(map);
 
     // Let the mock processing chain do something with the strip which we can verify
     Processing::TRgb valueAfterProcessing({1, 2, 3});
     ASSERT_NE(valueAfterProcessing, strip[0]);
 
-    EXPECT_CALL(*m_processingChain, execute(_, map))
-        .WillOnce(Invoke([valueAfterProcessing](Processing::TRgbStrip& strip, const Processing::TNoteToLightMap&){
+    EXPECT_CALL(*m_processingChain, execute(_, table))
+        .WillOnce(Invoke([valueAfterProcessing](Processing::TRgbStrip& strip, const Processing::TNoteToLightTable&){
             strip[0] = valueAfterProcessing;
+            return true;
     }));
 
-    m_patch->execute(strip, map);
+    EXPECT_TRUE(m_patch->execute(strip, table));
 
     EXPECT_EQ(valueAfterProcessing, strip[0]);
 }
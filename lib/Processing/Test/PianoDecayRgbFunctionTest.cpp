@@ -26,8 +26,44 @@
 #include "PianoDecayRgbFunction.h"
 #include "gtest/gtest.h"
 
+#include <cstdlib>
 #include <vector>
 
+/**
+ * Reference implementation which evaluates the decay curve in floating point, like it was done before the curve was
+ * precalculated.
+ */
+static Processing::TRgb calculateReference(const Processing::TLinearConstants& redConstants,
+                                           const Processing::TLinearConstants& greenConstants,
+                                           const Processing::TLinearConstants& blueConstants,
+                                           const Processing::TNoteState& noteState,
+                                           Processing::TTime currentTime)
+{
+    if(!noteState.sounding)
+    {
+        return Processing::TRgb();
+    }
+
+    auto startColor = Processing::rgbFromFloat(
+        redConstants.factor * noteState.pressDownVelocity + redConstants.offset,
+        greenConstants.factor * noteState.pressDownVelocity + greenConstants.offset,
+        blueConstants.factor * noteState.pressDownVelocity + blueConstants.offset
+    );
+
+    uint32_t soundingTime(currentTime - noteState.noteOnTimeStamp);
+    float intensityFactor;
+    if(soundingTime < 1200)
+    {
+        intensityFactor = 1.0f - (static_cast<float>(soundingTime) / 1200.0f) * 0.5f;
+    }
+    else
+    {
+        intensityFactor = 0.5f - (static_cast<float>(soundingTime - 1200) / 13800.0f) * 0.5f;
+    }
+
+    return startColor * intensityFactor;
+}
+
 class PianoDecayRgbFunctionTest : public testing::Test
 {
 public:
@@ -57,10 +93,10 @@ TEST_F(PianoDecayRgbFunctionTest, decay)
     };
 
     const Processing::TNoteState noteState = {
-            .noteOnTimeStamp = 0,
-            .pressDownVelocity = 100,
             .pressed = true,
             .sounding = true,
+            .pressDownVelocity = 100,
+            .noteOnTimeStamp = 0,
     };
 
     m_function.setRedConstants({2, 0});
@@ -74,13 +110,137 @@ TEST_F(PianoDecayRgbFunctionTest, decay)
     }
 }
 
-TEST_F(PianoDecayRgbFunctionTest, notSounding)
+TEST_F(PianoDecayRgbFunctionTest, matchesReference)
+{
+    // Precalculated curve may differ from floating point evaluation by at most 1 per channel
+    static constexpr int c_tolerance = 1;
+
+    const Processing::TLinearConstants redConstants = {2, 1};
+    const Processing::TLinearConstants greenConstants = {1.5f, 10};
+    const Processing::TLinearConstants blueConstants = {0.3f, 0};
+    m_function.setRedConstants(redConstants);
+    m_function.setGreenConstants(greenConstants);
+    m_function.setBlueConstants(blueConstants);
+
+    for(uint8_t velocity = 1; velocity <= 127; velocity += 7)
+    {
+        const Processing::TNoteState noteState = {
+                .pressed = true,
+                .sounding = true,
+                .pressDownVelocity = velocity,
+                .noteOnTimeStamp = 1000,
+        };
+
+        for(Processing::TTime time = 1000; time < 17000; ++time)
+        {
+            auto expected(calculateReference(redConstants, greenConstants, blueConstants, noteState, time));
+            auto actual(m_function.calculate(noteState, time));
+            ASSERT_LE(std::abs(expected.r - actual.r), c_tolerance) << "(velocity " << (int)velocity << ", time " << time << ")";
+            ASSERT_LE(std::abs(expected.g - actual.g), c_tolerance) << "(velocity " << (int)velocity << ", time " << time << ")";
+            ASSERT_LE(std::abs(expected.b - actual.b), c_tolerance) << "(velocity " << (int)velocity << ", time " << time << ")";
+        }
+    }
+}
+
+TEST_F(PianoDecayRgbFunctionTest, highPrecision)
 {
+    m_function.setRedConstants({2, 0});
+    m_function.setGreenConstants({0.05f, 0});
+    m_function.setBlueConstants({0, 0});
+
     const Processing::TNoteState noteState = {
+            .pressed = true,
+            .sounding = true,
+            .pressDownVelocity = 100,
             .noteOnTimeStamp = 0,
-            .pressDownVelocity = 127,
+    };
+
+    for(Processing::TTime time = 0; time < 16000; time += 10)
+    {
+        auto actual(m_function.calculate(noteState, time));
+        auto highPrecision(m_function.calculateHighPrecision(noteState, time).toRgb());
+        ASSERT_LE(std::abs(actual.r - highPrecision.r), 1) << "(time " << time << ")";
+        ASSERT_LE(std::abs(actual.g - highPrecision.g), 1) << "(time " << time << ")";
+        ASSERT_EQ(0, highPrecision.b) << "(time " << time << ")";
+    }
+
+    // Green starts at 5. Halfway the slow decay, it's below 2 and the fraction must not be lost.
+    auto dim(m_function.calculateHighPrecision(noteState, 8100));
+    EXPECT_EQ(1, m_function.calculate(noteState, 8100).g);
+    EXPECT_NEAR(1.25f * 256, dim.g, 2);
+}
+
+TEST_F(PianoDecayRgbFunctionTest, calculateAll)
+{
+    std::vector<Processing::TNoteState> noteStates(3);
+    noteStates[0] = {true, true, 100, 0};
+    noteStates[2] = {true, true, 50, 0};
+
+    const std::vector<Processing::TNoteToLight> mappings = {
+            {0, 0},
+            {1, 1},
+            {2, 2},
+            // Outside strip
+            {2, 4},
+            // No note state
+            {3, 3},
+    };
+
+    Processing::TRgbStrip strip(4, {1, 1, 1});
+    m_function.calculateAll(noteStates.data(), noteStates.size(), mappings.data(), mappings.size(), strip, 600);
+
+    // Output colors are added to the strip
+    Processing::TRgbStrip expected(4, {1, 1, 1});
+    expected[0] += m_function.calculate(noteStates[0], 600);
+    expected[2] += m_function.calculate(noteStates[2], 600);
+    EXPECT_EQ(expected, strip);
+    EXPECT_NE(Processing::TRgb(1, 1, 1), strip[0]);
+}
+
+TEST_F(PianoDecayRgbFunctionTest, timeWrapAround)
+{
+    Processing::TNoteState noteState = {
+            .pressed = true,
+            .sounding = true,
+            .pressDownVelocity = 100,
+            .noteOnTimeStamp = 0,
+    };
+
+    m_function.setRedConstants({2, 0});
+    m_function.setGreenConstants({1, 0});
+    m_function.setBlueConstants({1, 0});
+
+    auto expected(m_function.calculate(noteState, 600));
+
+    // Note on just before the wrap around of the millisecond counter
+    noteState.noteOnTimeStamp = UINT32_MAX - 299;
+    EXPECT_EQ(expected, m_function.calculate(noteState, 300));
+}
+
+TEST_F(PianoDecayRgbFunctionTest, noteOnAfterCurrentTime)
+{
+    const Processing::TNoteState noteState = {
+            .pressed = true,
+            .sounding = true,
+            .pressDownVelocity = 100,
+            .noteOnTimeStamp = 1001,
+    };
+
+    m_function.setRedConstants({2, 0});
+    m_function.setGreenConstants({1, 0});
+    m_function.setBlueConstants({1, 0});
+
+    // Counts as just pressed, instead of a long time ago
+    EXPECT_EQ(Processing::TRgb(200, 100, 100), m_function.calculate(noteState, 1000));
+}
+
+TEST_F(PianoDecayRgbFunctionTest, notSounding)
+{
+    const Processing::TNoteState noteState = {
             .pressed = false,
             .sounding = false,
+            .pressDownVelocity = 127,
+            .noteOnTimeStamp = 0,
     };
 
     EXPECT_EQ(Processing::TRgb(0, 0, 0), m_function.calculate(noteState, 42));
@@ -0,0 +1,179 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../PowerLimiter.h"
+
+using Processing::TRgb;
+
+class PowerLimiterTest
+    : public ::testing::Test
+{
+public:
+    static constexpr unsigned int c_stripSize = 10;
+
+    PowerLimiterTest()
+        : m_powerLimiter()
+        , m_white(c_stripSize, TRgb(255, 255, 255))
+        , m_strip(m_white)
+    {
+        // 60 mA per LED at full white, 600 mA for the whole strip
+        m_powerLimiter.setModel(20, 20, 20, 0);
+    }
+
+    PowerLimiter m_powerLimiter;
+    const Processing::TRgbStrip m_white;
+    Processing::TRgbStrip m_strip;
+};
+
+constexpr unsigned int PowerLimiterTest::c_stripSize;
+
+TEST_F(PowerLimiterTest, disabledByDefault)
+{
+    EXPECT_FALSE(m_powerLimiter.isEnabled());
+
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(m_white, m_strip);
+}
+
+TEST_F(PowerLimiterTest, withinBudget)
+{
+    m_powerLimiter.setBudget(600);
+    EXPECT_TRUE(m_powerLimiter.isEnabled());
+
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(m_white, m_strip);
+    EXPECT_EQ(600, m_powerLimiter.getEstimatedCurrent());
+    EXPECT_FALSE(m_powerLimiter.isRecovering());
+}
+
+TEST_F(PowerLimiterTest, overBudget)
+{
+    m_powerLimiter.setBudget(300);
+
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(127, 127, 127)), m_strip);
+    EXPECT_EQ(600, m_powerLimiter.getEstimatedCurrent());
+}
+
+TEST_F(PowerLimiterTest, channelModel)
+{
+    m_powerLimiter.setModel(10, 20, 30, 0);
+    m_powerLimiter.setBudget(100);
+
+    m_strip.assign(c_stripSize, TRgb(255, 0, 0));
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(100, m_powerLimiter.getEstimatedCurrent());
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(255, 0, 0)), m_strip);
+
+    m_strip.assign(c_stripSize, TRgb(0, 0, 255));
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(300, m_powerLimiter.getEstimatedCurrent());
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(0, 0, 84)), m_strip);
+}
+
+TEST_F(PowerLimiterTest, idleCurrent)
+{
+    m_powerLimiter.setModel(20, 20, 20, 5);
+
+    // The idle current cannot be scaled, so the remaining budget is half the channel current
+    m_powerLimiter.setBudget(350);
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(650, m_powerLimiter.getEstimatedCurrent());
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(127, 127, 127)), m_strip);
+
+    // Nothing left for the channels
+    m_powerLimiter.setBudget(50);
+    m_strip = m_white;
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize), m_strip);
+}
+
+TEST_F(PowerLimiterTest, gradualRecovery)
+{
+    m_powerLimiter.setBudget(300);
+    m_powerLimiter.limit(m_strip);
+
+    // Scale recovers from 128/256 in steps of 5/256
+    m_powerLimiter.setBudget(600);
+    m_strip = m_white;
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(132, 132, 132)), m_strip);
+    EXPECT_TRUE(m_powerLimiter.isRecovering());
+
+    for(unsigned int frame = 0; frame < 25; ++frame)
+    {
+        m_strip = m_white;
+        m_powerLimiter.limit(m_strip);
+    }
+    EXPECT_EQ(m_white, m_strip);
+    EXPECT_FALSE(m_powerLimiter.isRecovering());
+}
+
+TEST_F(PowerLimiterTest, immediateLimiting)
+{
+    m_powerLimiter.setBudget(600);
+    m_powerLimiter.limit(m_strip);
+
+    // No recovery delay in the other direction
+    m_powerLimiter.setBudget(300);
+    m_strip = m_white;
+    m_powerLimiter.limit(m_strip);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(127, 127, 127)), m_strip);
+}
+
+TEST_F(PowerLimiterTest, convertToJson)
+{
+    m_powerLimiter.setBudget(4000);
+    m_powerLimiter.setModel(12, 13, 14, 1);
+
+    Json::object converted(m_powerLimiter.convertToJson().object_items());
+    EXPECT_EQ("PowerLimiter", converted.at("objectType").string_value());
+    EXPECT_EQ(4000, converted.at("budget").int_value());
+    EXPECT_EQ(12, converted.at("rCurrent").int_value());
+    EXPECT_EQ(13, converted.at("gCurrent").int_value());
+    EXPECT_EQ(14, converted.at("bCurrent").int_value());
+    EXPECT_EQ(1, converted.at("idleCurrent").int_value());
+}
+
+TEST_F(PowerLimiterTest, convertFromJson)
+{
+    Json::object converted;
+    converted["objectType"] = "PowerLimiter";
+    converted["budget"] = 4000;
+    converted["rCurrent"] = 12;
+    converted["gCurrent"] = 13;
+    converted["bCurrent"] = 14;
+    converted["idleCurrent"] = 1;
+
+    m_powerLimiter.convertFromJson(Json(converted));
+    EXPECT_EQ(4000, m_powerLimiter.getBudget());
+    EXPECT_EQ(12, m_powerLimiter.getRedCurrent());
+    EXPECT_EQ(13, m_powerLimiter.getGreenCurrent());
+    EXPECT_EQ(14, m_powerLimiter.getBlueCurrent());
+    EXPECT_EQ(1, m_powerLimiter.getIdleCurrent());
+}
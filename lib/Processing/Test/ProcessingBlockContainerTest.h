@@ -38,23 +38,28 @@ using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Unused;
 
-static void addRed(Processing::TRgbStrip& strip, Unused)
+static bool addRed(Processing::TRgbStrip& strip, Unused)
 {
     for(auto& led : strip)
     {
         led.r = 10;
     }
+
+    // Output only depends on input
+    return false;
 }
 
-static void addGreen(Processing::TRgbStrip& strip, Unused)
+static bool addGreen(Processing::TRgbStrip& strip, Unused)
 {
     for(auto& led : strip)
     {
         led.g = 10;
     }
+
+    return false;
 }
 
-static void doubleValue(Processing::TRgbStrip& strip, Unused)
+static bool doubleValue(Processing::TRgbStrip& strip, Unused)
 {
     for(auto& led : strip)
     {
@@ -62,6 +67,8 @@ static void doubleValue(Processing::TRgbStrip& strip, Unused)
         led.g = std::min(0xff, led.g*2);
         led.b = std::min(0xff, led.b*2);
     }
+
+    return false;
 }
 
 /**
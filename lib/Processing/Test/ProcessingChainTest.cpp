@@ -26,6 +26,8 @@
  * @brief Unit tests for ProcessingBlock.
  */
 
+#include <chrono>
+#include <future>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
@@ -33,13 +35,18 @@
 #include <Mock/LoggingTest.h>
 
 #include "ProcessingBlockContainerTest.h"
+#include "ColorCorrection.h"
+#include "EqualRangeRgbSource.h"
 #include "ProcessingChain.h"
 #include "ProcessingTypes.h"
+#include "ThreadParallelExecutor.h"
 
 #define LOGGING_COMPONENT "ProcessingChain"
 
 using ::testing::Return;
 using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::Unused;
 
 class ProcessingChainTest
     : public ProcessingBlockContainerTest
@@ -64,7 +71,7 @@ TEST_F(ProcessingChainTest, empty)
     testStrip[1] = { 0, 1, 0 };
     testStrip[2] = { 0, 0, 1 };
 
-    m_processingChain.execute(testStrip, Processing::TNoteToLightMap());
+    m_processingChain.execute(testStrip, Processing::TNoteToLightTable());
     // m_strip is still zero
     EXPECT_EQ(m_strip, testStrip);
 }
@@ -79,7 +86,7 @@ TEST_F(ProcessingChainTest, insertOne)
     reference[1] = { 10, 0, 0 };
     reference[2] = { 10, 0, 0 };
 
-    m_processingChain.execute(m_strip, Processing::TNoteToLightMap());
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
     EXPECT_EQ(reference, m_strip);
 }
 
@@ -95,10 +102,268 @@ TEST_F(ProcessingChainTest, insertTwo)
     reference[1] = { 20, 0, 0 };
     reference[2] = { 20, 0, 0 };
 
-    m_processingChain.execute(m_strip, Processing::TNoteToLightMap());
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
     EXPECT_EQ(reference, m_strip);
 }
 
+TEST_F(ProcessingChainTest, reportsChanges)
+{
+    m_processingChain.insertBlock(m_redSource);
+    auto redSource(m_redSource);
+    m_redSource = nullptr;
+    m_processingChain.insertBlock(m_greenSource);
+    auto greenSource(m_greenSource);
+    m_greenSource = nullptr;
+
+    // Structure changed
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+
+    // Nothing changed
+    EXPECT_FALSE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+
+    // Any block changed. All blocks must still be executed.
+    EXPECT_CALL(*redSource, execute(_, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*greenSource, execute(_, _))
+        .WillOnce(Return(false));
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+
+    // Strip size changed
+    auto otherStrip = Processing::TRgbStrip(c_stripSize + 1);
+    EXPECT_CALL(*redSource, execute(_, _))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*greenSource, execute(_, _))
+        .WillOnce(Return(false));
+    EXPECT_TRUE(m_processingChain.execute(otherStrip, Processing::TNoteToLightTable()));
+}
+
+TEST_F(ProcessingChainTest, highPrecision)
+{
+    m_processingChain.insertBlock(m_redSource);
+    auto redSource(m_redSource);
+    m_redSource = nullptr;
+
+    m_processingChain.setHighPrecision(true);
+    EXPECT_TRUE(m_processingChain.isHighPrecision());
+
+    // 10.25
+    EXPECT_CALL(*redSource, execute(_, _))
+        .Times(0);
+    EXPECT_CALL(*redSource, executeHighPrecision(_, _))
+        .Times(4)
+        .WillRepeatedly(Invoke([](Processing::TRgbStrip16& strip, Unused) {
+            for(auto& led : strip)
+            {
+                led.r = 0x0a40;
+            }
+            return false;
+        }));
+
+    // Fraction is dithered, and output changes accordingly
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(10, m_strip[0].r);
+    EXPECT_FALSE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(10, m_strip[0].r);
+    EXPECT_FALSE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(10, m_strip[0].r);
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(11, m_strip[0].r);
+}
+
+TEST_F(ProcessingChainTest, highPrecisionWithColorCorrection)
+{
+    m_processingChain.insertBlock(m_redSource);
+    auto redSource(m_redSource);
+    m_redSource = nullptr;
+
+    ColorCorrection colorCorrection;
+    colorCorrection.setGamma(2.2f, 2.2f, 2.2f);
+    m_processingChain.setColorCorrection(&colorCorrection);
+    m_processingChain.setHighPrecision(true);
+
+    // 14, which the 8-bit correction turns into 0
+    ON_CALL(*redSource, executeHighPrecision(_, _))
+        .WillByDefault(Invoke([](Processing::TRgbStrip16& strip, Unused) {
+            for(auto& led : strip)
+            {
+                led.r = 0x0e00;
+            }
+            return false;
+        }));
+
+    // Corrected to 110 / 256 before quantization, so the dithered output averages to that
+    unsigned int sum(0);
+    for(unsigned int frame = 0; frame < 256; ++frame)
+    {
+        m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+        sum += m_strip[0].r;
+    }
+    EXPECT_EQ(110, sum);
+}
+
+TEST_F(ProcessingChainTest, compiled)
+{
+    m_processingChain.insertBlock(m_redSource);
+    auto redSource(m_redSource);
+    m_redSource = nullptr;
+    m_processingChain.insertBlock(m_valueDoubler);
+    m_valueDoubler = nullptr;
+
+    m_processingChain.setCompiled(true);
+    EXPECT_TRUE(m_processingChain.isCompiled());
+
+    auto reference = Processing::TRgbStrip(c_stripSize);
+    reference[0] = { 20, 0, 0 };
+    reference[1] = { 20, 0, 0 };
+    reference[2] = { 20, 0, 0 };
+
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(reference, m_strip);
+
+    // Changes are still reported
+    EXPECT_FALSE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_CALL(*redSource, execute(_, _))
+        .WillOnce(Return(true));
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+}
+
+TEST_F(ProcessingChainTest, compiledWithNestedChain)
+{
+    // Nested chain starts clean, so it overwrites the red source
+    auto nestedChain(new ProcessingChain(m_processingBlockFactory));
+    auto blueSource(new EqualRangeRgbSource);
+    blueSource->setColor({0, 0, 5});
+    nestedChain->insertBlock(blueSource);
+    nestedChain->insertBlock(m_valueDoubler);
+    m_valueDoubler = nullptr;
+
+    m_processingChain.insertBlock(m_redSource);
+    m_redSource = nullptr;
+    m_processingChain.insertBlock(nestedChain);
+    m_processingChain.setCompiled(true);
+
+    Processing::TRgbStrip reference(c_stripSize, {0, 0, 10});
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+    EXPECT_EQ(reference, m_strip);
+
+    // Same result without compilation
+    m_processingChain.setCompiled(false);
+    m_strip.assign(c_stripSize, {});
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+    EXPECT_EQ(reference, m_strip);
+}
+
+TEST_F(ProcessingChainTest, compiledFollowsBlockChanges)
+{
+    auto blueSource(new EqualRangeRgbSource);
+    blueSource->setColor({0, 0, 1});
+    m_processingChain.insertBlock(m_redSource);
+    m_redSource = nullptr;
+    m_processingChain.insertBlock(blueSource);
+    m_processingChain.setCompiled(true);
+
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 1}), m_strip);
+    EXPECT_FALSE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+
+    blueSource->setColor({9, 9, 9});
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {9, 9, 9}), m_strip);
+
+    blueSource->setBlend({Processing::BlendAdd, UINT8_MAX});
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {19, 9, 9}), m_strip);
+
+    EqualRangeRgbSource otherSource;
+    otherSource.setColor({1, 2, 3});
+    blueSource->convertFromJson(otherSource.convertToJson());
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {1, 2, 3}), m_strip);
+}
+
+TEST_F(ProcessingChainTest, compiledFollowsNestedChainChanges)
+{
+    auto nestedChain(new ProcessingChain(m_processingBlockFactory));
+    m_processingChain.insertBlock(nestedChain);
+    m_processingChain.setCompiled(true);
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 0}), m_strip);
+
+    // Blocks inserted into the nested chain
+    auto blueSource(new EqualRangeRgbSource);
+    blueSource->setColor({0, 0, 5});
+    nestedChain->insertBlock(blueSource);
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 5}), m_strip);
+
+    // Parameters of blocks in the nested chain
+    blueSource->setColor({0, 0, 7});
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 7}), m_strip);
+
+    // The nested chain deletes its blocks, which the program must not refer to anymore
+    Json mockJson(createMockBlockJson(0));
+    EXPECT_CALL(m_processingBlockFactory, createProcessingBlock(mockJson))
+        .WillOnce(Return(m_greenSource));
+    m_greenSource = nullptr;
+    Json::object j;
+    j["processingChain"] = Json::array({mockJson});
+    nestedChain->convertFromJson(Json(j));
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 10, 0}), m_strip);
+
+    // A high precision nested chain is executed as a whole, and the green source has no high precision output
+    nestedChain->setHighPrecision(true);
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 0}), m_strip);
+}
+
+TEST_F(ProcessingChainTest, compiledHoldsNestedChainLocks)
+{
+    auto nestedChain(new ProcessingChain(m_processingBlockFactory));
+    auto valueDoubler(m_valueDoubler);
+    nestedChain->insertBlock(m_valueDoubler);
+    m_valueDoubler = nullptr;
+    m_processingChain.insertBlock(nestedChain);
+    m_processingChain.setCompiled(true);
+
+    // The nested chain can't replace its blocks while the program executes them
+    std::future<bool> nestedChainAccess;
+    EXPECT_CALL(*valueDoubler, execute(_, _))
+        .WillOnce(Invoke([&](Unused, Unused) {
+            nestedChainAccess = std::async(std::launch::async, [nestedChain]() {
+                return nestedChain->isHighPrecision();
+            });
+            EXPECT_EQ(std::future_status::timeout, nestedChainAccess.wait_for(std::chrono::milliseconds(20)));
+            return false;
+        }));
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+    EXPECT_FALSE(nestedChainAccess.get());
+}
+
+TEST_F(ProcessingChainTest, compiledParallel)
+{
+    ThreadParallelExecutor executor;
+    auto blueSource(new EqualRangeRgbSource);
+    blueSource->setColor({0, 0, 5});
+    m_processingChain.insertBlock(blueSource);
+    m_processingChain.setCompiled(true);
+    m_processingChain.setParallelExecutor(&executor);
+
+    Processing::TRgbStrip reference(c_stripSize, {0, 0, 5});
+    EXPECT_TRUE(m_processingChain.execute(m_strip, Processing::TNoteToLightTable()));
+    EXPECT_EQ(reference, m_strip);
+
+    // Blocks which can't be segmented are executed serially
+    m_processingChain.insertBlock(m_valueDoubler);
+    m_valueDoubler = nullptr;
+    m_strip.assign(c_stripSize, {});
+    m_processingChain.execute(m_strip, Processing::TNoteToLightTable());
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, {0, 0, 10}), m_strip);
+
+    m_processingChain.setParallelExecutor(nullptr);
+}
+
 TEST_F(ProcessingChainTest, convertToJson)
 {
     Json::array mockBlocksJson;
@@ -118,6 +383,8 @@ TEST_F(ProcessingChainTest, convertToJson)
     Json::object converted = m_processingChain.convertToJson().object_items();
     EXPECT_EQ(mockBlocksJson, converted["processingChain"].array_items());
     EXPECT_EQ("ProcessingChain", converted.at("objectType").string_value());
+    EXPECT_FALSE(converted.at("highPrecision").bool_value());
+    EXPECT_FALSE(converted.at("compiled").bool_value());
 }
 
 TEST_F(ProcessingChainTest, convertFromJson)
@@ -139,14 +406,16 @@ TEST_F(ProcessingChainTest, convertFromJson)
     }
     Json::object j;
     j["processingChain"] = mockBlocksJson;
+    j["compiled"] = true;
     m_processingChain.convertFromJson(Json(j));
+    EXPECT_TRUE(m_processingChain.isCompiled());
 
     Processing::TRgbStrip reference(3);
     reference[0] = {0, 20, 0};
     reference[1] = {0, 20, 0};
     reference[2] = {0, 20, 0};
     Processing::TRgbStrip testStrip(3);
-    m_processingChain.execute(testStrip, Processing::TNoteToLightMap());
+    m_processingChain.execute(testStrip, Processing::TNoteToLightTable());
     EXPECT_EQ(reference, testStrip);
 }
 
@@ -0,0 +1,227 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <future>
+#include <mutex>
+#include <gtest/gtest.h>
+
+#include "../RenderProgram.h"
+#include "../EqualRangeRgbSource.h"
+#include "../ProcessingChain.h"
+#include "../Mock/MockProcessingBlock.h"
+#include "../Mock/MockProcessingBlockFactory.h"
+#include "ThreadParallelExecutor.h"
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using Processing::TRgb;
+
+class RenderProgramTest
+    : public ::testing::Test
+{
+public:
+    static constexpr unsigned int c_stripSize = 3;
+
+    RenderProgramTest()
+        : m_program()
+        , m_strip(c_stripSize, TRgb(1, 2, 3))
+        , m_noteToLightTable()
+        , m_processingBlockFactory()
+    {
+    }
+
+    RenderProgram m_program;
+    Processing::TRgbStrip m_strip;
+    Processing::TNoteToLightTable m_noteToLightTable;
+    NiceMock<MockProcessingBlockFactory> m_processingBlockFactory;
+};
+
+constexpr unsigned int RenderProgramTest::c_stripSize;
+
+TEST_F(RenderProgramTest, empty)
+{
+    EXPECT_EQ(0, m_program.size());
+    EXPECT_FALSE(m_program.execute(m_strip, m_noteToLightTable));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(1, 2, 3)), m_strip);
+}
+
+TEST_F(RenderProgramTest, fill)
+{
+    m_program.addFill({4, 5, 6});
+
+    // Constant, so never a change by itself
+    EXPECT_FALSE(m_program.execute(m_strip, m_noteToLightTable));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(4, 5, 6)), m_strip);
+
+    Processing::TRgbStrip16 strip16(c_stripSize);
+    m_program.executeHighPrecision(strip16, m_noteToLightTable);
+    EXPECT_EQ(Processing::TRgbStrip16(c_stripSize, Processing::TRgb16(TRgb(4, 5, 6))), strip16);
+}
+
+TEST_F(RenderProgramTest, consecutiveFillsAreMerged)
+{
+    m_program.addClear();
+    m_program.addFill({4, 5, 6});
+    EXPECT_EQ(1, m_program.size());
+
+    m_program.execute(m_strip, m_noteToLightTable);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(4, 5, 6)), m_strip);
+}
+
+TEST_F(RenderProgramTest, blendedFillsAreFolded)
+{
+    // Dimmed background on top of a clear, without an extra pass
+    m_program.addClear();
+    m_program.addFill({200, 100, 0}, {Processing::BlendAdd, 255});
+    m_program.addFill({128, 128, 128}, {Processing::BlendMultiply, 255});
+    EXPECT_EQ(1, m_program.size());
+
+    m_program.execute(m_strip, m_noteToLightTable);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(100, 50, 0)), m_strip);
+}
+
+TEST_F(RenderProgramTest, blendedFill)
+{
+    m_program.addFill({3, 2, 1}, {Processing::BlendMax, 255});
+    EXPECT_EQ(1, m_program.size());
+
+    m_program.execute(m_strip, m_noteToLightTable);
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize, TRgb(3, 2, 3)), m_strip);
+}
+
+TEST_F(RenderProgramTest, block)
+{
+    NiceMock<MockProcessingBlock> block;
+    m_program.addFill({4, 5, 6});
+    m_program.addBlock(block);
+    m_program.addClear();
+    EXPECT_EQ(3, m_program.size());
+
+    // Block is executed between the fills, and its changes are reported
+    EXPECT_CALL(block, execute(Eq(Processing::TRgbStrip(c_stripSize, TRgb(4, 5, 6))), _))
+        .WillOnce(Return(true));
+    EXPECT_TRUE(m_program.execute(m_strip, m_noteToLightTable));
+    EXPECT_EQ(Processing::TRgbStrip(c_stripSize), m_strip);
+
+    EXPECT_CALL(block, executeHighPrecision(_, _))
+        .WillOnce(Return(false));
+    Processing::TRgbStrip16 strip16(c_stripSize);
+    EXPECT_FALSE(m_program.executeHighPrecision(strip16, m_noteToLightTable));
+}
+
+TEST_F(RenderProgramTest, locks)
+{
+    // From another thread, as the owner can't try a lock it holds
+    auto isLocked = [](std::mutex& mutex) {
+        return std::async(std::launch::async, [&mutex]() {
+            if(!mutex.try_lock())
+            {
+                return true;
+            }
+            mutex.unlock();
+            return false;
+        }).get();
+    };
+
+    std::mutex first, second;
+    m_program.addLock(first);
+    m_program.addLock(second);
+
+    m_program.lock();
+    EXPECT_TRUE(isLocked(first));
+    EXPECT_TRUE(isLocked(second));
+    m_program.unlock();
+    EXPECT_FALSE(isLocked(first));
+    EXPECT_FALSE(isLocked(second));
+
+    // Removed together with the operations
+    m_program.clear();
+    m_program.lock();
+    EXPECT_FALSE(isLocked(first));
+    m_program.unlock();
+}
+
+TEST_F(RenderProgramTest, nestedChainIsFlattened)
+{
+    ProcessingChain chain(m_processingBlockFactory);
+    auto source(new EqualRangeRgbSource);
+    source->setColor({4, 5, 6});
+    chain.insertBlock(source);
+    auto block(new NiceMock<MockProcessingBlock>);
+    chain.insertBlock(block);
+
+    // The clean start of the chain is merged with the fill
+    chain.compile(m_program);
+    EXPECT_EQ(2, m_program.size());
+
+    EXPECT_CALL(*block, execute(Eq(Processing::TRgbStrip(c_stripSize, TRgb(4, 5, 6))), _));
+    m_program.execute(m_strip, m_noteToLightTable);
+}
+
+TEST_F(RenderProgramTest, highPrecisionChainIsNotFlattened)
+{
+    ProcessingChain chain(m_processingBlockFactory);
+    chain.insertBlock(new EqualRangeRgbSource);
+    chain.setHighPrecision(true);
+
+    chain.compile(m_program);
+    EXPECT_EQ(1, m_program.size());
+}
+
+TEST_F(RenderProgramTest, segmentable)
+{
+    EXPECT_TRUE(m_program.isSegmentable());
+    m_program.addFill({4, 5, 6});
+    EXPECT_TRUE(m_program.isSegmentable());
+
+    NiceMock<MockProcessingBlock> block;
+    m_program.addBlock(block);
+    EXPECT_FALSE(m_program.isSegmentable());
+
+    m_program.clear();
+    EXPECT_TRUE(m_program.isSegmentable());
+}
+
+TEST_F(RenderProgramTest, segmentsCoverStrip)
+{
+    EXPECT_EQ(0, RenderProgram::getSegmentBegin(10, 0, 3));
+    EXPECT_EQ(3, RenderProgram::getSegmentBegin(10, 1, 3));
+    EXPECT_EQ(6, RenderProgram::getSegmentBegin(10, 2, 3));
+    EXPECT_EQ(10, RenderProgram::getSegmentBegin(10, 3, 3));
+}
+
+TEST_F(RenderProgramTest, executeParallel)
+{
+    ThreadParallelExecutor executor(2);
+    Processing::TRgbStrip strip(100, TRgb(1, 2, 3));
+    m_program.addFill({4, 5, 6});
+
+    EXPECT_FALSE(m_program.executeParallel(strip, m_noteToLightTable, executor));
+    EXPECT_EQ(Processing::TRgbStrip(100, TRgb(4, 5, 6)), strip);
+}
@@ -105,3 +105,39 @@ TEST(TRgbTest, multiplicationWithClipping)
     EXPECT_EQ(255, result.g);
     EXPECT_EQ(255, result.b);
 }
+
+TEST(TRgb16Test, fromRgb)
+{
+    TRgb16 color(TRgb(1, 2, 255));
+
+    EXPECT_EQ(TRgb16(0x0100, 0x0200, 0xff00), color);
+    EXPECT_EQ(TRgb(1, 2, 255), color.toRgb());
+}
+
+TEST(TRgb16Test, toRgbDropsFraction)
+{
+    EXPECT_EQ(TRgb(1, 0, 254), TRgb16(0x01ff, 0x00ff, 0xfe80).toRgb());
+}
+
+TEST(TRgb16Test, additionWithSaturation)
+{
+    TRgb16 color(0x0080, 0x8000, 0xff00);
+    color += TRgb16(0x0080, 0x8000, 0x0200);
+
+    EXPECT_EQ(TRgb16(0x0100, 0xffff, 0xffff), color);
+}
+
+TEST(TRgb16Test, scale)
+{
+    TRgb16 color(0x0100, 0x1000, 0xffff);
+
+    // Q15, so half
+    EXPECT_EQ(TRgb16(0x0080, 0x0800, 0x7fff), color.scale(0x4000));
+    EXPECT_EQ(color, color.scale(0x8000));
+}
+
+TEST(TRgb16Test, fromFloat)
+{
+    EXPECT_EQ(TRgb16(0x0040, 0x0a80, 0x0000), rgb16FromFloat(0.25f, 10.5f, -3.0f));
+    EXPECT_EQ(TRgb16(0xffff, 0xffff, 0xffff), rgb16FromFloat(256.0f, 1000.0f, 255.999f));
+}
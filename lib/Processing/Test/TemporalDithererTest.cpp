@@ -0,0 +1,124 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Unit test for TemporalDitherer.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TemporalDitherer.h"
+
+using Processing::TRgb;
+using Processing::TRgb16;
+
+class TemporalDithererTest
+    : public ::testing::Test
+{
+public:
+    TemporalDithererTest()
+        : m_ditherer()
+        , m_input(1)
+        , m_output(1)
+    {
+    }
+
+    TemporalDitherer m_ditherer;
+    Processing::TRgbStrip16 m_input;
+    Processing::TRgbStrip m_output;
+};
+
+TEST_F(TemporalDithererTest, wholeValues)
+{
+    m_input[0] = TRgb16(TRgb(1, 2, 3));
+
+    EXPECT_TRUE(m_ditherer.quantize(m_input, m_output));
+    EXPECT_EQ(TRgb(1, 2, 3), m_output[0]);
+
+    // Without fraction, the output stays the same
+    EXPECT_FALSE(m_ditherer.quantize(m_input, m_output));
+    EXPECT_EQ(TRgb(1, 2, 3), m_output[0]);
+}
+
+TEST_F(TemporalDithererTest, fractionsAverageOut)
+{
+    // 0.25, 10.5 and 0.75
+    m_input[0] = TRgb16(0x0040, 0x0a80, 0x00c0);
+
+    unsigned int sumR(0), sumG(0), sumB(0);
+    for(unsigned int frame = 0; frame < 4; ++frame)
+    {
+        m_ditherer.quantize(m_input, m_output);
+        sumR += m_output[0].r;
+        sumG += m_output[0].g;
+        sumB += m_output[0].b;
+    }
+
+    EXPECT_EQ(1, sumR);
+    EXPECT_EQ(42, sumG);
+    EXPECT_EQ(3, sumB);
+}
+
+TEST_F(TemporalDithererTest, reportsChanges)
+{
+    // 0.5 alternates
+    m_input[0] = TRgb16(0x0080, 0, 0);
+
+    EXPECT_FALSE(m_ditherer.quantize(m_input, m_output));
+    EXPECT_EQ(TRgb(0, 0, 0), m_output[0]);
+    EXPECT_TRUE(m_ditherer.quantize(m_input, m_output));
+    EXPECT_EQ(TRgb(1, 0, 0), m_output[0]);
+    EXPECT_TRUE(m_ditherer.quantize(m_input, m_output));
+    EXPECT_EQ(TRgb(0, 0, 0), m_output[0]);
+}
+
+TEST_F(TemporalDithererTest, saturation)
+{
+    m_input[0] = TRgb16(0xffff, 0xffff, 0xffff);
+
+    for(unsigned int frame = 0; frame < 4; ++frame)
+    {
+        m_ditherer.quantize(m_input, m_output);
+        EXPECT_EQ(TRgb(255, 255, 255), m_output[0]);
+    }
+}
+
+TEST_F(TemporalDithererTest, resize)
+{
+    Processing::TRgbStrip16 input(3, TRgb16(TRgb(5, 5, 5)));
+
+    EXPECT_TRUE(m_ditherer.quantize(input, m_output));
+    EXPECT_EQ(Processing::TRgbStrip(3, TRgb(5, 5, 5)), m_output);
+}
+
+TEST_F(TemporalDithererTest, reset)
+{
+    m_input[0] = TRgb16(0x0080, 0, 0);
+    m_ditherer.quantize(m_input, m_output);
+
+    // Carried over fraction is forgotten
+    m_ditherer.reset();
+    m_ditherer.quantize(m_input, m_output);
+    EXPECT_EQ(TRgb(0, 0, 0), m_output[0]);
+}
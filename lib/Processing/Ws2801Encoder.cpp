@@ -0,0 +1,47 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Ws2801Encoder.h"
+
+Ws2801Encoder::Ws2801Encoder(TLedColorOrder colorOrder)
+    : m_colorOrder(colorOrder)
+{
+}
+
+std::size_t Ws2801Encoder::getFrameSize(std::size_t numLeds) const
+{
+    return 3 * numLeds;
+}
+
+void Ws2801Encoder::encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const
+{
+    for(std::size_t led = 0; led < numLeds; ++led)
+    {
+        const Processing::TRgb color(led < strip.size() ? strip[led] : Processing::TRgb());
+        writeColor(frame, m_colorOrder, color.r, color.g, color.b);
+        frame += 3;
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Encoder for WS2801 LED chips.
+ */
+
+#ifndef PROCESSING_WS2801ENCODER_H_
+#define PROCESSING_WS2801ENCODER_H_
+
+#include "ILedEncoder.h"
+#include "LedColorOrder.h"
+
+/**
+ * Encoder for WS2801 LED chips, which are clocked and take 3 bytes per LED. The chips latch after the clock has been
+ * idle for 500 microseconds.
+ */
+class Ws2801Encoder
+    : public ILedEncoder
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param[in]   colorOrder  Color order of the LEDs. RGB for most strips.
+     */
+    explicit Ws2801Encoder(TLedColorOrder colorOrder = LedColorOrder_Rgb);
+
+    // ILedEncoder implementation
+    std::size_t getFrameSize(std::size_t numLeds) const override;
+    void encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const override;
+
+private:
+    TLedColorOrder m_colorOrder;
+};
+
+#endif /* PROCESSING_WS2801ENCODER_H_ */
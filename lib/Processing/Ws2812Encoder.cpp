@@ -0,0 +1,81 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "Ws2812Encoder.h"
+
+namespace
+{
+
+/**
+ * SPI patterns for every 2 bits of a color component. The two bits are sent as one byte, with 1000 for a zero and
+ * 1110 for a one.
+ */
+constexpr uint8_t c_bitPairPatterns[4] = {0x88, 0x8e, 0xe8, 0xee};
+
+/**
+ * Write one color component as 4 bytes of SPI patterns.
+ */
+inline void writeComponent(uint8_t* destination, uint8_t component)
+{
+    destination[0] = c_bitPairPatterns[(component >> 6) & 0x3];
+    destination[1] = c_bitPairPatterns[(component >> 4) & 0x3];
+    destination[2] = c_bitPairPatterns[(component >> 2) & 0x3];
+    destination[3] = c_bitPairPatterns[component & 0x3];
+}
+
+} /* namespace */
+
+constexpr uint32_t Ws2812Encoder::c_spiClockHz;
+constexpr std::size_t Ws2812Encoder::c_bytesPerLed;
+constexpr std::size_t Ws2812Encoder::c_latchSize;
+
+Ws2812Encoder::Ws2812Encoder(TLedColorOrder colorOrder)
+    : m_colorOrder(colorOrder)
+{
+}
+
+std::size_t Ws2812Encoder::getFrameSize(std::size_t numLeds) const
+{
+    return c_bytesPerLed * numLeds + c_latchSize;
+}
+
+void Ws2812Encoder::encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const
+{
+    for(std::size_t led = 0; led < numLeds; ++led)
+    {
+        const Processing::TRgb color(led < strip.size() ? strip[led] : Processing::TRgb());
+        uint8_t ordered[3];
+        writeColor(ordered, m_colorOrder, color.r, color.g, color.b);
+        writeComponent(&frame[0], ordered[0]);
+        writeComponent(&frame[4], ordered[1]);
+        writeComponent(&frame[8], ordered[2]);
+        frame += c_bytesPerLed;
+    }
+
+    std::memset(frame, 0, c_latchSize);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file
+ *
+ * MIT License
+ * 
+ * @copyright (c) 2018 Daniel Schenk <danielschenk@users.noreply.github.com>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * @brief Encoder for WS2812 LED chips, to send by SPI.
+ */
+
+#ifndef PROCESSING_WS2812ENCODER_H_
+#define PROCESSING_WS2812ENCODER_H_
+
+#include "ILedEncoder.h"
+#include "LedColorOrder.h"
+
+/**
+ * Encoder for WS2812 (and SK6812 RGB) LED chips, to send through an SPI data line without using the clock.
+ *
+ * These chips are clockless, and take 800 kbit/s with every bit encoded in the pulse width. At @ref c_spiClockHz, every
+ * bit is sent as 4 SPI bits: 1000 for a zero (0.31 us high), and 1110 for a one (0.94 us high). The frame ends with the
+ * data line low for 300 microseconds, to latch.
+ */
+class Ws2812Encoder
+    : public ILedEncoder
+{
+public:
+    /** The SPI clock speed the frames must be sent at. */
+    static constexpr uint32_t c_spiClockHz = 3200000;
+
+    /**
+     * Constructor.
+     *
+     * @param[in]   colorOrder  Color order of the LEDs. GRB for most strips.
+     */
+    explicit Ws2812Encoder(TLedColorOrder colorOrder = LedColorOrder_Grb);
+
+    // ILedEncoder implementation
+    std::size_t getFrameSize(std::size_t numLeds) const override;
+    void encode(const Processing::TRgbStrip& strip, uint8_t* frame, std::size_t numLeds) const override;
+
+private:
+    /** Bytes per LED: 3 colors of 8 bits, 4 SPI bits each. */
+    static constexpr std::size_t c_bytesPerLed = 12;
+
+    /** Low time to latch: 300 us at 2.5 us per byte. */
+    static constexpr std::size_t c_latchSize = 120;
+
+    TLedColorOrder m_colorOrder;
+};
+
+#endif /* PROCESSING_WS2812ENCODER_H_ */
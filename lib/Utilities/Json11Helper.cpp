@@ -65,6 +65,11 @@ bool Json11Helper::getItem(std::string key, uint16_t& target) const
     return getInt(key, target);
 }
 
+bool Json11Helper::getItem(std::string key, uint32_t& target) const
+{
+    return getInt(key, target);
+}
+
 bool Json11Helper::getItem(std::string key, float& target) const
 {
     return getFloat(key, target);
@@ -115,6 +115,7 @@ private:
     bool getItem(std::string key, int& target) const;
     bool getItem(std::string key, uint8_t& target) const;
     bool getItem(std::string key, uint16_t& target) const;
+    bool getItem(std::string key, uint32_t& target) const;
     bool getItem(std::string key, float& target) const;
     bool getItem(std::string key, double& target) const;
     bool getItem(std::string key, bool& target) const;
@@ -40,7 +40,7 @@ StdLogger::~StdLogger()
     LoggingEntryPoint::unsubscribe(*this);
 }
 
-void StdLogger::logMessage(uint64_t time, Logging::TLogLevel level, std::string component, std::string message)
+void StdLogger::logMessage(uint64_t time, Logging::TLogLevel level, const char* component, const char* message)
 {
     const char* levelString;
     switch(level)
@@ -48,7 +48,7 @@ public:
     virtual ~StdLogger();
 
     // ILoggingTarget implementation
-    virtual void logMessage(uint64_t time, Logging::TLogLevel level, std::string component, std::string message);
+    virtual void logMessage(uint64_t time, Logging::TLogLevel level, const char* component, const char* message);
 };
 
 #endif /* COMMON_UTILITIES_STDLOGGER_H_ */